@@ -34,6 +34,11 @@ bool Config::loadFromYaml(const YAML::Node& config) {
             if (db["connection_timeout"]) dbConfig.connection_timeout = db["connection_timeout"].as<int>();
             if (db["max_retries"]) dbConfig.max_retries = db["max_retries"].as<int>();
             if (db["retry_delay"]) dbConfig.retry_delay = db["retry_delay"].as<int>();
+            if (db["pool_size"]) dbConfig.pool_size = db["pool_size"].as<int>();
+            if (db["pipeline_pool_size"]) dbConfig.pipeline_pool_size = db["pipeline_pool_size"].as<int>();
+            if (db["slow_query_threshold_ms"]) dbConfig.slow_query_threshold_ms = db["slow_query_threshold_ms"].as<int>();
+            if (db["explain_sample_rate"]) dbConfig.explain_sample_rate = db["explain_sample_rate"].as<double>();
+            if (db["allow_local_infile"]) dbConfig.allow_local_infile = db["allow_local_infile"].as<bool>();
         }
         
         // Server 설정 로드
@@ -42,6 +47,129 @@ bool Config::loadFromYaml(const YAML::Node& config) {
             if (server["host"]) serverConfig.host = server["host"].as<std::string>();
             if (server["port"]) serverConfig.port = server["port"].as<int>();
             if (server["threads"]) serverConfig.threads = server["threads"].as<int>();
+            if (server["server_timing"]) serverConfig.server_timing = server["server_timing"].as<bool>();
+            if (server["mode"]) serverConfig.mode = server["mode"].as<std::string>();
+        }
+        
+        // Logging 설정 로드
+        if (config["logging"]) {
+            const auto& logging = config["logging"];
+            if (logging["level"]) loggingConfig.level = logging["level"].as<std::string>();
+            if (logging["access"]) {
+                const auto& access = logging["access"];
+                AccessLogConfig& accessConfig = loggingConfig.access;
+                if (access["sampling"]) accessConfig.sampling = access["sampling"].as<bool>();
+                if (access["sample_one_in"]) accessConfig.sample_one_in = access["sample_one_in"].as<int>();
+                if (access["client_errors_per_second"]) accessConfig.client_errors_per_second = access["client_errors_per_second"].as<int>();
+                if (access["slow_ms"]) accessConfig.slow_ms = access["slow_ms"].as<int>();
+                if (access["slow_routes"]) {
+                    accessConfig.slow_routes_ms.clear();
+                    for (const auto& route : access["slow_routes"]) {
+                        accessConfig.slow_routes_ms[route.first.as<std::string>()] = route.second.as<int>();
+                    }
+                }
+            }
+        }
+        
+        // Executor 설정 로드
+        if (config["executor"]) {
+            const auto& executor = config["executor"];
+            if (executor["threads"]) executorConfig.threads = executor["threads"].as<int>();
+            if (executor["queue_capacity"]) executorConfig.queue_capacity = executor["queue_capacity"].as<int>();
+        }
+        
+        // Stats 설정 로드
+        if (config["stats"]) {
+            const auto& stats = config["stats"];
+            if (stats["reconcile_interval_seconds"]) statsConfig.reconcile_interval_seconds = stats["reconcile_interval_seconds"].as<int>();
+        }
+        
+        // Circuit breaker 설정 로드
+        if (config["circuit_breaker"]) {
+            const auto& breaker = config["circuit_breaker"];
+            if (breaker["enabled"]) circuitBreakerConfig.enabled = breaker["enabled"].as<bool>();
+            if (breaker["failure_ratio"]) circuitBreakerConfig.failure_ratio = breaker["failure_ratio"].as<double>();
+            if (breaker["min_requests"]) circuitBreakerConfig.min_requests = breaker["min_requests"].as<int>();
+            if (breaker["window_ms"]) circuitBreakerConfig.window_ms = breaker["window_ms"].as<int>();
+            if (breaker["open_ms"]) circuitBreakerConfig.open_ms = breaker["open_ms"].as<int>();
+            if (breaker["probe_interval_ms"]) circuitBreakerConfig.probe_interval_ms = breaker["probe_interval_ms"].as<int>();
+            if (breaker["stale_max_age_seconds"]) circuitBreakerConfig.stale_max_age_seconds = breaker["stale_max_age_seconds"].as<int>();
+        }
+        
+        // Profiler 설정 로드
+        if (config["profiler"]) {
+            const auto& profiler = config["profiler"];
+            if (profiler["enabled"]) profilerConfig.enabled = profiler["enabled"].as<bool>();
+            if (profiler["frequency_hz"]) profilerConfig.frequency_hz = profiler["frequency_hz"].as<int>();
+            if (profiler["max_seconds"]) profilerConfig.max_seconds = profiler["max_seconds"].as<int>();
+            if (profiler["max_samples"]) profilerConfig.max_samples = profiler["max_samples"].as<int>();
+            if (profiler["max_depth"]) profilerConfig.max_depth = profiler["max_depth"].as<int>();
+        }
+        
+        // Stream 설정 로드
+        if (config["stream"]) {
+            const auto& stream = config["stream"];
+            if (stream["backlog"]) streamConfig.backlog = stream["backlog"].as<int>();
+            if (stream["max_batch"]) streamConfig.max_batch = stream["max_batch"].as<int>();
+            if (stream["max_wait_seconds"]) streamConfig.max_wait_seconds = stream["max_wait_seconds"].as<int>();
+            if (stream["linger_ms"]) streamConfig.linger_ms = stream["linger_ms"].as<int>();
+            if (stream["retry_ms"]) streamConfig.retry_ms = stream["retry_ms"].as<int>();
+            if (stream["max_subscribers"]) streamConfig.max_subscribers = stream["max_subscribers"].as<int>();
+        }
+        
+        // Batching 설정 로드
+        if (config["batching"]) {
+            const auto& batching = config["batching"];
+            if (batching["enabled"]) batchingConfig.enabled = batching["enabled"].as<bool>();
+            if (batching["window_us"]) batchingConfig.window_us = batching["window_us"].as<int>();
+            if (batching["max_batch"]) batchingConfig.max_batch = batching["max_batch"].as<int>();
+        }
+        
+        // Cache snapshot 설정 로드
+        if (config["cache_snapshot"]) {
+            const auto& snapshot = config["cache_snapshot"];
+            if (snapshot["enabled"]) cacheSnapshotConfig.enabled = snapshot["enabled"].as<bool>();
+            if (snapshot["directory"]) cacheSnapshotConfig.directory = snapshot["directory"].as<std::string>();
+            if (snapshot["save_interval_seconds"]) cacheSnapshotConfig.save_interval_seconds = snapshot["save_interval_seconds"].as<int>();
+        }
+        
+        // Capture 설정 로드
+        if (config["capture"]) {
+            const auto& capture = config["capture"];
+            if (capture["enabled"]) captureConfig.enabled = capture["enabled"].as<bool>();
+            if (capture["path"]) captureConfig.path = capture["path"].as<std::string>();
+            if (capture["sample_rate"]) captureConfig.sample_rate = capture["sample_rate"].as<double>();
+            if (capture["max_body_bytes"]) captureConfig.max_body_bytes = capture["max_body_bytes"].as<int>();
+            if (capture["max_file_mb"]) captureConfig.max_file_mb = capture["max_file_mb"].as<int>();
+        }
+        
+        // Admission 설정 로드
+        if (config["admission"]) {
+            const auto& admission = config["admission"];
+            if (admission["enabled"]) admissionConfig.enabled = admission["enabled"].as<bool>();
+            loadLimiterConfig(admission["read"], admissionConfig.read);
+            loadLimiterConfig(admission["write"], admissionConfig.write);
+            if (admission["latency_tolerance"]) admissionConfig.latency_tolerance = admission["latency_tolerance"].as<double>();
+            if (admission["pool_wait_target_ms"]) admissionConfig.pool_wait_target_ms = admission["pool_wait_target_ms"].as<int>();
+            if (admission["retry_after_seconds"]) admissionConfig.retry_after_seconds = admission["retry_after_seconds"].as<int>();
+        }
+        
+        // RateLimit 설정 로드
+        if (config["rate_limit"]) {
+            const auto& rateLimit = config["rate_limit"];
+            if (rateLimit["enabled"]) rateLimitConfig.enabled = rateLimit["enabled"].as<bool>();
+            loadTokenBucketConfig(rateLimit["client"], rateLimitConfig.client);
+            loadTokenBucketConfig(rateLimit["route"], rateLimitConfig.route);
+            if (rateLimit["max_keys"]) rateLimitConfig.max_keys = rateLimit["max_keys"].as<int>();
+            if (rateLimit["shards"]) rateLimitConfig.shards = rateLimit["shards"].as<int>();
+            if (rateLimit["trust_forwarded_for"]) rateLimitConfig.trust_forwarded_for = rateLimit["trust_forwarded_for"].as<bool>();
+        }
+        
+        // Admin access 설정 로드
+        if (config["admin_access"]) {
+            const auto& access = config["admin_access"];
+            if (access["allow_loopback"]) adminAccessConfig.allow_loopback = access["allow_loopback"].as<bool>();
+            if (access["token"]) adminAccessConfig.token = access["token"].as<std::string>();
         }
         
         return validate();
@@ -51,6 +179,19 @@ bool Config::loadFromYaml(const YAML::Node& config) {
     }
 }
 
+void Config::loadLimiterConfig(const YAML::Node& node, LimiterConfig& limiter) {
+    if (!node) return;
+    if (node["initial_limit"]) limiter.initial_limit = node["initial_limit"].as<int>();
+    if (node["min_limit"]) limiter.min_limit = node["min_limit"].as<int>();
+    if (node["max_limit"]) limiter.max_limit = node["max_limit"].as<int>();
+}
+
+void Config::loadTokenBucketConfig(const YAML::Node& node, TokenBucketConfig& bucket) {
+    if (!node) return;
+    if (node["rate_per_second"]) bucket.rate_per_second = node["rate_per_second"].as<double>();
+    if (node["burst"]) bucket.burst = node["burst"].as<double>();
+}
+
 void Config::setDefaults() {
     // Database 기본값
     dbConfig.host = "127.0.0.1";
@@ -61,11 +202,94 @@ void Config::setDefaults() {
     dbConfig.connection_timeout = 10;  // 10초 타임아웃
     dbConfig.max_retries = 3;          // 최대 3회 재시도
     dbConfig.retry_delay = 2;          // 2초 간격으로 재시도
+    dbConfig.pool_size = 10;
+    dbConfig.pipeline_pool_size = 2;
+    dbConfig.slow_query_threshold_ms = 200;
+    dbConfig.explain_sample_rate = 0.1;
+    dbConfig.allow_local_infile = false;
     
     // Server 기본값
     serverConfig.host = "0.0.0.0";
     serverConfig.port = 8080;
     serverConfig.threads = 10;
+    serverConfig.server_timing = false;
+    serverConfig.mode = "shared";
+    
+    // Logging 기본값
+    loggingConfig.level = "info";
+    loggingConfig.access.sampling = false;
+    loggingConfig.access.sample_one_in = 100;
+    loggingConfig.access.client_errors_per_second = 20;
+    loggingConfig.access.slow_ms = 500;
+    loggingConfig.access.slow_routes_ms.clear();
+    
+    // Executor 기본값
+    executorConfig.threads = 10;
+    executorConfig.queue_capacity = 1024;
+    
+    // Stats 기본값
+    statsConfig.reconcile_interval_seconds = 300;
+    
+    // Circuit breaker 기본값
+    circuitBreakerConfig.enabled = true;
+    circuitBreakerConfig.failure_ratio = 0.5;
+    circuitBreakerConfig.min_requests = 10;
+    circuitBreakerConfig.window_ms = 10000;
+    circuitBreakerConfig.open_ms = 5000;
+    circuitBreakerConfig.probe_interval_ms = 1000;
+    circuitBreakerConfig.stale_max_age_seconds = 300;
+    
+    // Profiler 기본값
+    profilerConfig.enabled = false;
+    profilerConfig.frequency_hz = 99;
+    profilerConfig.max_seconds = 30;
+    profilerConfig.max_samples = 20000;
+    profilerConfig.max_depth = 48;
+    
+    // Stream 기본값
+    streamConfig.backlog = 4096;
+    streamConfig.max_batch = 256;
+    streamConfig.max_wait_seconds = 25;
+    streamConfig.linger_ms = 20;
+    streamConfig.retry_ms = 100;
+    streamConfig.max_subscribers = 1024;
+    
+    // Batching 기본값
+    batchingConfig.enabled = true;
+    batchingConfig.window_us = 200;
+    batchingConfig.max_batch = 64;
+    
+    // Cache snapshot 기본값
+    cacheSnapshotConfig.enabled = true;
+    cacheSnapshotConfig.directory = "snapshots";
+    cacheSnapshotConfig.save_interval_seconds = 300;
+    
+    // Capture 기본값
+    captureConfig.enabled = false;
+    captureConfig.path = "capture.jsonl";
+    captureConfig.sample_rate = 0.01;
+    captureConfig.max_body_bytes = 65536;
+    captureConfig.max_file_mb = 512;
+    
+    // Admission 기본값
+    admissionConfig.enabled = true;
+    admissionConfig.read = {20, 4, 200};
+    admissionConfig.write = {10, 2, 50};
+    admissionConfig.latency_tolerance = 2.0;
+    admissionConfig.pool_wait_target_ms = 50;
+    admissionConfig.retry_after_seconds = 1;
+    
+    // RateLimit 기본값
+    rateLimitConfig.enabled = true;
+    rateLimitConfig.client = {100.0, 200.0};
+    rateLimitConfig.route = {50.0, 100.0};
+    rateLimitConfig.max_keys = 65536;
+    rateLimitConfig.shards = 64;
+    rateLimitConfig.trust_forwarded_for = false;
+    
+    // Admin access 기본값
+    adminAccessConfig.allow_loopback = true;
+    adminAccessConfig.token = "";
 }
 
 bool Config::validate() const {
@@ -80,6 +304,31 @@ bool Config::validate() const {
         return false;
     }
     
+    if (dbConfig.pool_size <= 0) {
+        std::cerr << "Invalid pool size: " << dbConfig.pool_size << std::endl;
+        return false;
+    }
+    
+    if (dbConfig.pipeline_pool_size <= 0) {
+        std::cerr << "Invalid pipeline pool size: " << dbConfig.pipeline_pool_size << std::endl;
+        return false;
+    }
+    
+    if (dbConfig.connection_timeout <= 0) {
+        std::cerr << "Invalid connection timeout: " << dbConfig.connection_timeout << std::endl;
+        return false;
+    }
+    
+    if (dbConfig.slow_query_threshold_ms < 0) {
+        std::cerr << "Invalid slow query threshold: " << dbConfig.slow_query_threshold_ms << std::endl;
+        return false;
+    }
+    
+    if (dbConfig.explain_sample_rate < 0.0 || dbConfig.explain_sample_rate > 1.0) {
+        std::cerr << "Invalid explain sample rate: " << dbConfig.explain_sample_rate << std::endl;
+        return false;
+    }
+    
     // Server 설정 검증
     if (serverConfig.port <= 0 || serverConfig.port > 65535) {
         std::cerr << "Invalid server port: " << serverConfig.port << std::endl;
@@ -91,5 +340,110 @@ bool Config::validate() const {
         return false;
     }
     
+    if (serverConfig.mode != "shared" && serverConfig.mode != "per_core") {
+        std::cerr << "Invalid server mode: " << serverConfig.mode << std::endl;
+        return false;
+    }
+    
+    // Logging 설정 검증
+    const std::string& level = loggingConfig.level;
+    if (level != "debug" && level != "info" && level != "warning" && level != "error" && level != "critical") {
+        std::cerr << "Invalid log level: " << level << std::endl;
+        return false;
+    }
+    const AccessLogConfig& access = loggingConfig.access;
+    bool routesValid = true;
+    for (const auto& route : access.slow_routes_ms) {
+        routesValid = routesValid && route.second >= 0;
+    }
+    if (access.sample_one_in <= 0 || access.client_errors_per_second < 0 || access.slow_ms < 0 || !routesValid) {
+        std::cerr << "Invalid access log configuration" << std::endl;
+        return false;
+    }
+    
+    // Executor 설정 검증
+    if (executorConfig.threads <= 0 || executorConfig.queue_capacity <= 0) {
+        std::cerr << "Invalid executor configuration: threads=" << executorConfig.threads
+                  << ", queue_capacity=" << executorConfig.queue_capacity << std::endl;
+        return false;
+    }
+    
+    // Stats 설정 검증
+    if (statsConfig.reconcile_interval_seconds <= 0) {
+        std::cerr << "Invalid stats reconcile interval: " << statsConfig.reconcile_interval_seconds << std::endl;
+        return false;
+    }
+    
+    // Circuit breaker 설정 검증
+    const CircuitBreakerConfig& breaker = circuitBreakerConfig;
+    if (breaker.failure_ratio <= 0.0 || breaker.failure_ratio > 1.0 || breaker.min_requests <= 0 ||
+        breaker.window_ms <= 0 || breaker.open_ms <= 0 || breaker.probe_interval_ms <= 0 ||
+        breaker.stale_max_age_seconds < 0) {
+        std::cerr << "Invalid circuit breaker configuration" << std::endl;
+        return false;
+    }
+    
+    // Profiler 설정 검증
+    const ProfilerConfig& profiler = profilerConfig;
+    if (profiler.frequency_hz <= 0 || profiler.frequency_hz > 1000 || profiler.max_seconds <= 0 ||
+        profiler.max_samples <= 0 || profiler.max_depth <= 0 || profiler.max_depth > 256) {
+        std::cerr << "Invalid profiler configuration" << std::endl;
+        return false;
+    }
+    
+    // Stream 설정 검증
+    if (streamConfig.backlog <= 0 || streamConfig.max_batch <= 0 || streamConfig.max_wait_seconds <= 0 ||
+        streamConfig.linger_ms < 0 || streamConfig.retry_ms < 0 || streamConfig.max_subscribers <= 0) {
+        std::cerr << "Invalid stream configuration" << std::endl;
+        return false;
+    }
+    
+    // Batching 설정 검증
+    if (batchingConfig.window_us < 0 || batchingConfig.window_us > 100000 || batchingConfig.max_batch <= 0) {
+        std::cerr << "Invalid batching configuration" << std::endl;
+        return false;
+    }
+    
+    // Cache snapshot 설정 검증
+    if (cacheSnapshotConfig.save_interval_seconds <= 0 ||
+        (cacheSnapshotConfig.enabled && cacheSnapshotConfig.directory.empty())) {
+        std::cerr << "Invalid cache snapshot configuration" << std::endl;
+        return false;
+    }
+    
+    // Capture 설정 검증
+    if (captureConfig.sample_rate < 0.0 || captureConfig.sample_rate > 1.0 || captureConfig.max_body_bytes < 0 ||
+        captureConfig.max_file_mb <= 0 || (captureConfig.enabled && captureConfig.path.empty())) {
+        std::cerr << "Invalid capture configuration" << std::endl;
+        return false;
+    }
+    
+    // Admission 설정 검증
+    for (const LimiterConfig* limiter : {&admissionConfig.read, &admissionConfig.write}) {
+        if (limiter->min_limit <= 0 || limiter->max_limit < limiter->min_limit) {
+            std::cerr << "Invalid admission limits: " << limiter->min_limit << "-" << limiter->max_limit << std::endl;
+            return false;
+        }
+    }
+    
+    if (admissionConfig.latency_tolerance < 1.0) {
+        std::cerr << "Invalid admission latency tolerance: " << admissionConfig.latency_tolerance << std::endl;
+        return false;
+    }
+    
+    // RateLimit 설정 검증
+    for (const TokenBucketConfig* bucket : {&rateLimitConfig.client, &rateLimitConfig.route}) {
+        if (bucket->rate_per_second <= 0.0 || bucket->burst < 1.0) {
+            std::cerr << "Invalid rate limit: " << bucket->rate_per_second << "/s burst " << bucket->burst << std::endl;
+            return false;
+        }
+    }
+    
+    if (rateLimitConfig.max_keys <= 0 || rateLimitConfig.shards <= 0) {
+        std::cerr << "Invalid rate limit table: max_keys=" << rateLimitConfig.max_keys
+                  << " shards=" << rateLimitConfig.shards << std::endl;
+        return false;
+    }
+    
     return true;
 }
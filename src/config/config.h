@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <string>
 #include <yaml-cpp/yaml.h>
 
@@ -12,18 +13,142 @@ struct DatabaseConfig {
     int connection_timeout;  // 연결 타임아웃 (초)
     int max_retries;        // 최대 재시도 횟수
     int retry_delay;        // 재시도 간격 (초)
+    int pool_size;          // 연결 풀 최대 연결 수
+    int pipeline_pool_size; // 다중 문장 파이프라인(수정/삭제) 전용 연결 수 (pool_size 와 별도)
+    int slow_query_threshold_ms;   // slow query 로그 임계값 (밀리초)
+    double explain_sample_rate;    // slow query 중 EXPLAIN 을 수집할 비율 (0.0 ~ 1.0)
+    bool allow_local_infile;       // LOAD DATA LOCAL INFILE 기반 대량 적재 허용
 };
 
 struct ServerConfig {
     std::string host;
     int port;
     int threads;
+    bool server_timing;     // Server-Timing 응답 헤더 출력 여부
+    std::string mode;       // "shared" 또는 "per_core" (코어별 워커 고정 및 연결 풀 샤딩)
+};
+
+// access log 표본 추출 (5xx, 느린 요청, 한도 안의 4xx 는 항상 기록)
+struct AccessLogConfig {
+    bool sampling;                  // false 이면 모든 요청 기록
+    int sample_one_in;              // 나머지 요청은 N 개 중 하나만 기록
+    int client_errors_per_second;   // 항상 기록할 초당 4xx 수
+    int slow_ms;                    // 이보다 오래 걸린 요청은 항상 기록
+    std::map<std::string, int> slow_routes_ms;  // 라우트별 기준 ("GET /members/{id}": 50)
+};
+
+struct LoggingConfig {
+    std::string level;      // debug, info, warning, error, critical
+    AccessLogConfig access;
+};
+
+struct ExecutorConfig {
+    int threads;            // DB 작업 워커 스레드 수
+    int queue_capacity;     // 최대 대기 작업 수 (초과 시 503)
+};
+
+struct LimiterConfig {
+    int initial_limit;      // 초기 동시 처리 한도
+    int min_limit;          // 최소 한도
+    int max_limit;          // 최대 한도
+};
+
+struct AdmissionConfig {
+    bool enabled;
+    LimiterConfig read;     // GET/HEAD 요청 한도
+    LimiterConfig write;    // 그 외 변경 요청 한도
+    double latency_tolerance;   // 장기 평균 대비 허용 지연 배수
+    int pool_wait_target_ms;    // 연결 풀 대기시간 목표 (초과 시 한도 축소)
+    int retry_after_seconds;    // 503 응답의 Retry-After 값
+};
+
+struct TokenBucketConfig {
+    double rate_per_second;     // 초당 채워지는 요청 수
+    double burst;               // 순간 허용량
+};
+
+struct RateLimitConfig {
+    bool enabled;
+    TokenBucketConfig client;   // 클라이언트 IP 당 (모든 라우트 합산)
+    TokenBucketConfig route;    // 클라이언트 IP + 라우트 당
+    int max_keys;               // 한도별 추적 버킷 수 (넘으면 오래 쓰지 않은 버킷부터 교체, 재시작 필요)
+    int shards;                 // 버킷 표 잠금 단위 (재시작 필요)
+    bool trust_forwarded_for;   // X-Forwarded-For 첫 주소를 클라이언트로 사용 (프록시 뒤에서만)
+};
+
+// /debug/*, /admin/* 접근 제어
+struct AdminAccessConfig {
+    bool allow_loopback;        // 루프백 주소에서 직접 온 요청은 토큰 없이 허용
+    std::string token;          // Authorization: Bearer <token> (비어 있으면 원격 요청은 모두 403)
+};
+
+struct CircuitBreakerConfig {
+    bool enabled;
+    double failure_ratio;       // 집계 창 안의 실패 비율이 이 이상이면 open (즉시 실패)
+    int min_requests;           // 비율 판단에 필요한 최소 호출 수
+    int window_ms;              // 실패율 집계 창
+    int open_ms;                // open 후 첫 probe 까지 대기
+    int probe_interval_ms;      // 백그라운드 probe 주기
+    int stale_max_age_seconds;  // 장애 중 마지막 정상값으로 응답할 수 있는 최대 나이
+};
+
+struct ProfilerConfig {
+    bool enabled;               // false 이면 /debug/profile 은 404
+    int frequency_hz;           // 초당 샘플 수 (CPU 시간 기준, 최대 1000)
+    int max_seconds;            // 한 번에 수집할 수 있는 최대 시간
+    int max_samples;            // 샘플 버퍼 크기 (초과분은 버림)
+    int max_depth;              // 샘플당 최대 스택 깊이
+};
+
+struct StreamConfig {
+    int backlog;                // 재개(Last-Event-ID)에 쓸 최근 이벤트 수
+    int max_batch;              // 응답 하나에 담을 최대 이벤트 수
+    int max_wait_seconds;       // 새 이벤트가 없을 때 응답을 붙잡아 두는 시간
+    int linger_ms;              // 연속 변경을 한 응답에 모으는 시간
+    int retry_ms;               // 클라이언트 재연결 간격 (SSE retry)
+    int max_subscribers;        // 피드별 동시 대기 구독 수 (넘으면 503)
+};
+
+struct BatchingConfig {
+    bool enabled;               // 서로 다른 ID 의 동시 단건 조회를 IN 쿼리 하나로 모음
+    int window_us;              // 첫 조회가 다른 조회를 기다리는 시간 (µs)
+    int max_batch;              // 쿼리 하나에 담을 최대 ID 수
+};
+
+struct CacheSnapshotConfig {
+    bool enabled;               // 검색용 행 캐시를 파일로 저장하고 시작 시 복원
+    std::string directory;      // <directory>/members.snapshot, products.snapshot
+    int save_interval_seconds;  // 주기적 저장 간격 (종료 시에도 저장)
+};
+
+struct CaptureConfig {
+    bool enabled;               // 요청 샘플을 JSONL 로 기록 (tools/replay 로 재생)
+    std::string path;           // 기록 파일 (추가 모드)
+    double sample_rate;         // 기록할 요청 비율
+    int max_body_bytes;         // 요청 본문 최대 기록 크기
+    int max_file_mb;            // 파일이 이 크기에 이르면 기록 중단
+};
+
+struct StatsConfig {
+    int reconcile_interval_seconds;     // 집계를 DB GROUP BY 결과로 재동기화하는 주기
 };
 
 class Config {
 private:
     DatabaseConfig dbConfig;
     ServerConfig serverConfig;
+    AdmissionConfig admissionConfig;
+    RateLimitConfig rateLimitConfig;
+    AdminAccessConfig adminAccessConfig;
+    ExecutorConfig executorConfig;
+    LoggingConfig loggingConfig;
+    StatsConfig statsConfig;
+    CircuitBreakerConfig circuitBreakerConfig;
+    ProfilerConfig profilerConfig;
+    CaptureConfig captureConfig;
+    StreamConfig streamConfig;
+    BatchingConfig batchingConfig;
+    CacheSnapshotConfig cacheSnapshotConfig;
     
 public:
     Config();
@@ -36,10 +161,26 @@ public:
     // Getters
     const DatabaseConfig& getDatabaseConfig() const { return dbConfig; }
     const ServerConfig& getServerConfig() const { return serverConfig; }
+    const AdmissionConfig& getAdmissionConfig() const { return admissionConfig; }
+    const RateLimitConfig& getRateLimitConfig() const { return rateLimitConfig; }
+    const AdminAccessConfig& getAdminAccessConfig() const { return adminAccessConfig; }
+    const ExecutorConfig& getExecutorConfig() const { return executorConfig; }
+    const LoggingConfig& getLoggingConfig() const { return loggingConfig; }
+    const StatsConfig& getStatsConfig() const { return statsConfig; }
+    const CircuitBreakerConfig& getCircuitBreakerConfig() const { return circuitBreakerConfig; }
+    const ProfilerConfig& getProfilerConfig() const { return profilerConfig; }
+    const CaptureConfig& getCaptureConfig() const { return captureConfig; }
+    const StreamConfig& getStreamConfig() const { return streamConfig; }
+    const BatchingConfig& getBatchingConfig() const { return batchingConfig; }
+    const CacheSnapshotConfig& getCacheSnapshotConfig() const { return cacheSnapshotConfig; }
     
     // 기본값 설정
     void setDefaults();
     
     // 설정 검증
     bool validate() const;
+
+private:
+    static void loadLimiterConfig(const YAML::Node& node, LimiterConfig& limiter);
+    static void loadTokenBucketConfig(const YAML::Node& node, TokenBucketConfig& bucket);
 };
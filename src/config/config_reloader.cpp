@@ -0,0 +1,127 @@
+#include "config_reloader.h"
+#include <chrono>
+#include <iostream>
+
+volatile std::sig_atomic_t ConfigReloader::reload_requested = 0;
+
+ConfigReloader::ConfigReloader(const std::string& configFile, const Config& initial)
+    : configFile(configFile), currentConfig(initial) {
+}
+
+ConfigReloader::~ConfigReloader() {
+    {
+        std::lock_guard<std::mutex> lock(watcher_mutex);
+        stopping = true;
+    }
+    watcher_condition.notify_all();
+    if (signal_watcher.joinable()) {
+        signal_watcher.join();
+    }
+}
+
+void ConfigReloader::addApplier(Applier applier) {
+    std::lock_guard<std::mutex> lock(reload_mutex);
+    appliers.push_back(std::move(applier));
+}
+
+ReloadResult ConfigReloader::reload() {
+    ReloadResult result;
+
+    // 새 설정은 기본값 위에 파일을 읽고 validate() 를 통과해야 한다
+    Config next;
+    if (!next.loadFromFile(configFile)) {
+        result.error = "Failed to load or validate " + configFile;
+        std::cerr << "Config reload rejected: " << result.error << std::endl;
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(reload_mutex);
+    for (const auto& applier : appliers) {
+        applier(currentConfig, next, result);
+    }
+    detectRestartRequired(currentConfig, next, result);
+    currentConfig = next;
+    result.success = true;
+
+    std::cout << "Config reloaded from " << configFile << " (applied: " << result.applied.size()
+              << ", restart required: " << result.restart_required.size() << ")" << std::endl;
+    return result;
+}
+
+void ConfigReloader::watchSignal() {
+    std::signal(SIGHUP, &ConfigReloader::handleSignal);
+
+    // 시그널 핸들러에서는 플래그만 세우고, 실제 재로드는 감시 스레드에서 수행
+    signal_watcher = std::thread([this] {
+        std::unique_lock<std::mutex> lock(watcher_mutex);
+        while (!stopping) {
+            watcher_condition.wait_for(lock, std::chrono::milliseconds(500));
+            if (reload_requested) {
+                reload_requested = 0;
+                lock.unlock();
+                reload();
+                lock.lock();
+            }
+        }
+    });
+}
+
+Config ConfigReloader::current() const {
+    std::lock_guard<std::mutex> lock(reload_mutex);
+    return currentConfig;
+}
+
+void ConfigReloader::handleSignal(int /*signal*/) {
+    reload_requested = 1;
+}
+
+void ConfigReloader::detectRestartRequired(const Config& previous, const Config& next, ReloadResult& result) {
+    const DatabaseConfig& oldDb = previous.getDatabaseConfig();
+    const DatabaseConfig& newDb = next.getDatabaseConfig();
+    if (oldDb.host != newDb.host || oldDb.port != newDb.port || oldDb.username != newDb.username ||
+        oldDb.password != newDb.password || oldDb.database != newDb.database ||
+        oldDb.allow_local_infile != newDb.allow_local_infile || oldDb.pipeline_pool_size != newDb.pipeline_pool_size) {
+        result.restart_required.push_back("database.connection");
+    }
+
+    const ServerConfig& oldServer = previous.getServerConfig();
+    const ServerConfig& newServer = next.getServerConfig();
+    if (oldServer.host != newServer.host || oldServer.port != newServer.port ||
+        oldServer.threads != newServer.threads || oldServer.mode != newServer.mode) {
+        result.restart_required.push_back("server");
+    }
+
+    const ExecutorConfig& oldExecutor = previous.getExecutorConfig();
+    const ExecutorConfig& newExecutor = next.getExecutorConfig();
+    if (oldExecutor.threads != newExecutor.threads || oldExecutor.queue_capacity != newExecutor.queue_capacity) {
+        result.restart_required.push_back("executor");
+    }
+
+    const AdmissionConfig& oldAdmission = previous.getAdmissionConfig();
+    const AdmissionConfig& newAdmission = next.getAdmissionConfig();
+    if (oldAdmission.enabled != newAdmission.enabled ||
+        oldAdmission.read.initial_limit != newAdmission.read.initial_limit ||
+        oldAdmission.read.min_limit != newAdmission.read.min_limit ||
+        oldAdmission.read.max_limit != newAdmission.read.max_limit ||
+        oldAdmission.write.initial_limit != newAdmission.write.initial_limit ||
+        oldAdmission.write.min_limit != newAdmission.write.min_limit ||
+        oldAdmission.write.max_limit != newAdmission.write.max_limit ||
+        oldAdmission.latency_tolerance != newAdmission.latency_tolerance ||
+        oldAdmission.pool_wait_target_ms != newAdmission.pool_wait_target_ms ||
+        oldAdmission.retry_after_seconds != newAdmission.retry_after_seconds) {
+        result.restart_required.push_back("admission");
+    }
+
+    const RateLimitConfig& oldRateLimit = previous.getRateLimitConfig();
+    const RateLimitConfig& newRateLimit = next.getRateLimitConfig();
+    if (oldRateLimit.max_keys != newRateLimit.max_keys || oldRateLimit.shards != newRateLimit.shards) {
+        result.restart_required.push_back("rate_limit.table");
+    }
+
+    const CacheSnapshotConfig& oldSnapshot = previous.getCacheSnapshotConfig();
+    const CacheSnapshotConfig& newSnapshot = next.getCacheSnapshotConfig();
+    if (oldSnapshot.enabled != newSnapshot.enabled || oldSnapshot.directory != newSnapshot.directory ||
+        oldSnapshot.save_interval_seconds != newSnapshot.save_interval_seconds) {
+        result.restart_required.push_back("cache_snapshot");
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "config.h"
+#include <condition_variable>
+#include <csignal>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 설정 재적용 결과
+struct ReloadResult {
+    bool success = false;
+    std::string error;
+    std::vector<std::string> applied;           // 즉시 적용된 항목
+    std::vector<std::string> restart_required;  // 변경되었지만 재시작해야 적용되는 항목
+};
+
+// config.yaml 을 다시 읽어 검증한 뒤, 실행 중에 바꿀 수 있는 설정을 적용한다.
+// SIGHUP 또는 관리용 라우트에서 reload() 를 호출한다.
+class ConfigReloader {
+public:
+    // previous → next 변경 중 담당 항목을 적용하고 result.applied 에 기록
+    using Applier = std::function<void(const Config& previous, const Config& next, ReloadResult& result)>;
+
+private:
+    std::string configFile;
+    Config currentConfig;
+    std::vector<Applier> appliers;
+    mutable std::mutex reload_mutex;
+
+    std::thread signal_watcher;
+    std::mutex watcher_mutex;
+    std::condition_variable watcher_condition;
+    bool stopping = false;
+
+    static volatile std::sig_atomic_t reload_requested;
+
+public:
+    ConfigReloader(const std::string& configFile, const Config& initial);
+    ~ConfigReloader();
+
+    ConfigReloader(const ConfigReloader&) = delete;
+    ConfigReloader& operator=(const ConfigReloader&) = delete;
+
+    void addApplier(Applier applier);
+
+    // 설정 파일 재로드 및 적용
+    ReloadResult reload();
+
+    // SIGHUP 수신 시 reload() 를 실행하는 감시 스레드 시작
+    void watchSignal();
+
+    Config current() const;
+
+private:
+    static void handleSignal(int signal);
+    static void detectRestartRequired(const Config& previous, const Config& next, ReloadResult& result);
+};
@@ -2,16 +2,101 @@
 #include "crow.h"
 #include "router/member_router.h"
 #include "router/product_router.h"
+#include "router/debug_router.h"
+#include "router/admin_router.h"
+#include "router/batch_router.h"
 #include "service/member_service.h"
 #include "service/product_service.h"
+#include "service/batch_service.h"
 #include "repository/mysql_member_repository.h"
 #include "repository/mysql_product_repository.h"
 #include "repository/mysql_connection_pool.h"
+#include "repository/query_instrumentation.h"
 #include "config/config.h"
+#include "config/config_reloader.h"
+#include "utils/db_executor.h"
+#include "utils/cpu_affinity.h"
+#include "utils/periodic_task.h"
+#include "utils/alloc_stats.h"
+#include "utils/cpu_profiler.h"
 #include "middleware/access_log_middleware.h"
+#include "middleware/admission_middleware.h"
+#include "middleware/rate_limit_middleware.h"
 #include <iostream>
 #include <memory>
 
+// 설정 파일의 로그 레벨 문자열을 Crow 로그 레벨로 변환
+static crow::LogLevel toLogLevel(const std::string& level) {
+    if (level == "debug") return crow::LogLevel::Debug;
+    if (level == "warning") return crow::LogLevel::Warning;
+    if (level == "error") return crow::LogLevel::Error;
+    if (level == "critical") return crow::LogLevel::Critical;
+    return crow::LogLevel::Info;
+}
+
+// 설정 파일의 circuit breaker 항목을 CircuitBreaker 설정으로 변환
+static CircuitBreaker::Settings toBreakerSettings(const CircuitBreakerConfig& config) {
+    CircuitBreaker::Settings settings;
+    settings.enabled = config.enabled;
+    settings.failure_ratio = config.failure_ratio;
+    settings.min_requests = config.min_requests;
+    settings.window = std::chrono::milliseconds(config.window_ms);
+    settings.open_duration = std::chrono::milliseconds(config.open_ms);
+    return settings;
+}
+
+static TrafficCapture::Settings toCaptureSettings(const CaptureConfig& config) {
+    TrafficCapture::Settings settings;
+    settings.enabled = config.enabled;
+    settings.path = config.path;
+    settings.sample_rate = config.sample_rate;
+    settings.max_body_bytes = static_cast<size_t>(config.max_body_bytes);
+    settings.max_file_bytes = static_cast<size_t>(config.max_file_mb) * 1024 * 1024;
+    return settings;
+}
+
+static LogSampler::Settings toLogSamplerSettings(const AccessLogConfig& config) {
+    LogSampler::Settings settings;
+    settings.enabled = config.sampling;
+    settings.sample_one_in = static_cast<uint32_t>(config.sample_one_in);
+    settings.client_errors_per_second = static_cast<uint32_t>(config.client_errors_per_second);
+    settings.slow_us = static_cast<int64_t>(config.slow_ms) * 1000;
+    for (const auto& route : config.slow_routes_ms) {
+        settings.route_slow_us[route.first] = static_cast<int64_t>(route.second) * 1000;
+    }
+    return settings;
+}
+
+static ChangeFeed::Settings toChangeFeedSettings(const StreamConfig& config) {
+    ChangeFeed::Settings settings;
+    settings.backlog = static_cast<size_t>(config.backlog);
+    settings.max_batch = static_cast<size_t>(config.max_batch);
+    settings.max_wait_ms = config.max_wait_seconds * 1000;
+    settings.linger_ms = config.linger_ms;
+    settings.retry_ms = config.retry_ms;
+    settings.max_subscribers = static_cast<size_t>(config.max_subscribers);
+    return settings;
+}
+
+template<typename Row>
+static typename BatchLoader<std::string, Row>::Settings toBatchLoaderSettings(const BatchingConfig& config) {
+    typename BatchLoader<std::string, Row>::Settings settings;
+    settings.enabled = config.enabled;
+    settings.window_us = config.window_us;
+    settings.max_batch = static_cast<size_t>(config.max_batch);
+    return settings;
+}
+
+static CpuProfiler::Settings toProfilerSettings(const ProfilerConfig& config) {
+    CpuProfiler::Settings settings;
+    settings.enabled = config.enabled;
+    settings.frequency_hz = config.frequency_hz;
+    settings.max_seconds = config.max_seconds;
+    settings.max_samples = config.max_samples;
+    settings.max_depth = config.max_depth;
+    return settings;
+}
+
 int main(const int argc, char* argv[]) {
     // 설정 파일 경로 (기본값: config.yaml)
     std::string configFile = "config.yaml";
@@ -28,13 +113,24 @@ int main(const int argc, char* argv[]) {
     }
     
     std::cout << "Configuration loaded from: " << configFile << std::endl;
+    crow::logger::setLogLevel(toLogLevel(config.getLoggingConfig().level));
     std::cout << "Database: " << config.getDatabaseConfig().host << ":" 
               << config.getDatabaseConfig().port << "/" << config.getDatabaseConfig().database << std::endl;
     std::cout << "Server: " << config.getServerConfig().host << ":" 
               << config.getServerConfig().port << " (threads: " << config.getServerConfig().threads << ")" << std::endl;
     
+    // per_core 모드: 코어 수만큼 I/O 스레드를 두고, executor 워커를 코어에 고정하며
+    // 연결 풀을 코어별 샤드로 나눠 코어 간 잠금 경합을 없앤다
+    const ServerConfig& serverConfig = config.getServerConfig();
+    const bool perCoreMode = serverConfig.mode == "per_core";
+    const unsigned coreCount = cpu_affinity::coreCount();
+    const unsigned ioThreads = perCoreMode ? coreCount : static_cast<unsigned>(serverConfig.threads);
+    std::cout << "Serving mode: " << serverConfig.mode << " (I/O threads: " << ioThreads << ")" << std::endl;
+    
     // MySQL 연결 풀 생성 및 초기화
-    auto connectionPool = std::make_shared<MySQLConnectionPool>(config.getDatabaseConfig(), 10);
+    auto connectionPool = std::make_shared<MySQLConnectionPool>(config.getDatabaseConfig(),
+                                                                config.getDatabaseConfig().pool_size,
+                                                                perCoreMode ? coreCount : 1);
     
     // 데이터베이스 연결 확인
     if (!connectionPool->initialize()) {
@@ -44,26 +140,260 @@ int main(const int argc, char* argv[]) {
     
     std::cout << "Database connection pool initialized successfully!" << std::endl;
     
-    crow::App<AccessLogMiddleware> app;
+    // DB 장애 시 연결 시도 없이 즉시 실패하고, 백그라운드에서 회복 여부 확인
+    const CircuitBreakerConfig& breakerConfig = config.getCircuitBreakerConfig();
+    connectionPool->circuitBreaker().configure(toBreakerSettings(breakerConfig));
+    PeriodicTask breakerProbe(std::chrono::milliseconds(breakerConfig.probe_interval_ms), [connectionPool] {
+        connectionPool->probe();
+    });
+    
+    crow::App<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> app;
+    app.get_middleware<AccessLogMiddleware>().enableServerTiming(config.getServerConfig().server_timing);
+    app.get_middleware<AccessLogMiddleware>().configureCapture(toCaptureSettings(config.getCaptureConfig()));
+    app.get_middleware<AccessLogMiddleware>().configureSampling(toLogSamplerSettings(config.getLoggingConfig().access));
+    app.get_middleware<RateLimitMiddleware>().configure(config.getRateLimitConfig());
+    app.get_middleware<AdmissionMiddleware>().configure(config.getAdmissionConfig(), connectionPool);
+    
+    // 쿼리 계측 (slow query 로그 및 문장별 통계)
+    auto queryInstrumentation = std::make_shared<QueryInstrumentation>(connectionPool, config.getDatabaseConfig());
     
     // Repository 인스턴스 생성 (연결 풀 전달)
-    MySQLMemberRepository memberRepository(connectionPool);
-    MySQLProductRepository productRepository(connectionPool);
+    MySQLMemberRepository memberRepository(connectionPool, queryInstrumentation);
+    MySQLProductRepository productRepository(connectionPool, queryInstrumentation);
     
     // Service 인스턴스 생성 (Repository 참조 전달)
     MemberService memberService(memberRepository);
     ProductService productService(productRepository);
+    memberService.setStaleMaxAge(std::chrono::seconds(breakerConfig.stale_max_age_seconds));
+    productService.setStaleMaxAge(std::chrono::seconds(breakerConfig.stale_max_age_seconds));
+    memberService.changes().configure(toChangeFeedSettings(config.getStreamConfig()));
+    productService.changes().configure(toChangeFeedSettings(config.getStreamConfig()));
+    memberService.configureBatching(toBatchLoaderSettings<MemberRow>(config.getBatchingConfig()));
+    productService.configureBatching(toBatchLoaderSettings<ProductRow>(config.getBatchingConfig()));
+    
+    // 검색용 행 캐시를 지난 실행의 스냅샷에서 복원 (리스너를 열기 전) 및 주기적 저장
+    const CacheSnapshotConfig& snapshotConfig = config.getCacheSnapshotConfig();
+    const std::string memberSnapshotPath = snapshotConfig.directory + "/members.snapshot";
+    const std::string productSnapshotPath = snapshotConfig.directory + "/products.snapshot";
+    auto saveSnapshots = [&] {
+        memberService.saveSnapshot(memberSnapshotPath);
+        productService.saveSnapshot(productSnapshotPath);
+    };
+    std::unique_ptr<PeriodicTask> snapshotSaver;
+    if (snapshotConfig.enabled) {
+        if (memberService.restoreSnapshot(memberSnapshotPath)) {
+            std::cout << "Restored member cache from " << memberSnapshotPath << std::endl;
+        }
+        if (productService.restoreSnapshot(productSnapshotPath)) {
+            std::cout << "Restored product cache from " << productSnapshotPath << std::endl;
+        }
+        snapshotSaver = std::make_unique<PeriodicTask>(std::chrono::seconds(snapshotConfig.save_interval_seconds), saveSnapshots);
+    }
+    
+    // 집계 초기화 (GROUP BY 한 번) 및 주기적 재동기화
+    memberService.reseedStats();
+    productService.reseedStats();
+    PeriodicTask statsReconciler(std::chrono::seconds(config.getStatsConfig().reconcile_interval_seconds), [&] {
+        memberService.reseedStats();
+        productService.reseedStats();
+    });
+    // 최소/최대값이 빠진 카테고리는 쓰기 경로에서 DB 를 조회하지 않고 여기서 다시 계산
+    PeriodicTask staleStatsRefresher(std::chrono::seconds(1), [&] {
+        productService.refreshStaleStats();
+    });
+    
+    // DB 작업 전용 executor (I/O 스레드와 DB 대기를 분리)
+    DbExecutor dbExecutor(config.getExecutorConfig().threads, config.getExecutorConfig().queue_capacity, perCoreMode);
     
     // 각 도메인별 라우터 생성 및 라우트 설정 (Service 참조 전달)
-    MemberRouter<AccessLogMiddleware> memberRouter(app, memberService);
+    MemberRouter<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> memberRouter(app, memberService, dbExecutor);
     memberRouter.setupRoutes();
     
-    ProductRouter<AccessLogMiddleware> productRouter(app, productService);
+    ProductRouter<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> productRouter(app, productService, dbExecutor);
     productRouter.setupRoutes();
     
-    // 서버 시작 (설정된 포트와 스레드 수 사용)
-    app.port(config.getServerConfig().port)
-       .multithreaded()
+    // 여러 도메인 작업을 한 트랜잭션으로 실행하는 일괄 처리
+    BatchService batchService(connectionPool, queryInstrumentation, memberService, productService);
+    BatchRouter<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> batchRouter(app, batchService, dbExecutor);
+    batchRouter.setupRoutes();
+    
+    // 운영용 라우트는 루프백 또는 토큰으로만 접근
+    AdminAccess adminAccess;
+    adminAccess.configure(config.getAdminAccessConfig());
+    
+    CpuProfiler::instance().configure(toProfilerSettings(config.getProfilerConfig()));
+    DebugRouter<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> debugRouter(app, queryInstrumentation, dbExecutor,
+                                                                                           adminAccess);
+    debugRouter.setupRoutes();
+    
+    // 서브시스템별 힙 게이지 (/debug/allocations)
+    alloc_stats::registerGauge("pool.connections", [connectionPool] {
+        return static_cast<int64_t>(connectionPool->openConnections());
+    });
+    alloc_stats::registerGauge("request_arenas.idle_bytes", [] {
+        return static_cast<int64_t>(RequestArena::pool().idleCount() * sizeof(RequestArena));
+    });
+    alloc_stats::registerGauge("members.cached_rows", [&memberService] {
+        return static_cast<int64_t>(memberService.cachedRows());
+    });
+    alloc_stats::registerGauge("products.cached_rows", [&productService] {
+        return static_cast<int64_t>(productService.cachedRows());
+    });
+    alloc_stats::registerGauge("products.snapshot_bytes", [&productService] {
+        return static_cast<int64_t>(productService.snapshotBytes());
+    });
+    alloc_stats::registerGauge("queries.shapes", [queryInstrumentation] {
+        return static_cast<int64_t>(queryInstrumentation->shapeCount());
+    });
+    alloc_stats::registerGauge("rate_limit.tracked_keys", [&app] {
+        auto& rateLimit = app.get_middleware<RateLimitMiddleware>();
+        return static_cast<int64_t>(rateLimit.client_limiter->trackedKeys() + rateLimit.route_limiter->trackedKeys());
+    });
+    
+    // 설정 재로드: 실행 중에 바꿀 수 있는 항목만 적용하고 나머지는 재시작 필요로 보고
+    ConfigReloader configReloader(configFile, config);
+    configReloader.addApplier([connectionPool](const Config& previous, const Config& next, ReloadResult& result) {
+        const DatabaseConfig& before = previous.getDatabaseConfig();
+        const DatabaseConfig& after = next.getDatabaseConfig();
+        if (before.pool_size != after.pool_size) {
+            connectionPool->resize(after.pool_size);
+            result.applied.push_back("database.pool_size");
+        }
+        if (before.connection_timeout != after.connection_timeout) {
+            connectionPool->setTimeouts(after.connection_timeout);
+            result.applied.push_back("database.connection_timeout");
+        }
+    });
+    configReloader.addApplier([queryInstrumentation](const Config& previous, const Config& next, ReloadResult& result) {
+        const DatabaseConfig& before = previous.getDatabaseConfig();
+        const DatabaseConfig& after = next.getDatabaseConfig();
+        if (before.slow_query_threshold_ms != after.slow_query_threshold_ms) {
+            queryInstrumentation->setSlowQueryThreshold(after.slow_query_threshold_ms);
+            result.applied.push_back("database.slow_query_threshold_ms");
+        }
+        if (before.explain_sample_rate != after.explain_sample_rate) {
+            queryInstrumentation->setExplainSampleRate(after.explain_sample_rate);
+            result.applied.push_back("database.explain_sample_rate");
+        }
+    });
+    configReloader.addApplier([&app](const Config& previous, const Config& next, ReloadResult& result) {
+        if (previous.getServerConfig().server_timing != next.getServerConfig().server_timing) {
+            app.get_middleware<AccessLogMiddleware>().enableServerTiming(next.getServerConfig().server_timing);
+            result.applied.push_back("server.server_timing");
+        }
+        if (previous.getLoggingConfig().level != next.getLoggingConfig().level) {
+            crow::logger::setLogLevel(toLogLevel(next.getLoggingConfig().level));
+            result.applied.push_back("logging.level");
+        }
+        const AccessLogConfig& before = previous.getLoggingConfig().access;
+        const AccessLogConfig& after = next.getLoggingConfig().access;
+        if (before.sampling != after.sampling || before.sample_one_in != after.sample_one_in ||
+            before.client_errors_per_second != after.client_errors_per_second || before.slow_ms != after.slow_ms ||
+            before.slow_routes_ms != after.slow_routes_ms) {
+            app.get_middleware<AccessLogMiddleware>().configureSampling(toLogSamplerSettings(after));
+            result.applied.push_back("logging.access");
+        }
+    });
+    configReloader.addApplier([&statsReconciler](const Config& previous, const Config& next, ReloadResult& result) {
+        int interval = next.getStatsConfig().reconcile_interval_seconds;
+        if (previous.getStatsConfig().reconcile_interval_seconds != interval) {
+            statsReconciler.setInterval(std::chrono::seconds(interval));
+            result.applied.push_back("stats.reconcile_interval_seconds");
+        }
+    });
+    configReloader.addApplier([connectionPool, &breakerProbe, &memberService, &productService](
+            const Config& previous, const Config& next, ReloadResult& result) {
+        const CircuitBreakerConfig& before = previous.getCircuitBreakerConfig();
+        const CircuitBreakerConfig& after = next.getCircuitBreakerConfig();
+        if (before.enabled != after.enabled || before.failure_ratio != after.failure_ratio ||
+            before.min_requests != after.min_requests || before.window_ms != after.window_ms ||
+            before.open_ms != after.open_ms) {
+            connectionPool->circuitBreaker().configure(toBreakerSettings(after));
+            result.applied.push_back("circuit_breaker");
+        }
+        if (before.probe_interval_ms != after.probe_interval_ms) {
+            breakerProbe.setInterval(std::chrono::milliseconds(after.probe_interval_ms));
+            result.applied.push_back("circuit_breaker.probe_interval_ms");
+        }
+        if (before.stale_max_age_seconds != after.stale_max_age_seconds) {
+            memberService.setStaleMaxAge(std::chrono::seconds(after.stale_max_age_seconds));
+            productService.setStaleMaxAge(std::chrono::seconds(after.stale_max_age_seconds));
+            result.applied.push_back("circuit_breaker.stale_max_age_seconds");
+        }
+    });
+    configReloader.addApplier([](const Config& previous, const Config& next, ReloadResult& result) {
+        const ProfilerConfig& before = previous.getProfilerConfig();
+        const ProfilerConfig& after = next.getProfilerConfig();
+        if (before.enabled != after.enabled || before.frequency_hz != after.frequency_hz ||
+            before.max_seconds != after.max_seconds || before.max_samples != after.max_samples ||
+            before.max_depth != after.max_depth) {
+            CpuProfiler::instance().configure(toProfilerSettings(after));
+            result.applied.push_back("profiler");
+        }
+    });
+    configReloader.addApplier([&app](const Config& previous, const Config& next, ReloadResult& result) {
+        const CaptureConfig& before = previous.getCaptureConfig();
+        const CaptureConfig& after = next.getCaptureConfig();
+        if (before.enabled != after.enabled || before.path != after.path || before.sample_rate != after.sample_rate ||
+            before.max_body_bytes != after.max_body_bytes || before.max_file_mb != after.max_file_mb) {
+            app.get_middleware<AccessLogMiddleware>().configureCapture(toCaptureSettings(after));
+            result.applied.push_back("capture");
+        }
+    });
+    configReloader.addApplier([&app](const Config& previous, const Config& next, ReloadResult& result) {
+        const RateLimitConfig& before = previous.getRateLimitConfig();
+        const RateLimitConfig& after = next.getRateLimitConfig();
+        if (before.enabled != after.enabled || before.trust_forwarded_for != after.trust_forwarded_for ||
+            before.client.rate_per_second != after.client.rate_per_second || before.client.burst != after.client.burst ||
+            before.route.rate_per_second != after.route.rate_per_second || before.route.burst != after.route.burst) {
+            app.get_middleware<RateLimitMiddleware>().configure(after);
+            result.applied.push_back("rate_limit");
+        }
+    });
+    configReloader.addApplier([&adminAccess](const Config& previous, const Config& next, ReloadResult& result) {
+        const AdminAccessConfig& before = previous.getAdminAccessConfig();
+        const AdminAccessConfig& after = next.getAdminAccessConfig();
+        if (before.allow_loopback != after.allow_loopback || before.token != after.token) {
+            adminAccess.configure(after);
+            result.applied.push_back("admin_access");
+        }
+    });
+    configReloader.addApplier([&memberService, &productService](const Config& previous, const Config& next, ReloadResult& result) {
+        const StreamConfig& before = previous.getStreamConfig();
+        const StreamConfig& after = next.getStreamConfig();
+        if (before.backlog != after.backlog || before.max_batch != after.max_batch ||
+            before.max_wait_seconds != after.max_wait_seconds || before.linger_ms != after.linger_ms ||
+            before.retry_ms != after.retry_ms || before.max_subscribers != after.max_subscribers) {
+            memberService.changes().configure(toChangeFeedSettings(after));
+            productService.changes().configure(toChangeFeedSettings(after));
+            result.applied.push_back("stream");
+        }
+    });
+    configReloader.addApplier([&memberService, &productService](const Config& previous, const Config& next, ReloadResult& result) {
+        const BatchingConfig& before = previous.getBatchingConfig();
+        const BatchingConfig& after = next.getBatchingConfig();
+        if (before.enabled != after.enabled || before.window_us != after.window_us ||
+            before.max_batch != after.max_batch) {
+            memberService.configureBatching(toBatchLoaderSettings<MemberRow>(after));
+            productService.configureBatching(toBatchLoaderSettings<ProductRow>(after));
+            result.applied.push_back("batching");
+        }
+    });
+    configReloader.watchSignal();
+    
+    AdminRouter<AccessLogMiddleware, RateLimitMiddleware, AdmissionMiddleware> adminRouter(app, configReloader, adminAccess);
+    adminRouter.setupRoutes();
+    
+    // 서버 시작 (설정된 주소, 포트와 스레드 수 사용)
+    app.bindaddr(serverConfig.host)
+       .port(serverConfig.port)
+       .concurrency(ioThreads)
        .run();
+    
+    // 정상 종료 시 다음 실행을 위해 캐시 저장
+    if (snapshotConfig.enabled) {
+        snapshotSaver.reset();
+        saveSnapshots();
+    }
     return 0;
 }
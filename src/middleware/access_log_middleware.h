@@ -1,6 +1,11 @@
 #pragma once
 
 #include "crow.h"
+#include "../utils/request_context.h"
+#include "../utils/alloc_stats.h"
+#include "../utils/log_sampler.h"
+#include "../utils/traffic_capture.h"
+#include <atomic>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
@@ -10,12 +15,41 @@ struct AccessLogMiddleware
     struct context
     {
         std::chrono::high_resolution_clock::time_point start_time;
+        RequestContext request;
     };
 
+    // Server-Timing 응답 헤더 출력 여부 (opt-in, 설정 재로드로 변경 가능)
+    std::atomic<bool> server_timing_enabled{false};
+
+    // 요청 샘플 캡처 (traffic_replay 로 재생, 기본 꺼짐)
+    TrafficCapture capture;
+
+    // access log 표본 추출 (기본 꺼짐: 모든 요청 기록)
+    LogSampler sampler;
+
+    void enableServerTiming(bool enabled)
+    {
+        server_timing_enabled = enabled;
+    }
+
+    void configureCapture(const TrafficCapture::Settings& settings)
+    {
+        capture.configure(settings);
+    }
+
+    void configureSampling(const LogSampler::Settings& settings)
+    {
+        sampler.configure(settings);
+    }
+
     void before_handle(crow::request& /*req*/, crow::response& /*res*/, context& ctx)
     {
         // 요청 시작 시간 기록
         ctx.start_time = std::chrono::high_resolution_clock::now();
+
+        // 단계별 타이머가 이 요청에 기록되도록 현재 스레드에 바인딩
+        ctx.request.reset();
+        request_context::bind(&ctx.request);
     }
 
     void after_handle(crow::request& req, crow::response& res, context& ctx)
@@ -25,10 +59,51 @@ struct AccessLogMiddleware
         
         // 응답시간을 마이크로초 단위로 계산
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - ctx.start_time);
+
+        if (request_context::current() == &ctx.request) {
+            request_context::bind(nullptr);
+        }
+        // 요청 범위 임시 메모리를 한 번에 반환
+        ctx.request.releaseArena();
+        const StageTimings& timings = ctx.request.timings;
+
+        if (server_timing_enabled) {
+            res.set_header("Server-Timing", formatServerTiming(timings, duration.count()));
+        }
+
+        // DB 장애 중 마지막 정상값으로 응답한 경우 (RFC 7234 Warning 110, Age)
+        if (ctx.request.stale_age_seconds >= 0) {
+            res.set_header("Warning", "110 - \"Response is Stale\"");
+            res.set_header("Age", std::to_string(ctx.request.stale_age_seconds));
+        }
         
-        // 현재 시간을 한국 시간(KST, UTC+9)으로 포맷팅 (ISO 8601 형식)
         auto now = std::chrono::system_clock::now();
         auto time_t = std::chrono::system_clock::to_time_t(now);
+
+        // 할당 계측 빌드: 요청당 할당 횟수/바이트를 라우트별로 집계 (로그 표본과 무관하게 모두 집계)
+        std::string route;
+        if (alloc_stats::enabled() || sampler.hasRouteThresholds()) {
+            route = alloc_stats::routeKey(crow::method_name(req.method), req.url);
+        }
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        if (alloc_stats::enabled()) {
+            allocations = ctx.request.allocations.count.load(std::memory_order_relaxed);
+            bytes = ctx.request.allocations.bytes.load(std::memory_order_relaxed);
+            alloc_stats::recordRequest(route, allocations, bytes);
+        }
+
+        if (capture.sample() && !isInternalPath(req.url)) {
+            captureRequest(req, res, duration.count());
+        }
+
+        // 기록하지 않을 요청은 로그 줄을 만들지 않는다
+        LogSampler::Decision decision = sampler.decide(route, res.code, duration.count(), static_cast<int64_t>(time_t));
+        if (!decision.log) {
+            return;
+        }
+        
+        // 현재 시간을 한국 시간(KST, UTC+9)으로 포맷팅 (ISO 8601 형식)
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
         
         std::tm* local_tm = std::localtime(&time_t);
@@ -42,8 +117,59 @@ struct AccessLogMiddleware
                    << " " << res.code
                    << " " << (res.body.size() > 0 ? res.body.size() : 0)
                    << " " << duration.count() << "μs";
+
+        // 단계별 소요시간 (마이크로초)
+        for (size_t i = 0; i < static_cast<size_t>(Stage::Count); ++i) {
+            log_stream << " " << stageName(static_cast<Stage>(i)) << "=" << timings.micros[i];
+        }
+
+        if (alloc_stats::enabled()) {
+            log_stream << " alloc=" << allocations << " alloc_bytes=" << bytes;
+        }
+
+        // 표본 추출 중이면 이 줄이 대표하는 요청 수와 기록 사유 (sample 합계 = 추정 요청 수)
+        if (decision.reason != LogSampler::Reason::All) {
+            log_stream << " sample=" << decision.sample << " keep=" << LogSampler::reasonName(decision.reason);
+        }
         
         // access log 출력
         CROW_LOG_INFO << "[ACCESS] " << log_stream.str();
     }
-};
\ No newline at end of file
+
+    // 재생하면 안 되는 운영용 경로 (/debug/profile 등)
+    static bool isInternalPath(const std::string& url)
+    {
+        return url.compare(0, 7, "/debug/") == 0 || url.compare(0, 7, "/admin/") == 0;
+    }
+
+    void captureRequest(const crow::request& req, const crow::response& res, int64_t duration_us)
+    {
+        TrafficCapture::Entry entry;
+        entry.offset_us = capture.offsetMicros() - duration_us;     // 요청 시작 시점
+        entry.method = crow::method_name(req.method);
+        entry.url = req.raw_url;
+        for (const auto& header : req.headers) {
+            if (!TrafficCapture::isSensitiveHeader(header.first)) {
+                entry.headers.emplace_back(header.first, header.second);
+            }
+        }
+        entry.body = req.body;
+        entry.status = res.code;
+        entry.duration_us = duration_us;
+        entry.response_bytes = res.body.size();
+        entry.response_hash = TrafficCapture::hashBody(res.body);
+        capture.submit(std::move(entry));
+    }
+
+    // Server-Timing 헤더 값 생성 (dur 단위: 밀리초)
+    static std::string formatServerTiming(const StageTimings& timings, int64_t total_us)
+    {
+        std::ostringstream header;
+        header << std::fixed << std::setprecision(3);
+        for (size_t i = 0; i < static_cast<size_t>(Stage::Count); ++i) {
+            header << stageName(static_cast<Stage>(i)) << ";dur=" << timings.micros[i] / 1000.0 << ", ";
+        }
+        header << "total;dur=" << total_us / 1000.0;
+        return header.str();
+    }
+};
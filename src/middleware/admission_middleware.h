@@ -0,0 +1,101 @@
+#pragma once
+
+#include "crow.h"
+#include "../config/config.h"
+#include "../repository/mysql_connection_pool.h"
+#include "../utils/adaptive_limiter.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+// 서비스 계층 앞단의 admission control.
+// 읽기/쓰기 요청에 별도의 적응형 동시 처리 한도를 두고, 한도를 넘는 요청은
+// 연결 풀에 줄 서기 전에 503 + Retry-After 로 즉시 거절한다.
+struct AdmissionMiddleware
+{
+    struct context
+    {
+        AdaptiveLimiter* limiter = nullptr;
+        std::chrono::high_resolution_clock::time_point start_time;
+    };
+
+    bool enabled = false;
+    std::unique_ptr<AdaptiveLimiter> read_limiter;
+    std::unique_ptr<AdaptiveLimiter> write_limiter;
+    std::shared_ptr<MySQLConnectionPool> connection_pool;
+    int64_t pool_wait_target_us = 0;
+    std::string retry_after = "1";
+
+    void configure(const AdmissionConfig& config, std::shared_ptr<MySQLConnectionPool> pool)
+    {
+        enabled = config.enabled;
+        read_limiter = std::make_unique<AdaptiveLimiter>(toSettings(config.read, config.latency_tolerance));
+        write_limiter = std::make_unique<AdaptiveLimiter>(toSettings(config.write, config.latency_tolerance));
+        connection_pool = pool;
+        pool_wait_target_us = static_cast<int64_t>(config.pool_wait_target_ms) * 1000;
+        retry_after = std::to_string(config.retry_after_seconds);
+    }
+
+    void before_handle(crow::request& req, crow::response& res, context& ctx)
+    {
+        ctx.limiter = nullptr;
+        if (!enabled || !read_limiter || isExempt(req)) {
+            return;
+        }
+
+        AdaptiveLimiter* limiter = isRead(req) ? read_limiter.get() : write_limiter.get();
+        if (!limiter->tryAcquire()) {
+            res.code = 503;
+            res.set_header("Content-Type", "application/json");
+            res.set_header("Retry-After", retry_after);
+            res.write(crow::json::wvalue({
+                {"error", "Server is overloaded, please retry later"}
+            }).dump());
+            res.end();
+            return;
+        }
+
+        ctx.limiter = limiter;
+        ctx.start_time = std::chrono::high_resolution_clock::now();
+    }
+
+    void after_handle(crow::request& /*req*/, crow::response& res, context& ctx)
+    {
+        if (ctx.limiter == nullptr) {
+            return;
+        }
+
+        auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - ctx.start_time);
+
+        // 연결 풀 대기시간이 목표를 넘거나 서버 오류가 나면 과부하로 간주
+        bool overloaded = res.code >= 500 ||
+            (connection_pool && connection_pool->averageWaitMicros() > pool_wait_target_us);
+
+        ctx.limiter->release(rtt.count(), overloaded);
+        ctx.limiter = nullptr;
+    }
+
+private:
+    static AdaptiveLimiter::Settings toSettings(const LimiterConfig& config, double tolerance)
+    {
+        AdaptiveLimiter::Settings settings;
+        settings.initial_limit = config.initial_limit;
+        settings.min_limit = config.min_limit;
+        settings.max_limit = config.max_limit;
+        settings.tolerance = tolerance;
+        return settings;
+    }
+
+    static bool isRead(const crow::request& req)
+    {
+        return req.method == crow::HTTPMethod::Get || req.method == crow::HTTPMethod::Head;
+    }
+
+    // 변경 스트림과 CPU 프로파일은 응답을 오래 붙잡아 두므로 동시 처리 한도와 지연 관측에서 뺀다
+    static bool isExempt(const crow::request& req)
+    {
+        return req.url.compare(0, 14, "/debug/profile") == 0 ||
+               (req.url.size() >= 7 && req.url.compare(req.url.size() - 7, 7, "/stream") == 0);
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "crow.h"
+#include "../config/config.h"
+#include "../utils/alloc_stats.h"
+#include "../utils/rate_limiter.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// 클라이언트별 요청 속도 제한 (token bucket).
+// 클라이언트 IP 전체 한도와 IP+라우트 한도를 각각 확인하며, 넘으면 라우팅과 DB 작업 전에
+// 429 + Retry-After 로 거절한다. AdmissionMiddleware 앞에 두어 거절된 요청이 동시 처리 슬롯을 쓰지 않게 한다.
+struct RateLimitMiddleware
+{
+    struct context
+    {
+    };
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> trust_forwarded_for{false};
+    std::unique_ptr<RateLimiter> client_limiter;
+    std::unique_ptr<RateLimiter> route_limiter;
+    std::atomic<uint64_t> rejected{0};
+
+    // 첫 호출(서버 시작 전)에서 버킷 표를 만들고, 이후 호출(설정 재로드)은 한도만 바꾼다
+    void configure(const RateLimitConfig& config)
+    {
+        if (!client_limiter) {
+            client_limiter = std::make_unique<RateLimiter>(toSettings(config.client, config));
+            route_limiter = std::make_unique<RateLimiter>(toSettings(config.route, config));
+        } else {
+            client_limiter->setRate(config.client.rate_per_second, config.client.burst);
+            route_limiter->setRate(config.route.rate_per_second, config.route.burst);
+        }
+        trust_forwarded_for = config.trust_forwarded_for;
+        enabled = config.enabled;
+    }
+
+    void before_handle(crow::request& req, crow::response& res, context& /*ctx*/)
+    {
+        if (!enabled.load(std::memory_order_relaxed) || !client_limiter) {
+            return;
+        }
+
+        int64_t now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        uint64_t client_key = RateLimiter::hash(clientAddress(req));
+
+        RateLimiter::Decision decision = client_limiter->acquire(client_key, now_us);
+        if (decision.allowed) {
+            decision = route_limiter->acquire(routeHash(req, client_key), now_us);
+        }
+        if (decision.allowed) {
+            return;
+        }
+
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        res.code = 429;
+        res.set_header("Content-Type", "application/json");
+        res.set_header("Retry-After", std::to_string(std::max<int64_t>(1, (decision.retry_after_ms + 999) / 1000)));
+        res.write(crow::json::wvalue({
+            {"error", "Too many requests, please slow down"}
+        }).dump());
+        res.end();
+    }
+
+    void after_handle(crow::request& /*req*/, crow::response& /*res*/, context& /*ctx*/)
+    {
+    }
+
+private:
+    static RateLimiter::Settings toSettings(const TokenBucketConfig& bucket, const RateLimitConfig& config)
+    {
+        RateLimiter::Settings settings;
+        settings.rate_per_second = bucket.rate_per_second;
+        settings.burst = bucket.burst;
+        settings.capacity = static_cast<size_t>(config.max_keys);
+        settings.shards = static_cast<size_t>(config.shards);
+        return settings;
+    }
+
+    std::string_view clientAddress(const crow::request& req) const
+    {
+        if (trust_forwarded_for.load(std::memory_order_relaxed)) {
+            const std::string& forwarded = req.get_header_value("X-Forwarded-For");
+            if (!forwarded.empty()) {
+                // 첫 번째 주소가 원래 클라이언트
+                std::string_view first(forwarded);
+                first = first.substr(0, first.find(','));
+                while (!first.empty() && first.back() == ' ') {
+                    first.remove_suffix(1);
+                }
+                if (!first.empty()) {
+                    return first;
+                }
+            }
+        }
+        return req.remote_ip_address;
+    }
+
+    // 메서드 + 라우트 형태(가변 조각은 하나로 취급)의 해시를 클라이언트 키에 이어 붙인다.
+    // alloc_stats::routeKey() 와 같은 규칙이지만 문자열을 만들지 않는다
+    static uint64_t routeHash(const crow::request& req, uint64_t client_key)
+    {
+        char method = static_cast<char>(req.method);
+        uint64_t hash = RateLimiter::hash(std::string_view(&method, 1), client_key);
+        std::string_view path(req.url);
+        size_t depth = 0;
+        size_t start = 0;
+        while (start < path.size()) {
+            size_t end = path.find('/', start + 1);
+            if (end == std::string_view::npos) {
+                end = path.size();
+            }
+            std::string_view segment = path.substr(start + 1, end - start - 1);
+            if (!segment.empty()) {
+                hash = RateLimiter::hash("/", hash);
+                hash = RateLimiter::hash(depth == 0 || alloc_stats::isLiteralSegment(segment) ? segment : "{id}", hash);
+                depth++;
+            }
+            start = end;
+        }
+        return hash;
+    }
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <mysql/mysql.h>
+#include <charconv>
+#include <cstdlib>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "../utils/entity_fields.h"
+#include "../utils/request_context.h"
+
+// 필드 기술자로부터 생성하는 SQL 문장과 행 디코딩.
+// 문자열 값은 mysql_real_escape_string 으로 이스케이프해 바인딩한다.
+namespace entity_sql {
+
+// 요청 아레나에서 할당하는 문장 (요청 처리 중이 아니면 일반 힙)
+using Statement = std::pmr::string;
+
+namespace detail {
+
+inline Statement newStatement(std::string_view head, size_t reserve) {
+    Statement statement(request_context::arena());
+    statement.reserve(head.size() + reserve);
+    statement.append(head);
+    return statement;
+}
+
+inline void appendEscaped(Statement& out, MYSQL* conn, const std::string& value) {
+    size_t start = out.size();
+    out.resize(start + value.size() * 2 + 3);
+    out[start] = '\'';
+    unsigned long length = mysql_real_escape_string(conn, &out[start + 1], value.c_str(), value.size());
+    out.resize(start + 1 + length);
+    out.push_back('\'');
+}
+
+inline void appendValue(Statement& out, MYSQL* conn, const std::string& value) {
+    appendEscaped(out, conn, value);
+}
+
+inline void appendValue(Statement& out, MYSQL* /*conn*/, int32_t value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+// "<key column> = '<id>'"
+template<typename Entity>
+void appendKeyCondition(Statement& out, MYSQL* conn, const std::string& id) {
+    out += std::get<0>(Entity::fields).column;
+    out += " = ";
+    appendEscaped(out, conn, id);
+}
+
+inline void decodeValue(const char* cell, std::string& value) {
+    value = cell != nullptr ? cell : "";
+}
+
+inline void decodeValue(const char* cell, int32_t& value) {
+    value = cell != nullptr ? static_cast<int32_t>(std::strtol(cell, nullptr, 10)) : 0;
+}
+
+} // namespace detail
+
+// "id, name, gender" (필드 선언 순서)
+template<typename Entity>
+const std::string& columnList() {
+    static const std::string columns = [] {
+        std::string list;
+        entity::forEachField<Entity>([&](const auto& field, size_t index) {
+            list += (index > 0 ? ", " : "");
+            list += field.column;
+        });
+        return list;
+    }();
+    return columns;
+}
+
+// "SELECT <columns> FROM <table>"
+template<typename Entity>
+const std::string& selectAll() {
+    static const std::string statement = "SELECT " + columnList<Entity>() + " FROM " + std::string(Entity::table);
+    return statement;
+}
+
+// "SELECT <columns> FROM <table> WHERE <key> = '<id>'"
+template<typename Entity>
+Statement selectById(MYSQL* conn, const std::string& id) {
+    Statement statement = detail::newStatement(selectAll<Entity>(), id.size() * 2 + 48);
+    statement += " WHERE ";
+    detail::appendKeyCondition<Entity>(statement, conn, id);
+    return statement;
+}
+
+// "SELECT <key> = '<id>', ..., <columns> FROM <table> WHERE <key> IN ('<id>', ...)" (묶음 단건 조회)
+// 앞의 ids.size() 개 열은 그 행이 각 요청 키와 같은지(테이블 collation 기준, 1/0)를 알려준다.
+// 반환된 id 는 요청한 키와 대소문자가 다를 수 있으므로 호출자는 이 열로 행을 요청 키에 연결한다.
+template<typename Entity>
+Statement selectByIds(MYSQL* conn, const std::vector<std::string>& ids) {
+    std::string_view key = std::get<0>(Entity::fields).column;
+    size_t reserve = 64 + columnList<Entity>().size();
+    for (const std::string& id : ids) {
+        reserve += id.size() * 4 + 32;  // 일치 열과 IN 목록에 한 번씩 (이스케이프 여유 포함)
+    }
+    Statement statement = detail::newStatement("SELECT ", reserve);
+    for (const std::string& id : ids) {
+        detail::appendKeyCondition<Entity>(statement, conn, id);
+        statement += ", ";
+    }
+    statement += columnList<Entity>();
+    statement += " FROM ";
+    statement += Entity::table;
+    statement += " WHERE ";
+    statement += key;
+    statement += " IN (";
+    for (size_t i = 0; i < ids.size(); ++i) {
+        statement += (i > 0 ? ", " : "");
+        detail::appendEscaped(statement, conn, ids[i]);
+    }
+    statement += ")";
+    return statement;
+}
+
+// "SELECT COUNT(*), UNIX_TIMESTAMP(MAX(<updated>)) FROM <table>" (캐시 스냅샷 워터마크)
+template<typename Entity>
+const std::string& watermarkStatement() {
+    static const std::string statement = "SELECT COUNT(*), COALESCE(UNIX_TIMESTAMP(MAX(" +
+        std::string(Entity::updated_column) + ")), 0) FROM " + std::string(Entity::table);
+    return statement;
+}
+
+// "SELECT <columns> FROM <table> WHERE <updated> >= FROM_UNIXTIME(<since>)"
+template<typename Entity>
+Statement selectUpdatedSince(int64_t since) {
+    Statement statement = detail::newStatement(selectAll<Entity>(), 80);
+    statement += " WHERE ";
+    statement += Entity::updated_column;
+    statement += " >= FROM_UNIXTIME(";
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), since);
+    statement.append(digits, result.ptr);
+    statement += ")";
+    return statement;
+}
+
+// "INSERT INTO <table> (<columns>) VALUES (...)"
+template<typename Entity>
+Statement insertStatement(MYSQL* conn, const typename Entity::Row& row) {
+    Statement statement = detail::newStatement("INSERT INTO ", 256);
+    statement += Entity::table;
+    statement += " (";
+    statement += columnList<Entity>();
+    statement += ") VALUES (";
+    entity::forEachField<Entity>([&](const auto& field, size_t index) {
+        statement += (index > 0 ? ", " : "");
+        detail::appendValue(statement, conn, row.*(field.member));
+    });
+    statement += ")";
+    return statement;
+}
+
+// "UPDATE <table> SET <column> = ..., ... WHERE <key> = '<id>'" (키 외 필드)
+template<typename Entity>
+Statement updateStatement(MYSQL* conn, const typename Entity::Row& row) {
+    Statement statement = detail::newStatement("UPDATE ", 256);
+    statement += Entity::table;
+    statement += " SET ";
+    entity::forEachField<Entity>([&](const auto& field, size_t index) {
+        if (index == 0) {
+            return;
+        }
+        statement += (index > 1 ? ", " : "");
+        statement += field.column;
+        statement += " = ";
+        detail::appendValue(statement, conn, row.*(field.member));
+    });
+    statement += " WHERE ";
+    detail::appendKeyCondition<Entity>(statement, conn, row.*(std::get<0>(Entity::fields).member));
+    return statement;
+}
+
+// "DELETE FROM <table> WHERE <key> = '<id>'"
+template<typename Entity>
+Statement deleteStatement(MYSQL* conn, const std::string& id) {
+    Statement statement = detail::newStatement("DELETE FROM ", id.size() * 2 + 48);
+    statement += Entity::table;
+    statement += " WHERE ";
+    detail::appendKeyCondition<Entity>(statement, conn, id);
+    return statement;
+}
+
+// columnList 순서로 조회한 결과 행을 Row 로 디코딩
+template<typename Entity>
+void decodeRow(MYSQL_ROW cells, typename Entity::Row& row) {
+    entity::forEachField<Entity>([&](const auto& field, size_t index) {
+        detail::decodeValue(cells[index], row.*(field.member));
+    });
+}
+
+} // namespace entity_sql
@@ -0,0 +1,281 @@
+#include "local_infile.h"
+#include "crow.h"
+#include <mysql/errmsg.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// LOAD DATA 기본 형식(탭 구분, 백슬래시 이스케이프)의 필드로 추가
+void appendTsvField(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\0': out += "\\0"; break;
+            default: out.push_back(c);
+        }
+    }
+}
+
+} // namespace
+
+LocalInfileSource::LocalInfileSource(std::string_view body, export_format::Format format, std::vector<Column> columns,
+                                     RowCheck check)
+    : body(body), format(format), columns(std::move(columns)), check(std::move(check)), values(this->columns.size()) {
+}
+
+bool LocalInfileSource::prepare(std::string& error) {
+    if (format != export_format::Format::Csv) {
+        return true;
+    }
+
+    std::string_view header = nextCsvRecord();
+    if (header.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        header.remove_prefix(3);
+    }
+    if (header.empty() || !parseCsv(header)) {
+        error = "CSV header is missing or malformed";
+        return false;
+    }
+
+    // 헤더 이름으로 컬럼 순서를 정한다 (모든 필드가 정확히 한 번씩)
+    csv_order.clear();
+    std::vector<bool> seen(columns.size(), false);
+    for (const std::string& name : fields) {
+        auto it = std::find_if(columns.begin(), columns.end(), [&](const Column& column) {
+            return column.name == name;
+        });
+        if (it == columns.end()) {
+            error = "Unknown CSV column: " + name;
+            return false;
+        }
+        size_t index = static_cast<size_t>(it - columns.begin());
+        if (seen[index]) {
+            error = "Duplicate CSV column: " + name;
+            return false;
+        }
+        seen[index] = true;
+        csv_order.push_back(index);
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (!seen[i]) {
+            error = "Missing CSV column: " + columns[i].name;
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string LocalInfileSource::statement(const std::string& table, bool replace) const {
+    // 파일 이름은 핸들러가 무시하므로 아무 값이나 사용
+    std::string sql = "LOAD DATA LOCAL INFILE 'request-body' ";
+    sql += replace ? "REPLACE" : "IGNORE";
+    sql += " INTO TABLE " + table + " CHARACTER SET utf8mb4 (";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        sql += (i > 0 ? ", " : "") + columns[i].column;
+    }
+    sql += ")";
+    return sql;
+}
+
+void LocalInfileSource::install(MYSQL* conn) {
+    mysql_set_local_infile_handler(conn, &LocalInfileSource::initCallback, &LocalInfileSource::readCallback,
+                                   &LocalInfileSource::endCallback, &LocalInfileSource::errorCallback, this);
+}
+
+void LocalInfileSource::uninstall(MYSQL* conn) {
+    mysql_set_local_infile_default(conn);
+}
+
+int LocalInfileSource::read(char* buffer, unsigned int length) {
+    // 버퍼를 채울 만큼만 줄을 변환해서 넘긴다
+    size_t written = 0;
+    while (written < length) {
+        if (pending_offset == pending.size()) {
+            pending.clear();
+            pending_offset = 0;
+            if (!convertNextLine()) {
+                break;
+            }
+            continue;
+        }
+        size_t count = std::min<size_t>(length - written, pending.size() - pending_offset);
+        std::memcpy(buffer + written, pending.data() + pending_offset, count);
+        pending_offset += count;
+        written += count;
+    }
+    return static_cast<int>(written);
+}
+
+bool LocalInfileSource::convertNextLine() {
+    while (offset < body.size()) {
+        bool parsed;
+        if (format == export_format::Format::Csv) {
+            std::string_view record = nextCsvRecord();
+            if (record.empty()) {
+                continue;
+            }
+            parsed = parseCsv(record);
+        } else {
+            size_t end = body.find('\n', offset);
+            if (end == std::string_view::npos) {
+                end = body.size();
+            }
+            std::string_view line = body.substr(offset, end - offset);
+            offset = end + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            parsed = parseNdjson(line);
+        }
+
+        // API 와 같은 필드 검증을 통과하지 못한 줄은 적재하지 않는다
+        if (!parsed || !check(values)) {
+            rejected_lines++;
+            continue;
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) {
+                pending.push_back('\t');
+            }
+            appendTsvField(pending, values[i]);
+        }
+        pending.push_back('\n');
+        return true;
+    }
+    return false;
+}
+
+bool LocalInfileSource::parseNdjson(std::string_view line) {
+    auto json = crow::json::load(line.data(), line.size());
+    if (!json || json.t() != crow::json::type::Object) {
+        return false;
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const Column& column = columns[i];
+        if (!json.has(column.name)) {
+            return false;
+        }
+        auto value = json[column.name];
+        if (column.integer) {
+            if (value.t() != crow::json::type::Number) {
+                return false;
+            }
+            values[i] = crow::json::wvalue(value).dump();
+        } else {
+            if (value.t() != crow::json::type::String) {
+                return false;
+            }
+            values[i] = value.s();
+        }
+    }
+    return true;
+}
+
+bool LocalInfileSource::parseCsv(std::string_view record) {
+    // RFC 4180: " 로 감싼 필드 안의 "" 는 ", 구분자와 개행은 값의 일부
+    fields.clear();
+    size_t i = 0;
+    while (true) {
+        std::string field;
+        if (i < record.size() && record[i] == '"') {
+            ++i;
+            while (true) {
+                if (i >= record.size()) {
+                    return false;
+                }
+                char c = record[i++];
+                if (c != '"') {
+                    field.push_back(c);
+                } else if (i < record.size() && record[i] == '"') {
+                    field.push_back('"');
+                    ++i;
+                } else {
+                    break;
+                }
+            }
+            if (i < record.size() && record[i] != ',') {
+                return false;
+            }
+        } else {
+            size_t end = std::min(record.find(',', i), record.size());
+            field.assign(record.substr(i, end - i));
+            if (field.find('"') != std::string::npos) {
+                return false;
+            }
+            i = end;
+        }
+        fields.push_back(std::move(field));
+        if (i >= record.size()) {
+            break;
+        }
+        ++i;
+    }
+
+    if (csv_order.empty()) {
+        return true;    // 헤더
+    }
+    if (fields.size() != csv_order.size()) {
+        return false;
+    }
+    for (size_t k = 0; k < fields.size(); ++k) {
+        values[csv_order[k]] = std::move(fields[k]);
+    }
+    return true;
+}
+
+std::string_view LocalInfileSource::nextCsvRecord() {
+    // 따옴표로 감싼 필드 밖의 개행에서 끝난다 (필드 중간의 " 는 감싸기로 보지 않는다)
+    size_t start = offset;
+    bool quoted = false;
+    bool field_start = true;
+    size_t end = offset;
+    while (end < body.size() && (quoted || body[end] != '\n')) {
+        char c = body[end];
+        if (quoted) {
+            if (c == '"') {
+                if (end + 1 < body.size() && body[end + 1] == '"') {
+                    ++end;
+                } else {
+                    quoted = false;
+                }
+            }
+        } else if (c == '"' && field_start) {
+            quoted = true;
+        }
+        field_start = !quoted && c == ',';
+        ++end;
+    }
+    offset = std::min(end + 1, body.size());
+    std::string_view record = body.substr(start, end - start);
+    if (!record.empty() && record.back() == '\r') {
+        record.remove_suffix(1);
+    }
+    return record;
+}
+
+int LocalInfileSource::initCallback(void** ptr, const char* /*filename*/, void* userdata) {
+    *ptr = userdata;
+    return 0;
+}
+
+int LocalInfileSource::readCallback(void* ptr, char* buffer, unsigned int length) {
+    return static_cast<LocalInfileSource*>(ptr)->read(buffer, length);
+}
+
+void LocalInfileSource::endCallback(void* /*ptr*/) {
+}
+
+int LocalInfileSource::errorCallback(void* /*ptr*/, char* message, unsigned int length) {
+    std::strncpy(message, "Failed to read request body", length);
+    if (length > 0) {
+        message[length - 1] = '\0';
+    }
+    return CR_UNKNOWN_ERROR;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <mysql/mysql.h>
+#include <charconv>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../utils/entity_fields.h"
+#include "../utils/export_format.h"
+
+// 대량 적재 결과
+struct ImportResult {
+    bool success = false;
+    bool disabled = false;          // database.allow_local_infile 가 꺼져 있음
+    long long rows = 0;             // 적재(또는 교체)된 행 수
+    size_t rejected_lines = 0;      // 파싱이나 필드 검증에 실패해 건너뛴 줄 수
+    unsigned int warnings = 0;      // LOAD DATA 경고 수 (IGNORE 로 건너뛴 중복 키 등)
+    std::string error;
+};
+
+// LOAD DATA LOCAL INFILE 의 입력 소스.
+// 클라이언트 라이브러리가 파일 대신 이 객체에서 데이터를 읽도록 local-infile 핸들러를 설치하며,
+// 요청 본문을 쌓아두지 않고 버퍼를 채울 만큼씩 한 줄씩 파싱해 탭 구분(LOAD DATA 기본 형식)으로 넘긴다.
+// CSV 는 헤더 이름으로 컬럼을 대응시키고, 줄마다 필드 검증(check)을 통과한 행만 넘긴다.
+class LocalInfileSource {
+public:
+    struct Column {
+        std::string name;           // CSV 헤더 / NDJSON 키
+        std::string column;         // SQL 컬럼
+        bool integer = false;       // NDJSON 에서 숫자로 받는 필드
+    };
+
+    // columns 순서의 값으로 행 검증
+    using RowCheck = std::function<bool(const std::vector<std::string>& values)>;
+
+private:
+    std::string_view body;
+    export_format::Format format;
+    std::vector<Column> columns;
+    RowCheck check;
+    std::vector<size_t> csv_order;  // CSV 헤더 위치별 columns 인덱스
+    size_t offset = 0;
+    std::string pending;        // 변환 결과 중 아직 넘기지 않은 부분
+    size_t pending_offset = 0;
+    std::vector<std::string> values;
+    std::vector<std::string> fields;
+    size_t rejected_lines = 0;
+
+public:
+    // body 는 LOAD DATA 실행이 끝날 때까지 유효해야 한다
+    LocalInfileSource(std::string_view body, export_format::Format format, std::vector<Column> columns, RowCheck check);
+
+    // 엔티티 필드 기술자로 컬럼과 검증을 구성
+    template<typename Entity>
+    static LocalInfileSource forEntity(std::string_view body, export_format::Format format);
+
+    // CSV 헤더 확인 (실행 전 호출). 엔티티 필드가 정확히 한 번씩 있어야 하며, 아니면 error 를 채우고 false
+    bool prepare(std::string& error);
+
+    // conn 에서 실행할 LOAD DATA 문장 (table 의 columns 에 적재)
+    std::string statement(const std::string& table, bool replace) const;
+
+    // conn 의 local-infile 핸들러를 이 소스로 교체 / 기본값으로 복원
+    void install(MYSQL* conn);
+    static void uninstall(MYSQL* conn);
+
+    // 파싱이나 검증에 실패해 건너뛴 줄 수
+    size_t rejectedLines() const { return rejected_lines; }
+
+private:
+    int read(char* buffer, unsigned int length);
+    bool convertNextLine();
+    bool parseNdjson(std::string_view line);
+    bool parseCsv(std::string_view record);
+    std::string_view nextCsvRecord();
+
+    static int initCallback(void** ptr, const char* filename, void* userdata);
+    static int readCallback(void* ptr, char* buffer, unsigned int length);
+    static void endCallback(void* ptr);
+    static int errorCallback(void* ptr, char* message, unsigned int length);
+};
+
+namespace local_infile_detail {
+
+inline bool assignValue(std::string& member, const std::string& value) {
+    member = value;
+    return true;
+}
+
+inline bool assignValue(int32_t& member, const std::string& value) {
+    auto result = std::from_chars(value.data(), value.data() + value.size(), member);
+    return result.ec == std::errc() && result.ptr == value.data() + value.size();
+}
+
+} // namespace local_infile_detail
+
+template<typename Entity>
+LocalInfileSource LocalInfileSource::forEntity(std::string_view body, export_format::Format format) {
+    std::vector<Column> columns;
+    entity::forEachField<Entity>([&](const auto& field, size_t) {
+        columns.push_back(Column{std::string(field.name), std::string(field.column), field.kind == entity::FieldKind::Int});
+    });
+    return LocalInfileSource(body, format, std::move(columns), [](const std::vector<std::string>& values) {
+        typename Entity::Row row;
+        bool parsed = entity::allFields<Entity>([&](const auto& field, size_t index) {
+            return local_infile_detail::assignValue(row.*(field.member), values[index]);
+        });
+        return parsed && static_cast<bool>(entity::checkRow<Entity>(row));
+    });
+}
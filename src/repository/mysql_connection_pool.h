@@ -1,27 +1,68 @@
 #pragma once
 
 #include <mysql/mysql.h>
+#include <mysql/errmsg.h>
 #include <mutex>
 #include <queue>
 #include <memory>
+#include <vector>
 #include <condition_variable>
 #include <thread>
 #include <chrono>
+#include <atomic>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
 #include "../config/config.h"
+#include "../utils/request_context.h"
+#include "../utils/cpu_affinity.h"
+#include "../utils/circuit_breaker.h"
+
+// DB 에 연결할 수 없거나 circuit breaker 가 열려 있어 요청을 처리할 수 없음 (503 으로 응답)
+class DatabaseUnavailableError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
 
 class MySQLConnectionPool {
 private:
-    std::queue<MYSQL*> available_connections;
-    std::mutex pool_mutex;
-    std::condition_variable pool_condition;
+    // 샤드별로 독립된 연결 큐와 잠금을 둔다 (per-core 모드에서 코어 간 경합 제거)
+    struct Shard {
+        std::queue<MYSQL*> available_connections;
+        std::mutex pool_mutex;
+        std::condition_variable pool_condition;
+        size_t max_connections = 0;
+        size_t current_connections = 0;
+        std::unordered_map<MYSQL*, uint64_t> generations;  // 연결이 생성된 설정 세대
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    // 다중 문장(CLIENT_MULTI_STATEMENTS)으로 연 StatementPipeline 전용 연결. 일반 요청에는 빌려주지 않는다
+    std::unique_ptr<Shard> pipelineShard = std::make_unique<Shard>();
     DatabaseConfig dbConfig;
-    size_t max_connections;
-    size_t current_connections;
+    std::mutex config_mutex;                // dbConfig 의 런타임 변경 보호
+    std::atomic<size_t> max_connections;
+    std::atomic<uint64_t> generation{0};    // 타임아웃 변경 시 증가, 이전 세대 연결은 반환 시 폐기
+    std::atomic<int64_t> wait_ewma_us{0};   // 연결 대기시간 이동평균 (마이크로초)
+    std::atomic<int> waiting_threads{0};    // 연결을 기다리는 스레드 수
+    CircuitBreaker breaker;                 // DB 장애 시 연결 시도 없이 즉시 실패
+
+    // wrapConnection 등에서 pipelineShard 를 가리키는 인덱스
+    static constexpr size_t kPipelineShard = ~size_t(0);
+
+    // 연결을 기다리는 동안 circuit 상태를 확인하는 간격
+    static constexpr std::chrono::milliseconds kBreakerCheckInterval{100};
 
 public:
-    MySQLConnectionPool(const DatabaseConfig& config, size_t max_conn = 10) 
-        : dbConfig(config), max_connections(max_conn), current_connections(0) {
+    MySQLConnectionPool(const DatabaseConfig& config, size_t max_conn = 10, size_t shard_count = 1)
+        : dbConfig(config), max_connections(max_conn) {
+        // 샤드마다 최소 1개의 연결은 가질 수 있어야 한다
+        size_t count = std::max<size_t>(1, std::min(shard_count, max_conn));
+        for (size_t i = 0; i < count; ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+        distributeCapacity(max_conn);
+        pipelineShard->max_connections = static_cast<size_t>(std::max(1, config.pipeline_pool_size));
     }
 
     // 데이터베이스 연결 테스트 및 초기화
@@ -49,49 +90,326 @@ public:
     }
 
     ~MySQLConnectionPool() {
-        std::lock_guard<std::mutex> lock(pool_mutex);
-        while (!available_connections.empty()) {
-            MYSQL* conn = available_connections.front();
-            available_connections.pop();
-            mysql_close(conn);
+        for (Shard* shard : allShards()) {
+            std::lock_guard<std::mutex> lock(shard->pool_mutex);
+            while (!shard->available_connections.empty()) {
+                MYSQL* conn = shard->available_connections.front();
+                shard->available_connections.pop();
+                mysql_close(conn);
+            }
         }
     }
 
+    // 연결 획득. circuit 이 열려 있거나 새 연결을 만들 수 없으면 DatabaseUnavailableError
     std::shared_ptr<MYSQL> getConnection() {
-        std::unique_lock<std::mutex> lock(pool_mutex);
+        StageTimer timer(Stage::PoolAcquire);
+        
+        // DB 장애 중에는 연결 타임아웃을 기다리지 않고 바로 실패
+        if (!breaker.allow()) {
+            throw DatabaseUnavailableError("Database unavailable (circuit open)");
+        }
+        
+        size_t index = cpu_affinity::currentShard() % shards.size();
+        Shard& shard = *shards[index];
+        std::unique_lock<std::mutex> lock(shard.pool_mutex);
         
         // 사용 가능한 연결이 있으면 반환
-        if (!available_connections.empty()) {
-            MYSQL* conn = available_connections.front();
-            available_connections.pop();
-            return std::shared_ptr<MYSQL>(conn, [this](MYSQL* conn) {
-                returnConnection(conn);
-            });
+        if (!shard.available_connections.empty()) {
+            recordWait(0);
+            return takeConnection(shard, index);
         }
         
         // 새 연결 생성 가능하면 생성
-        if (current_connections < max_connections) {
-            MYSQL* conn = createConnection();
-            if (conn) {
-                current_connections++;
-                return std::shared_ptr<MYSQL>(conn, [this](MYSQL* conn) {
-                    returnConnection(conn);
-                });
+        if (shard.current_connections < shard.max_connections) {
+            recordWait(0);
+            return connectNew(shard, index, lock);
+        }
+        
+        // 다른 샤드의 유휴 연결 빌려오기
+        if (shards.size() > 1) {
+            lock.unlock();
+            if (auto borrowed = tryTakeIdle(index)) {
+                recordWait(0);
+                return borrowed;
             }
+            lock.lock();
         }
         
-        // 연결이 없으면 대기
-        pool_condition.wait(lock, [this] { return !available_connections.empty(); });
+        return waitForConnection(shard, index, lock);
+    }
+
+    // 다중 문장이 켜진 연결 획득 (StatementPipeline 전용). 연결을 열 때 한 번 켜므로 실행마다 옵션을 바꾸는 왕복이 없다
+    std::shared_ptr<MYSQL> getPipelineConnection() {
+        StageTimer timer(Stage::PoolAcquire);
         
-        MYSQL* conn = available_connections.front();
-        available_connections.pop();
-        return std::shared_ptr<MYSQL>(conn, [this](MYSQL* conn) {
-            returnConnection(conn);
-        });
+        if (!breaker.allow()) {
+            throw DatabaseUnavailableError("Database unavailable (circuit open)");
+        }
+        
+        Shard& shard = *pipelineShard;
+        std::unique_lock<std::mutex> lock(shard.pool_mutex);
+        if (!shard.available_connections.empty()) {
+            recordWait(0);
+            return takeConnection(shard, kPipelineShard);
+        }
+        if (shard.current_connections < shard.max_connections) {
+            recordWait(0);
+            return connectNew(shard, kPipelineShard, lock);
+        }
+        return waitForConnection(shard, kPipelineShard, lock);
+    }
+
+    // 대기 없이 연결 획득 시도 (사용 가능한 연결이 없거나 circuit 이 열려 있으면 nullptr)
+    std::shared_ptr<MYSQL> tryGetConnection() {
+        if (!breaker.allow()) {
+            return nullptr;
+        }
+        if (auto idle = tryTakeIdle(shards.size())) {
+            return idle;
+        }
+        
+        for (size_t index = 0; index < shards.size(); ++index) {
+            Shard& shard = *shards[index];
+            std::unique_lock<std::mutex> lock(shard.pool_mutex);
+            if (shard.current_connections < shard.max_connections) {
+                try {
+                    return connectNew(shard, index, lock);
+                } catch (const DatabaseUnavailableError&) {
+                    return nullptr;
+                }
+            }
+        }
+        
+        return nullptr;
+    }
+
+    // 쿼리 결과를 circuit breaker 에 반영.
+    // 서버와의 연결이 끊기거나 읽기/쓰기 타임아웃이면 실패로 세고 DatabaseUnavailableError
+    void recordQueryResult(MYSQL* conn, int status) {
+        if (status == 0) {
+            breaker.recordSuccess();
+            return;
+        }
+        if (isConnectionLost(mysql_errno(conn))) {
+            recordFailure();
+            throw DatabaseUnavailableError(std::string("Database unavailable: ") + mysql_error(conn));
+        }
+    }
+
+    // circuit 이 열려 있고 재시도 시점이 되었으면 새 연결로 DB 상태 확인 (백그라운드 주기 작업에서 호출)
+    void probe() {
+        if (!breaker.beginProbe()) {
+            return;
+        }
+        MYSQL* conn = createConnection();
+        bool healthy = conn != nullptr && mysql_ping(conn) == 0;
+        if (conn != nullptr) {
+            mysql_close(conn);
+        }
+        breaker.endProbe(healthy);
+        if (healthy) {
+            // 장애 이전의 유휴 연결은 끊겼을 수 있으므로 새 연결로 교체
+            ++generation;
+            retireIdleConnections();
+            std::cout << "Database reachable again, circuit closed" << std::endl;
+        }
+    }
+
+    CircuitBreaker& circuitBreaker() { return breaker; }
+
+    // 최근 연결 대기시간 이동평균 (마이크로초)
+    int64_t averageWaitMicros() const { return wait_ewma_us.load(); }
+
+    // 현재 연결을 기다리는 스레드 수
+    int waitingThreads() const { return waiting_threads.load(); }
+
+    size_t shardCount() const { return shards.size(); }
+    
+    size_t maxConnections() const { return max_connections.load(); }
+
+    // 현재 열려 있는 연결 수 (사용 중 + 유휴, 파이프라인 전용 포함)
+    size_t openConnections() {
+        size_t total = 0;
+        for (Shard* shard : allShards()) {
+            std::lock_guard<std::mutex> lock(shard->pool_mutex);
+            total += shard->current_connections;
+        }
+        return total;
+    }
+    
+    bool localInfileAllowed() const { return dbConfig.allow_local_infile; }
+    
+    // 최대 연결 수 변경. 사용 중인 연결은 끊지 않고, 반환될 때 한도를 넘으면 닫는다.
+    void resize(size_t new_max) {
+        new_max = std::max(new_max, shards.size());
+        distributeCapacity(new_max);
+        max_connections = new_max;
+        
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard->pool_mutex);
+            while (shard->current_connections > shard->max_connections && !shard->available_connections.empty()) {
+                MYSQL* conn = shard->available_connections.front();
+                shard->available_connections.pop();
+                closeConnection(*shard, conn);
+            }
+            // 한도가 늘었으면 대기 중인 스레드가 새 연결을 만들 수 있도록 깨운다
+            shard->pool_condition.notify_all();
+        }
+    }
+    
+    // 타임아웃 변경. 새 설정은 새로 만드는 연결부터 적용되며,
+    // 기존 연결은 유휴 상태면 바로, 사용 중이면 반환될 때 닫혀 새 설정으로 교체된다.
+    void setTimeouts(int connection_timeout) {
+        {
+            std::lock_guard<std::mutex> lock(config_mutex);
+            dbConfig.connection_timeout = connection_timeout;
+        }
+        ++generation;
+        retireIdleConnections();
     }
 
 private:
-    MYSQL* createConnection() {
+    // 일반 샤드와 파이프라인 전용 샤드
+    std::vector<Shard*> allShards() {
+        std::vector<Shard*> all;
+        for (auto& shard : shards) {
+            all.push_back(shard.get());
+        }
+        all.push_back(pipelineShard.get());
+        return all;
+    }
+
+    Shard& shardAt(size_t index) {
+        return index == kPipelineShard ? *pipelineShard : *shards[index];
+    }
+
+    // shard.pool_mutex 를 잡은 상태에서 호출
+    std::shared_ptr<MYSQL> takeConnection(Shard& shard, size_t index) {
+        MYSQL* conn = shard.available_connections.front();
+        shard.available_connections.pop();
+        return wrapConnection(conn, index);
+    }
+
+    // 연결은 빌려준 샤드가 아닌 원래 샤드로 반환된다
+    std::shared_ptr<MYSQL> wrapConnection(MYSQL* conn, size_t index) {
+        return std::shared_ptr<MYSQL>(conn, [this, index](MYSQL* conn) {
+            returnConnection(conn, index);
+        });
+    }
+
+    // shard.pool_mutex 를 잡은 상태(lock)에서 호출. 연결이 없으면 대기하며, 대기 중 circuit 이 열리면 더 기다리지 않고 실패한다
+    std::shared_ptr<MYSQL> waitForConnection(Shard& shard, size_t index, std::unique_lock<std::mutex>& lock) {
+        auto wait_start = std::chrono::high_resolution_clock::now();
+        auto waited = [&wait_start] {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - wait_start).count();
+        };
+        waiting_threads++;
+        while (shard.available_connections.empty()) {
+            // 풀 크기 변경이나 연결 종료로 새 연결을 만들 여유가 생김
+            if (shard.current_connections < shard.max_connections) {
+                waiting_threads--;
+                recordWait(waited());
+                return connectNew(shard, index, lock);
+            }
+            shard.pool_condition.wait_for(lock, kBreakerCheckInterval);
+            if (!breaker.allow()) {
+                waiting_threads--;
+                throw DatabaseUnavailableError("Database unavailable (circuit open)");
+            }
+        }
+        waiting_threads--;
+        recordWait(waited());
+        
+        return takeConnection(shard, index);
+    }
+
+    // 유휴 연결이 있는 샤드에서 하나 가져오기 (skip 샤드 제외, 잠금 경합 시 건너뜀)
+    std::shared_ptr<MYSQL> tryTakeIdle(size_t skip) {
+        for (size_t index = 0; index < shards.size(); ++index) {
+            if (index == skip) {
+                continue;
+            }
+            Shard& shard = *shards[index];
+            std::unique_lock<std::mutex> lock(shard.pool_mutex, std::try_to_lock);
+            if (lock.owns_lock() && !shard.available_connections.empty()) {
+                return takeConnection(shard, index);
+            }
+        }
+        return nullptr;
+    }
+
+    // 전체 최대 연결 수를 샤드에 나눠 배정
+    void distributeCapacity(size_t total) {
+        size_t count = shards.size();
+        for (size_t i = 0; i < count; ++i) {
+            std::lock_guard<std::mutex> lock(shards[i]->pool_mutex);
+            shards[i]->max_connections = total / count + (i < total % count ? 1 : 0);
+        }
+    }
+
+    // shard.pool_mutex 를 잡은 상태(lock)에서 호출. 슬롯을 예약하고 잠금 밖에서 연결해
+    // 연결 타임아웃 동안 같은 샤드의 다른 스레드를 막지 않는다. 실패하면 슬롯을 돌려주고 DatabaseUnavailableError
+    std::shared_ptr<MYSQL> connectNew(Shard& shard, size_t index, std::unique_lock<std::mutex>& lock) {
+        shard.current_connections++;
+        uint64_t conn_generation = generation.load();
+        lock.unlock();
+        MYSQL* conn = createConnection(index == kPipelineShard);
+        lock.lock();
+        if (conn == nullptr) {
+            shard.current_connections--;
+            shard.pool_condition.notify_one();
+            lock.unlock();
+            recordFailure();
+            throw DatabaseUnavailableError("Database unavailable (connect failed)");
+        }
+        shard.generations[conn] = conn_generation;
+        return wrapConnection(conn, index);
+    }
+
+    // 현재 세대가 아닌 유휴 연결 닫기 (사용 중인 연결은 반환될 때 닫힌다)
+    void retireIdleConnections() {
+        uint64_t current_generation = generation.load();
+        for (Shard* shard : allShards()) {
+            std::lock_guard<std::mutex> lock(shard->pool_mutex);
+            std::queue<MYSQL*> kept;
+            while (!shard->available_connections.empty()) {
+                MYSQL* conn = shard->available_connections.front();
+                shard->available_connections.pop();
+                if (shard->generations[conn] == current_generation) {
+                    kept.push(conn);
+                } else {
+                    closeConnection(*shard, conn);
+                }
+            }
+            shard->available_connections.swap(kept);
+            shard->pool_condition.notify_all();
+        }
+    }
+
+    void recordFailure() {
+        if (breaker.recordFailure()) {
+            std::cerr << "Database circuit opened: failing fast until the background probe succeeds" << std::endl;
+        }
+    }
+
+    static bool isConnectionLost(unsigned int error) {
+        return error == CR_SERVER_GONE_ERROR || error == CR_SERVER_LOST ||
+               error == CR_CONNECTION_ERROR || error == CR_CONN_HOST_ERROR;
+    }
+
+    // shard.pool_mutex 를 잡은 상태에서 호출
+    void closeConnection(Shard& shard, MYSQL* conn) {
+        shard.generations.erase(conn);
+        shard.current_connections--;
+        mysql_close(conn);
+    }
+
+    void recordWait(int64_t wait_us) {
+        wait_ewma_us = (wait_ewma_us.load() * 9 + wait_us) / 10;
+    }
+
+    MYSQL* createConnection(bool multi_statements = false) {
         MYSQL* mysql = mysql_init(NULL);
         if (mysql == NULL) {
             std::cerr << "Error initializing MySQL" << std::endl;
@@ -99,14 +417,32 @@ private:
         }
         
         // 연결 타임아웃 설정
-        unsigned int timeout = dbConfig.connection_timeout;
+        unsigned int timeout;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex);
+            timeout = dbConfig.connection_timeout;
+        }
         mysql_options(mysql, MYSQL_OPT_CONNECT_TIMEOUT, &timeout);
         mysql_options(mysql, MYSQL_OPT_READ_TIMEOUT, &timeout);
         mysql_options(mysql, MYSQL_OPT_WRITE_TIMEOUT, &timeout);
         
-        if (mysql_real_connect(mysql, dbConfig.host.c_str(), dbConfig.username.c_str(), 
-                              dbConfig.password.c_str(), dbConfig.database.c_str(), 
-                              dbConfig.port, NULL, 0) == NULL) {
+        // UPDATE 가 바뀐 행 대신 일치한 행 수를 반환하도록 설정.
+        // 다중 문장은 파이프라인 전용 연결에만 켠다
+        unsigned long client_flags = CLIENT_FOUND_ROWS;
+        if (multi_statements) {
+            client_flags |= CLIENT_MULTI_STATEMENTS;
+        }
+        
+        // 대량 적재용 LOAD DATA LOCAL INFILE (리포지토리가 요청마다 전용 핸들러를 설치한다)
+        if (dbConfig.allow_local_infile) {
+            unsigned int local_infile = 1;
+            mysql_options(mysql, MYSQL_OPT_LOCAL_INFILE, &local_infile);
+            client_flags |= CLIENT_LOCAL_FILES;
+        }
+        
+        if (mysql_real_connect(mysql, dbConfig.host.c_str(), dbConfig.username.c_str(),
+                              dbConfig.password.c_str(), dbConfig.database.c_str(),
+                              dbConfig.port, NULL, client_flags) == NULL) {
             std::cerr << "Error connecting to MySQL: " << mysql_error(mysql) << std::endl;
             mysql_close(mysql);
             return nullptr;
@@ -115,9 +451,19 @@ private:
         return mysql;
     }
 
-    void returnConnection(MYSQL* conn) {
-        std::lock_guard<std::mutex> lock(pool_mutex);
-        available_connections.push(conn);
-        pool_condition.notify_one();
+    void returnConnection(MYSQL* conn, size_t index) {
+        Shard& shard = shardAt(index);
+        std::lock_guard<std::mutex> lock(shard.pool_mutex);
+        
+        // 풀이 줄었거나 설정이 바뀐 뒤, 또는 서버와 끊긴 연결이면 재사용하지 않고 닫는다
+        if (shard.current_connections > shard.max_connections || shard.generations[conn] != generation.load() ||
+            isConnectionLost(mysql_errno(conn))) {
+            closeConnection(shard, conn);
+            shard.pool_condition.notify_one();
+            return;
+        }
+        
+        shard.available_connections.push(conn);
+        shard.pool_condition.notify_one();
     }
 };
@@ -1,74 +1,156 @@
 #include "mysql_member_repository.h"
+#include <mysql/mysqld_error.h>
 
-MySQLMemberRepository::MySQLMemberRepository(std::shared_ptr<MySQLConnectionPool> pool) : connectionPool(pool) {
+MySQLMemberRepository::MySQLMemberRepository(std::shared_ptr<MySQLConnectionPool> pool,
+                                             std::shared_ptr<QueryInstrumentation> queries)
+    : connectionPool(pool), queryInstrumentation(queries) {
 }
 
-std::vector<crow::json::wvalue> MySQLMemberRepository::getAllMembers() {
-    std::vector<crow::json::wvalue> members_list;
+std::vector<MemberRow> MySQLMemberRepository::getAllMemberRows() {
+    std::vector<MemberRow> rows;
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), "SELECT id, name, gender FROM members")) {
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectAll<MemberEntity>())) {
         std::cerr << "Error querying members: " << mysql_error(mysql.get()) << std::endl;
-        return members_list;
+        return rows;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
-        return members_list;
+        return rows;
     }
     
+    rows.reserve(mysql_num_rows(result));
     MYSQL_ROW row;
     while ((row = mysql_fetch_row(result)) != NULL) {
-        crow::json::wvalue member_obj;
-        member_obj["id"] = std::string(row[0]);
-        member_obj["name"] = std::string(row[1]);
-        member_obj["gender"] = std::string(row[2]);
-        members_list.push_back(member_obj);
+        rows.emplace_back();
+        entity_sql::decodeRow<MemberEntity>(row, rows.back());
     }
     
     mysql_free_result(result);
-    return members_list;
+    return rows;
 }
 
-crow::json::wvalue MySQLMemberRepository::getMemberById(const std::string& id) {
-    std::string query = "SELECT id, name, gender FROM members WHERE id = '" + id + "'";
+bool MySQLMemberRepository::streamAllMembers(const std::function<void(const MemberRow&)>& consumer) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectAll<MemberEntity>())) {
+        std::cerr << "Error querying members: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_use_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error using result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    // 행은 서버에서 하나씩 읽어오므로 결과 전체를 메모리에 두지 않는다
+    MemberRow member;
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        entity_sql::decodeRow<MemberEntity>(row, member);
+        consumer(member);
+    }
+    
+    bool completed = mysql_errno(mysql.get()) == 0;
+    if (!completed) {
+        std::cerr << "Error fetching members: " << mysql_error(mysql.get()) << std::endl;
+    }
+    mysql_free_result(result);
+    return completed;
+}
+
+ImportResult MySQLMemberRepository::importMembers(LocalInfileSource& source, bool replace) {
+    ImportResult result;
+    if (!connectionPool->localInfileAllowed()) {
+        result.disabled = true;
+        result.error = "LOAD DATA LOCAL INFILE is disabled (database.allow_local_infile)";
+        return result;
+    }
+    if (!source.prepare(result.error)) {
+        return result;
+    }
+    
+    auto mysql = connectionPool->getConnection();
+    source.install(mysql.get());
+    int status = queryInstrumentation->execute(mysql.get(), source.statement("members", replace));
+    LocalInfileSource::uninstall(mysql.get());
+    
+    result.rejected_lines = source.rejectedLines();
+    if (status) {
+        result.error = mysql_error(mysql.get());
+        std::cerr << "Error importing members: " << result.error << std::endl;
+        return result;
+    }
+    result.success = true;
+    result.rows = static_cast<long long>(mysql_affected_rows(mysql.get()));
+    result.warnings = mysql_warning_count(mysql.get());
+    return result;
+}
+
+bool MySQLMemberRepository::getCountsByGender(std::map<std::string, int64_t>& counts) {
+    auto mysql = connectionPool->getConnection();
+    
+    if (queryInstrumentation->execute(mysql.get(), "SELECT gender, COUNT(*) FROM members GROUP BY gender")) {
+        std::cerr << "Error querying member stats: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        counts[row[0]] = std::stoll(row[1]);
+    }
+    
+    mysql_free_result(result);
+    return true;
+}
+
+std::optional<MemberRow> MySQLMemberRepository::getMemberById(const std::string& id) {
+    auto mysql = connectionPool->getConnection();
+    
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectById<MemberEntity>(mysql.get(), id))) {
         std::cerr << "Error querying member: " << mysql_error(mysql.get()) << std::endl;
-        return crow::json::wvalue();
+        return std::nullopt;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
-        return crow::json::wvalue();
+        return std::nullopt;
     }
     
+    std::optional<MemberRow> member;
     MYSQL_ROW row = mysql_fetch_row(result);
     if (row != NULL) {
-        crow::json::wvalue member_obj;
-        member_obj["id"] = std::string(row[0]);
-        member_obj["name"] = std::string(row[1]);
-        member_obj["gender"] = std::string(row[2]);
-        mysql_free_result(result);
-        return member_obj;
+        member.emplace();
+        entity_sql::decodeRow<MemberEntity>(row, *member);
     }
     
     mysql_free_result(result);
-    return crow::json::wvalue();
+    return member;
 }
 
-bool MySQLMemberRepository::memberExists(const std::string& id) {
-    std::string query = "SELECT COUNT(*) FROM members WHERE id = '" + id + "'";
+bool MySQLMemberRepository::getWatermark(CacheSnapshot::Watermark& watermark) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error checking member existence: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::watermarkStatement<MemberEntity>())) {
+        std::cerr << "Error querying member watermark: " << mysql_error(mysql.get()) << std::endl;
         return false;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
@@ -76,44 +158,120 @@ bool MySQLMemberRepository::memberExists(const std::string& id) {
     }
     
     MYSQL_ROW row = mysql_fetch_row(result);
-    bool exists = false;
-    if (row != NULL) {
-        exists = std::stoi(row[0]) > 0;
+    bool found = row != NULL && row[0] != NULL;
+    if (found) {
+        watermark.rows = std::stoull(row[0]);
+        watermark.max_updated = row[1] != NULL ? std::stoll(row[1]) : 0;
     }
     
     mysql_free_result(result);
-    return exists;
+    return found;
 }
 
-void MySQLMemberRepository::addMember(const std::string& id, const crow::json::wvalue& member) {
-    std::string name = std::string(member["name"].dump()).substr(1, std::string(member["name"].dump()).length() - 2);
-    std::string gender = std::string(member["gender"].dump()).substr(1, std::string(member["gender"].dump()).length() - 2);
-    
-    std::string query = "INSERT INTO members (id, name, gender) VALUES ('" + id + "', '" + name + "', '" + gender + "')";
+bool MySQLMemberRepository::getMembersUpdatedSince(int64_t since, std::vector<MemberRow>& rows) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error adding member: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectUpdatedSince<MemberEntity>(since))) {
+        std::cerr << "Error querying updated members: " << mysql_error(mysql.get()) << std::endl;
+        return false;
     }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        rows.emplace_back();
+        entity_sql::decodeRow<MemberEntity>(row, rows.back());
+    }
+    
+    mysql_free_result(result);
+    return true;
 }
 
-void MySQLMemberRepository::updateMember(const std::string& id, const crow::json::wvalue& member) {
-    std::string name = std::string(member["name"].dump()).substr(1, std::string(member["name"].dump()).length() - 2);
-    std::string gender = std::string(member["gender"].dump()).substr(1, std::string(member["gender"].dump()).length() - 2);
-    
-    std::string query = "UPDATE members SET name = '" + name + "', gender = '" + gender + "' WHERE id = '" + id + "'";
+std::unordered_map<std::string, MemberRow> MySQLMemberRepository::getMembersByIds(const std::vector<std::string>& ids) {
+    std::unordered_map<std::string, MemberRow> rows;
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error updating member: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectByIds<MemberEntity>(mysql.get(), ids))) {
+        std::cerr << "Error querying members by id: " << mysql_error(mysql.get()) << std::endl;
+        return rows;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return rows;
+    }
+    
+    rows.reserve(ids.size());
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        // 앞의 ids.size() 개 열: 이 행이 각 요청 ID 와 일치하는지
+        MemberRow decoded;
+        entity_sql::decodeRow<MemberEntity>(row + ids.size(), decoded);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (row[i] != NULL && row[i][0] == '1') {
+                rows.emplace(ids[i], decoded);
+            }
+        }
     }
+    
+    mysql_free_result(result);
+    return rows;
 }
 
-void MySQLMemberRepository::deleteMember(const std::string& id) {
-    std::string query = "DELETE FROM members WHERE id = '" + id + "'";
+bool MySQLMemberRepository::addMember(const MemberRow& member) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error deleting member: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::insertStatement<MemberEntity>(mysql.get(), member))) {
+        if (mysql_errno(mysql.get()) != ER_DUP_ENTRY) {
+            std::cerr << "Error adding member: " << mysql_error(mysql.get()) << std::endl;
+        }
+        return false;
     }
-}
\ No newline at end of file
+    return true;
+}
+
+bool MySQLMemberRepository::updateMember(const MemberRow& member, std::optional<MemberRow>& previous) {
+    auto mysql = connectionPool->getPipelineConnection();
+    
+    // 집계 갱신에 필요한 변경 전 행 조회와 UPDATE 를 한 패킷으로 전송
+    StatementPipeline pipeline(mysql.get(), queryInstrumentation);
+    size_t select = pipeline.add(entity_sql::selectById<MemberEntity>(mysql.get(), member.id));
+    size_t update = pipeline.add(entity_sql::updateStatement<MemberEntity>(mysql.get(), member));
+    if (!pipeline.execute()) {
+        std::cerr << "Error updating member: " << pipeline.errorMessage() << std::endl;
+        return false;
+    }
+    previous = pipeline.firstRow<MemberEntity>(select);
+    if (pipeline.result(update).affected_rows == 0) {
+        // 조회와 수정 사이에 다른 요청이 삭제함 (CLIENT_FOUND_ROWS 라 값이 같아도 일치 행 수가 반환된다)
+        previous.reset();
+    }
+    return true;
+}
+
+bool MySQLMemberRepository::deleteMember(const std::string& id, std::optional<MemberRow>& previous) {
+    auto mysql = connectionPool->getPipelineConnection();
+    
+    // 삭제될 행 조회와 DELETE 를 한 패킷으로 전송
+    StatementPipeline pipeline(mysql.get(), queryInstrumentation);
+    size_t select = pipeline.add(entity_sql::selectById<MemberEntity>(mysql.get(), id));
+    size_t remove = pipeline.add(entity_sql::deleteStatement<MemberEntity>(mysql.get(), id));
+    if (!pipeline.execute()) {
+        std::cerr << "Error deleting member: " << pipeline.errorMessage() << std::endl;
+        return false;
+    }
+    previous = pipeline.firstRow<MemberEntity>(select);
+    if (pipeline.result(remove).affected_rows == 0) {
+        // 조회와 삭제 사이에 다른 요청이 먼저 삭제함
+        previous.reset();
+    }
+    return true;
+}
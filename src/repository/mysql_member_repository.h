@@ -7,30 +7,77 @@
 #include <memory>
 #include "../config/config.h"
 #include "mysql_connection_pool.h"
+#include "query_instrumentation.h"
+#include "local_infile.h"
+#include "entity_sql.h"
+#include "mysql_pipeline.h"
+#include "../utils/cache_snapshot.h"
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+// members 테이블의 한 행
+struct MemberRow {
+    std::string id;
+    std::string name;
+    std::string gender;
+};
+
+// members 테이블 필드 기술자 (검증, SQL, JSON/바이너리 인코딩에 사용)
+struct MemberEntity {
+    using Row = MemberRow;
+    static constexpr std::string_view singular = "Member";
+    static constexpr std::string_view table = "members";
+    static constexpr std::string_view updated_column = "updated_at";   // 행 변경 시각 (캐시 스냅샷 대조용)
+    static constexpr std::string_view genders[] = {"male", "female"};
+    static constexpr auto fields = std::make_tuple(
+        entity::keyField("id", "id", 50, &MemberRow::id),
+        entity::stringField("name", "name", 100, &MemberRow::name),
+        entity::enumField("gender", "gender", 20, &MemberRow::gender, genders));
+};
 
 class MySQLMemberRepository {
 private:
     std::shared_ptr<MySQLConnectionPool> connectionPool;
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
 
 public:
-    MySQLMemberRepository(std::shared_ptr<MySQLConnectionPool> pool);
+    MySQLMemberRepository(std::shared_ptr<MySQLConnectionPool> pool, std::shared_ptr<QueryInstrumentation> queries);
     ~MySQLMemberRepository() = default;
     
-    // 모든 멤버 조회
-    std::vector<crow::json::wvalue> getAllMembers();
+    // 모든 멤버를 행 단위로 조회 (검색 색인 구성용)
+    std::vector<MemberRow> getAllMemberRows();
+    
+    // 모든 멤버를 결과를 버퍼링하지 않고(mysql_use_result) 한 행씩 전달 (대량 내보내기용)
+    bool streamAllMembers(const std::function<void(const MemberRow&)>& consumer);
+    
+    // LOAD DATA LOCAL INFILE 로 대량 적재
+    ImportResult importMembers(LocalInfileSource& source, bool replace);
+    
+    // 행 수와 마지막 변경 시각 (쿼리 실패 시 false)
+    bool getWatermark(CacheSnapshot::Watermark& watermark);
+    
+    // since(unix 초) 이후에 추가/변경된 멤버 (쿼리 실패 시 false)
+    bool getMembersUpdatedSince(int64_t since, std::vector<MemberRow>& rows);
+    
+    // 성별 멤버 수 (쿼리 실패 시 false)
+    bool getCountsByGender(std::map<std::string, int64_t>& counts);
     
-    // ID로 멤버 조회
-    crow::json::wvalue getMemberById(const std::string& id);
+    // ID로 멤버 조회 (없거나 쿼리 실패 시 nullopt)
+    std::optional<MemberRow> getMemberById(const std::string& id);
     
-    // 멤버 존재 여부 확인
-    bool memberExists(const std::string& id);
+    // 여러 ID 를 한 번에 조회 (WHERE id IN). 찾은 행을 요청한 ID 로 묶어 반환하며 쿼리 실패 시 빈 맵.
+    // DB collation 으로 일치한 행이므로 행의 id 는 요청 ID 와 대소문자가 다를 수 있다
+    std::unordered_map<std::string, MemberRow> getMembersByIds(const std::vector<std::string>& ids);
     
-    // 멤버 추가
-    void addMember(const std::string& id, const crow::json::wvalue& member);
+    // 멤버 추가 (중복 ID 또는 쿼리 실패 시 false). 중복은 기본 키 제약으로 판단한다
+    bool addMember(const MemberRow& member);
     
-    // 멤버 업데이트
-    void updateMember(const std::string& id, const crow::json::wvalue& member);
+    // 멤버 업데이트 (키 필드로 대상 지정, 쿼리 실패 시 false).
+    // 변경 전 행 조회와 UPDATE 를 한 번의 왕복으로 보내고, 변경 전 행을 previous 에 채운다 (없으면 nullopt)
+    bool updateMember(const MemberRow& member, std::optional<MemberRow>& previous);
     
-    // 멤버 삭제
-    void deleteMember(const std::string& id);
+    // 멤버 삭제 (쿼리 실패 시 false). 조회와 DELETE 를 한 번의 왕복으로 보내고 삭제된 행을 previous 에 채운다
+    bool deleteMember(const std::string& id, std::optional<MemberRow>& previous);
 };
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <mysql/mysql.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "mysql_connection_pool.h"
+#include "query_instrumentation.h"
+#include "entity_sql.h"
+#include "../utils/request_context.h"
+
+// 여러 문장을 한 패킷으로 보내고 결과를 순서대로 받는 파이프라인.
+// 연결은 다중 문장이 켜진 MySQLConnectionPool::getPipelineConnection() 으로 얻어야 한다.
+// 서버는 실패한 문장 이후는 실행하지 않으며, 남은 결과는 execute() 가 모두 읽어
+// 연결이 다음 요청에서 "Commands out of sync" 상태가 되지 않게 한다.
+//
+//   auto conn = pool->getPipelineConnection();
+//   StatementPipeline pipeline(conn.get(), queries);
+//   size_t select = pipeline.add(entity_sql::selectById<MemberEntity>(conn, id));
+//   pipeline.add(entity_sql::deleteStatement<MemberEntity>(conn, id));
+//   if (pipeline.execute()) { auto previous = pipeline.firstRow<MemberEntity>(select); ... }
+class StatementPipeline {
+public:
+    struct Result {
+        MYSQL_RES* rows = nullptr;      // 결과 집합이 없는 문장은 nullptr
+        uint64_t affected_rows = 0;
+    };
+
+private:
+    MYSQL* connection;
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
+    std::vector<entity_sql::Statement> statements;
+    std::vector<Result> results;
+    std::string error_message;
+
+public:
+    StatementPipeline(MYSQL* connection, std::shared_ptr<QueryInstrumentation> queries)
+        : connection(connection), queryInstrumentation(std::move(queries)) {
+    }
+
+    ~StatementPipeline() {
+        for (auto& result : results) {
+            if (result.rows != nullptr) {
+                mysql_free_result(result.rows);
+            }
+        }
+    }
+
+    StatementPipeline(const StatementPipeline&) = delete;
+    StatementPipeline& operator=(const StatementPipeline&) = delete;
+
+    // 문장 추가 (세미콜론 없이). 결과 위치 반환
+    size_t add(entity_sql::Statement statement) {
+        statements.push_back(std::move(statement));
+        return statements.size() - 1;
+    }
+
+    // 모든 문장을 한 번의 왕복으로 실행. 모든 문장이 성공해야 true
+    bool execute() {
+        entity_sql::Statement packet(request_context::arena());
+        for (size_t i = 0; i < statements.size(); ++i) {
+            packet += (i > 0 ? "; " : "");
+            packet += statements[i];
+        }
+        return run(packet);
+    }
+
+    const Result& result(size_t index) const { return results[index]; }
+
+    const std::string& errorMessage() const { return error_message; }
+
+    // index 번째 결과의 첫 행을 Row 로 디코딩 (행이 없으면 nullopt)
+    template<typename Entity>
+    std::optional<typename Entity::Row> firstRow(size_t index) const {
+        std::optional<typename Entity::Row> row;
+        if (index >= results.size() || results[index].rows == nullptr) {
+            return row;
+        }
+        if (MYSQL_ROW cells = mysql_fetch_row(results[index].rows)) {
+            row.emplace();
+            entity_sql::decodeRow<Entity>(cells, *row);
+        }
+        return row;
+    }
+
+private:
+    // 패킷을 보내고 결과를 모두 읽는다 (다음 명령 전에 남은 결과가 없어야 한다)
+    bool run(const entity_sql::Statement& packet) {
+        // 쿼리 통계에는 파이프라인 전체가 한 문장 형태로 기록된다
+        if (queryInstrumentation->execute(connection, packet)) {
+            error_message = mysql_error(connection);
+            return false;
+        }
+
+        StageTimer fetchTimer(Stage::Fetch);
+        bool stored = true;
+        int status;
+        do {
+            Result result;
+            result.rows = mysql_store_result(connection);
+            if (result.rows == nullptr) {
+                if (mysql_field_count(connection) != 0) {
+                    // 결과 집합이 있어야 하는데 읽지 못함
+                    stored = false;
+                    error_message = mysql_error(connection);
+                }
+                result.affected_rows = mysql_affected_rows(connection);
+            }
+            results.push_back(result);
+            status = mysql_next_result(connection);     // 0: 다음 결과 있음, -1: 끝, >0: 오류
+        } while (status == 0);
+
+        if (status > 0) {
+            error_message = mysql_error(connection);
+            return false;
+        }
+        return stored && results.size() == statements.size();
+    }
+};
@@ -1,76 +1,168 @@
 #include "mysql_product_repository.h"
+#include <mysql/mysqld_error.h>
 
-MySQLProductRepository::MySQLProductRepository(std::shared_ptr<MySQLConnectionPool> pool) : connectionPool(pool) {
+MySQLProductRepository::MySQLProductRepository(std::shared_ptr<MySQLConnectionPool> pool,
+                                               std::shared_ptr<QueryInstrumentation> queries)
+    : connectionPool(pool), queryInstrumentation(queries) {
 }
 
-std::vector<crow::json::wvalue> MySQLProductRepository::getAllProducts() {
-    std::vector<crow::json::wvalue> products_list;
+std::vector<ProductRow> MySQLProductRepository::getAllProductRows() {
+    std::vector<ProductRow> rows;
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), "SELECT id, name, price, category FROM products")) {
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectAll<ProductEntity>())) {
         std::cerr << "Error querying products: " << mysql_error(mysql.get()) << std::endl;
-        return products_list;
+        return rows;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
-        return products_list;
+        return rows;
     }
     
+    rows.reserve(mysql_num_rows(result));
     MYSQL_ROW row;
     while ((row = mysql_fetch_row(result)) != NULL) {
-        crow::json::wvalue product_obj;
-        product_obj["id"] = std::string(row[0]);
-        product_obj["name"] = std::string(row[1]);
-        product_obj["price"] = std::stoi(row[2]);
-        product_obj["category"] = std::string(row[3]);
-        products_list.push_back(product_obj);
+        rows.emplace_back();
+        entity_sql::decodeRow<ProductEntity>(row, rows.back());
     }
     
     mysql_free_result(result);
-    return products_list;
+    return rows;
 }
 
-crow::json::wvalue MySQLProductRepository::getProductById(const std::string& id) {
-    std::string query = "SELECT id, name, price, category FROM products WHERE id = '" + id + "'";
+bool MySQLProductRepository::streamAllProducts(const std::function<void(const ProductRow&)>& consumer) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectAll<ProductEntity>())) {
+        std::cerr << "Error querying products: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_use_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error using result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    // 행은 서버에서 하나씩 읽어오므로 결과 전체를 메모리에 두지 않는다
+    ProductRow product;
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        entity_sql::decodeRow<ProductEntity>(row, product);
+        consumer(product);
+    }
+    
+    bool completed = mysql_errno(mysql.get()) == 0;
+    if (!completed) {
+        std::cerr << "Error fetching products: " << mysql_error(mysql.get()) << std::endl;
+    }
+    mysql_free_result(result);
+    return completed;
+}
+
+ImportResult MySQLProductRepository::importProducts(LocalInfileSource& source, bool replace) {
+    ImportResult result;
+    if (!connectionPool->localInfileAllowed()) {
+        result.disabled = true;
+        result.error = "LOAD DATA LOCAL INFILE is disabled (database.allow_local_infile)";
+        return result;
+    }
+    if (!source.prepare(result.error)) {
+        return result;
+    }
+    
+    auto mysql = connectionPool->getConnection();
+    source.install(mysql.get());
+    int status = queryInstrumentation->execute(mysql.get(), source.statement("products", replace));
+    LocalInfileSource::uninstall(mysql.get());
+    
+    result.rejected_lines = source.rejectedLines();
+    if (status) {
+        result.error = mysql_error(mysql.get());
+        std::cerr << "Error importing products: " << result.error << std::endl;
+        return result;
+    }
+    result.success = true;
+    result.rows = static_cast<long long>(mysql_affected_rows(mysql.get()));
+    result.warnings = mysql_warning_count(mysql.get());
+    return result;
+}
+
+bool MySQLProductRepository::getPriceStatsByCategory(std::map<std::string, PriceStats>& stats, const std::string& category) {
+    auto mysql = connectionPool->getConnection();
+    
+    std::string query = "SELECT category, COUNT(*), COALESCE(SUM(price), 0), MIN(price), MAX(price) FROM products";
+    if (!category.empty()) {
+        std::string escaped(category.size() * 2 + 1, '\0');
+        escaped.resize(mysql_real_escape_string(mysql.get(), &escaped[0], category.c_str(), category.size()));
+        query += " WHERE category = '" + escaped + "'";
+    }
+    query += " GROUP BY category";
+    
+    if (queryInstrumentation->execute(mysql.get(), query)) {
+        std::cerr << "Error querying product stats: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        PriceStats& entry = stats[row[0]];
+        entry.count = std::stoll(row[1]);
+        entry.sum = std::stoll(row[2]);
+        entry.min = std::stoi(row[3]);
+        entry.max = std::stoi(row[4]);
+    }
+    
+    mysql_free_result(result);
+    return true;
+}
+
+std::optional<ProductRow> MySQLProductRepository::getProductById(const std::string& id) {
+    auto mysql = connectionPool->getConnection();
+    
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectById<ProductEntity>(mysql.get(), id))) {
         std::cerr << "Error querying product: " << mysql_error(mysql.get()) << std::endl;
-        return crow::json::wvalue();
+        return std::nullopt;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
-        return crow::json::wvalue();
+        return std::nullopt;
     }
     
+    std::optional<ProductRow> product;
     MYSQL_ROW row = mysql_fetch_row(result);
     if (row != NULL) {
-        crow::json::wvalue product_obj;
-        product_obj["id"] = std::string(row[0]);
-        product_obj["name"] = std::string(row[1]);
-        product_obj["price"] = std::stoi(row[2]);
-        product_obj["category"] = std::string(row[3]);
-        mysql_free_result(result);
-        return product_obj;
+        product.emplace();
+        entity_sql::decodeRow<ProductEntity>(row, *product);
     }
     
     mysql_free_result(result);
-    return crow::json::wvalue();
+    return product;
 }
 
-bool MySQLProductRepository::productExists(const std::string& id) {
-    std::string query = "SELECT COUNT(*) FROM products WHERE id = '" + id + "'";
+bool MySQLProductRepository::getWatermark(CacheSnapshot::Watermark& watermark) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error checking product existence: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::watermarkStatement<ProductEntity>())) {
+        std::cerr << "Error querying product watermark: " << mysql_error(mysql.get()) << std::endl;
         return false;
     }
     
+    StageTimer fetchTimer(Stage::Fetch);
     MYSQL_RES* result = mysql_store_result(mysql.get());
     if (result == NULL) {
         std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
@@ -78,46 +170,120 @@ bool MySQLProductRepository::productExists(const std::string& id) {
     }
     
     MYSQL_ROW row = mysql_fetch_row(result);
-    bool exists = false;
-    if (row != NULL) {
-        exists = std::stoi(row[0]) > 0;
+    bool found = row != NULL && row[0] != NULL;
+    if (found) {
+        watermark.rows = std::stoull(row[0]);
+        watermark.max_updated = row[1] != NULL ? std::stoll(row[1]) : 0;
     }
     
     mysql_free_result(result);
-    return exists;
+    return found;
 }
 
-void MySQLProductRepository::addProduct(const std::string& id, const crow::json::wvalue& product) {
-    std::string name = std::string(product["name"].dump()).substr(1, std::string(product["name"].dump()).length() - 2);
-    int price = std::stoi(std::string(product["price"].dump()));
-    std::string category = std::string(product["category"].dump()).substr(1, std::string(product["category"].dump()).length() - 2);
-    
-    std::string query = "INSERT INTO products (id, name, price, category) VALUES ('" + id + "', '" + name + "', " + std::to_string(price) + ", '" + category + "')";
+bool MySQLProductRepository::getProductsUpdatedSince(int64_t since, std::vector<ProductRow>& rows) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error adding product: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectUpdatedSince<ProductEntity>(since))) {
+        std::cerr << "Error querying updated products: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return false;
+    }
+    
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        rows.emplace_back();
+        entity_sql::decodeRow<ProductEntity>(row, rows.back());
     }
+    
+    mysql_free_result(result);
+    return true;
 }
 
-void MySQLProductRepository::updateProduct(const std::string& id, const crow::json::wvalue& product) {
-    std::string name = std::string(product["name"].dump()).substr(1, std::string(product["name"].dump()).length() - 2);
-    int price = std::stoi(std::string(product["price"].dump()));
-    std::string category = std::string(product["category"].dump()).substr(1, std::string(product["category"].dump()).length() - 2);
-    
-    std::string query = "UPDATE products SET name = '" + name + "', price = " + std::to_string(price) + ", category = '" + category + "' WHERE id = '" + id + "'";
+std::unordered_map<std::string, ProductRow> MySQLProductRepository::getProductsByIds(const std::vector<std::string>& ids) {
+    std::unordered_map<std::string, ProductRow> rows;
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error updating product: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::selectByIds<ProductEntity>(mysql.get(), ids))) {
+        std::cerr << "Error querying products by id: " << mysql_error(mysql.get()) << std::endl;
+        return rows;
     }
+    
+    StageTimer fetchTimer(Stage::Fetch);
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        std::cerr << "Error storing result: " << mysql_error(mysql.get()) << std::endl;
+        return rows;
+    }
+    
+    rows.reserve(ids.size());
+    MYSQL_ROW row;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        // 앞의 ids.size() 개 열: 이 행이 각 요청 ID 와 일치하는지
+        ProductRow decoded;
+        entity_sql::decodeRow<ProductEntity>(row + ids.size(), decoded);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (row[i] != NULL && row[i][0] == '1') {
+                rows.emplace(ids[i], decoded);
+            }
+        }
+    }
+    
+    mysql_free_result(result);
+    return rows;
 }
 
-void MySQLProductRepository::deleteProduct(const std::string& id) {
-    std::string query = "DELETE FROM products WHERE id = '" + id + "'";
+bool MySQLProductRepository::addProduct(const ProductRow& product) {
     auto mysql = connectionPool->getConnection();
     
-    if (mysql_query(mysql.get(), query.c_str())) {
-        std::cerr << "Error deleting product: " << mysql_error(mysql.get()) << std::endl;
+    if (queryInstrumentation->execute(mysql.get(), entity_sql::insertStatement<ProductEntity>(mysql.get(), product))) {
+        if (mysql_errno(mysql.get()) != ER_DUP_ENTRY) {
+            std::cerr << "Error adding product: " << mysql_error(mysql.get()) << std::endl;
+        }
+        return false;
     }
-}
\ No newline at end of file
+    return true;
+}
+
+bool MySQLProductRepository::updateProduct(const ProductRow& product, std::optional<ProductRow>& previous) {
+    auto mysql = connectionPool->getPipelineConnection();
+    
+    // 집계 갱신에 필요한 변경 전 행 조회와 UPDATE 를 한 패킷으로 전송
+    StatementPipeline pipeline(mysql.get(), queryInstrumentation);
+    size_t select = pipeline.add(entity_sql::selectById<ProductEntity>(mysql.get(), product.id));
+    size_t update = pipeline.add(entity_sql::updateStatement<ProductEntity>(mysql.get(), product));
+    if (!pipeline.execute()) {
+        std::cerr << "Error updating product: " << pipeline.errorMessage() << std::endl;
+        return false;
+    }
+    previous = pipeline.firstRow<ProductEntity>(select);
+    if (pipeline.result(update).affected_rows == 0) {
+        // 조회와 수정 사이에 다른 요청이 삭제함 (CLIENT_FOUND_ROWS 라 값이 같아도 일치 행 수가 반환된다)
+        previous.reset();
+    }
+    return true;
+}
+
+bool MySQLProductRepository::deleteProduct(const std::string& id, std::optional<ProductRow>& previous) {
+    auto mysql = connectionPool->getPipelineConnection();
+    
+    // 삭제될 행 조회와 DELETE 를 한 패킷으로 전송
+    StatementPipeline pipeline(mysql.get(), queryInstrumentation);
+    size_t select = pipeline.add(entity_sql::selectById<ProductEntity>(mysql.get(), id));
+    size_t remove = pipeline.add(entity_sql::deleteStatement<ProductEntity>(mysql.get(), id));
+    if (!pipeline.execute()) {
+        std::cerr << "Error deleting product: " << pipeline.errorMessage() << std::endl;
+        return false;
+    }
+    previous = pipeline.firstRow<ProductEntity>(select);
+    if (pipeline.result(remove).affected_rows == 0) {
+        // 조회와 삭제 사이에 다른 요청이 먼저 삭제함
+        previous.reset();
+    }
+    return true;
+}
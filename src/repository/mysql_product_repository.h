@@ -7,30 +7,72 @@
 #include <memory>
 #include "../config/config.h"
 #include "mysql_connection_pool.h"
+#include "query_instrumentation.h"
+#include "product_snapshot.h"
+#include "local_infile.h"
+#include "../utils/aggregates.h"
+#include "entity_sql.h"
+#include "mysql_pipeline.h"
+#include "../utils/cache_snapshot.h"
+#include <functional>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+// products 테이블 필드 기술자 (검증, SQL, JSON/바이너리 인코딩에 사용)
+struct ProductEntity {
+    using Row = ProductRow;
+    static constexpr std::string_view singular = "Product";
+    static constexpr std::string_view table = "products";
+    static constexpr std::string_view updated_column = "updated_at";   // 행 변경 시각 (캐시 스냅샷 대조용)
+    static constexpr auto fields = std::make_tuple(
+        entity::keyField("id", "id", 50, &ProductRow::id),
+        entity::stringField("name", "name", 100, &ProductRow::name),
+        entity::intField("price", "price", 0, 100000000, &ProductRow::price),
+        entity::stringField("category", "category", 50, &ProductRow::category));
+};
 
 class MySQLProductRepository {
 private:
     std::shared_ptr<MySQLConnectionPool> connectionPool;
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
 
 public:
-    MySQLProductRepository(std::shared_ptr<MySQLConnectionPool> pool);
+    MySQLProductRepository(std::shared_ptr<MySQLConnectionPool> pool, std::shared_ptr<QueryInstrumentation> queries);
     ~MySQLProductRepository() = default;
     
-    // 모든 제품 조회
-    std::vector<crow::json::wvalue> getAllProducts();
+    // 모든 제품을 행 단위로 조회 (컬럼형 스냅샷 구성용)
+    std::vector<ProductRow> getAllProductRows();
+    
+    // 모든 제품을 결과를 버퍼링하지 않고(mysql_use_result) 한 행씩 전달 (대량 내보내기용)
+    bool streamAllProducts(const std::function<void(const ProductRow&)>& consumer);
+    
+    // LOAD DATA LOCAL INFILE 로 대량 적재
+    ImportResult importProducts(LocalInfileSource& source, bool replace);
+    
+    // 행 수와 마지막 변경 시각 (쿼리 실패 시 false)
+    bool getWatermark(CacheSnapshot::Watermark& watermark);
+    
+    // since(unix 초) 이후에 추가/변경된 제품 (쿼리 실패 시 false)
+    bool getProductsUpdatedSince(int64_t since, std::vector<ProductRow>& rows);
+    
+    // 카테고리별 가격 집계 (category 가 비어 있지 않으면 해당 카테고리만, 쿼리 실패 시 false)
+    bool getPriceStatsByCategory(std::map<std::string, PriceStats>& stats, const std::string& category = "");
     
-    // ID로 제품 조회
-    crow::json::wvalue getProductById(const std::string& id);
+    // ID로 제품 조회 (없거나 쿼리 실패 시 nullopt)
+    std::optional<ProductRow> getProductById(const std::string& id);
     
-    // 제품 존재 여부 확인
-    bool productExists(const std::string& id);
+    // 여러 ID 를 한 번에 조회 (WHERE id IN). 찾은 행을 요청한 ID 로 묶어 반환하며 쿼리 실패 시 빈 맵.
+    // DB collation 으로 일치한 행이므로 행의 id 는 요청 ID 와 대소문자가 다를 수 있다
+    std::unordered_map<std::string, ProductRow> getProductsByIds(const std::vector<std::string>& ids);
     
-    // 제품 추가
-    void addProduct(const std::string& id, const crow::json::wvalue& product);
+    // 제품 추가 (중복 ID 또는 쿼리 실패 시 false). 중복은 기본 키 제약으로 판단한다
+    bool addProduct(const ProductRow& product);
     
-    // 제품 업데이트
-    void updateProduct(const std::string& id, const crow::json::wvalue& product);
+    // 제품 업데이트 (키 필드로 대상 지정, 쿼리 실패 시 false).
+    // 변경 전 행 조회와 UPDATE 를 한 번의 왕복으로 보내고, 변경 전 행을 previous 에 채운다 (없으면 nullopt)
+    bool updateProduct(const ProductRow& product, std::optional<ProductRow>& previous);
     
-    // 제품 삭제
-    void deleteProduct(const std::string& id);
+    // 제품 삭제 (쿼리 실패 시 false). 조회와 DELETE 를 한 번의 왕복으로 보내고 삭제된 행을 previous 에 채운다
+    bool deleteProduct(const std::string& id, std::optional<ProductRow>& previous);
 };
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <mysql/mysql.h>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "mysql_connection_pool.h"
+#include "query_instrumentation.h"
+#include "entity_sql.h"
+#include "../utils/request_context.h"
+
+// 풀에서 가져온 연결 하나를 고정해 여러 문장을 한 트랜잭션으로 실행한다.
+// 문장은 필드 기술자(entity_sql)로 만들며, commit 하지 않고 소멸하면 롤백한다.
+class MySQLTransaction {
+private:
+    std::shared_ptr<MYSQL> connection;     // 트랜잭션 동안 고정
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
+    bool active = false;
+
+public:
+    MySQLTransaction(MySQLConnectionPool& pool, std::shared_ptr<QueryInstrumentation> queries)
+        : connection(pool.getConnection()), queryInstrumentation(std::move(queries)) {
+    }
+
+    ~MySQLTransaction() {
+        if (active) {
+            try {
+                rollback();
+            } catch (const DatabaseUnavailableError&) {
+                // 연결이 끊겼으면 서버가 트랜잭션을 이미 롤백했고, 연결은 반환 시 폐기된다
+            }
+        }
+    }
+
+    MySQLTransaction(const MySQLTransaction&) = delete;
+    MySQLTransaction& operator=(const MySQLTransaction&) = delete;
+
+    bool begin() {
+        active = run("START TRANSACTION");
+        return active;
+    }
+
+    bool commit() {
+        if (!active) {
+            return false;
+        }
+        active = false;
+        if (!run("COMMIT")) {
+            // 커밋 실패 시 서버가 트랜잭션을 되돌리도록 명시적으로 롤백
+            run("ROLLBACK");
+            return false;
+        }
+        return true;
+    }
+
+    void rollback() {
+        active = false;
+        run("ROLLBACK");
+    }
+
+    // 마지막 문장의 오류
+    unsigned int errorNumber() { return mysql_errno(connection.get()); }
+    std::string errorMessage() { return mysql_error(connection.get()); }
+
+    // 키로 행을 잠그고 조회 (SELECT ... FOR UPDATE). 쿼리 실패 시 false, 없으면 row 는 nullopt
+    template<typename Entity>
+    bool lockById(const std::string& id, std::optional<typename Entity::Row>& row) {
+        row.reset();
+        if (!run(entity_sql::selectById<Entity>(connection.get(), id) + " FOR UPDATE")) {
+            return false;
+        }
+        StageTimer fetchTimer(Stage::Fetch);
+        MYSQL_RES* result = mysql_store_result(connection.get());
+        if (result == NULL) {
+            return false;
+        }
+        if (MYSQL_ROW cells = mysql_fetch_row(result)) {
+            row.emplace();
+            entity_sql::decodeRow<Entity>(cells, *row);
+        }
+        mysql_free_result(result);
+        return true;
+    }
+
+    template<typename Entity>
+    bool insert(const typename Entity::Row& row) {
+        return run(entity_sql::insertStatement<Entity>(connection.get(), row));
+    }
+
+    template<typename Entity>
+    bool update(const typename Entity::Row& row) {
+        return run(entity_sql::updateStatement<Entity>(connection.get(), row));
+    }
+
+    template<typename Entity>
+    bool remove(const std::string& id) {
+        return run(entity_sql::deleteStatement<Entity>(connection.get(), id));
+    }
+
+private:
+    bool run(std::string_view statement) {
+        if (queryInstrumentation->execute(connection.get(), statement)) {
+            std::cerr << "Transaction statement failed: " << mysql_error(connection.get()) << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
@@ -0,0 +1,244 @@
+#include "product_snapshot.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PRODUCT_SNAPSHOT_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// 카테고리 코드 -1 은 "카테고리 조건 없음"
+constexpr int32_t kAnyCategory = -1;
+
+// SIMD 커널이 마지막 블록에서 결과 버퍼 뒤로 넘겨 쓸 수 있는 최대 원소 수
+constexpr size_t kOutputSlack = 8;
+
+size_t filterScalar(const int32_t* prices, const int32_t* codes, size_t begin, size_t count,
+                    int32_t code, int32_t min_price, int32_t max_price, uint32_t* out) {
+    size_t matched = 0;
+    for (size_t i = begin; i < count; ++i) {
+        bool hit = prices[i] >= min_price && prices[i] <= max_price &&
+                   (code == kAnyCategory || codes[i] == code);
+        // 분기 없이 기록하고 일치할 때만 커서를 전진
+        out[matched] = static_cast<uint32_t>(i);
+        matched += hit;
+    }
+    return matched;
+}
+
+#ifdef PRODUCT_SNAPSHOT_X86
+
+// 4레인 마스크에 켜진 행 번호를 분기 없이 기록
+inline size_t emitMask4(unsigned mask, size_t base, uint32_t* out) {
+    size_t matched = 0;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        out[matched] = static_cast<uint32_t>(base + lane);
+        matched += (mask >> lane) & 1;
+    }
+    return matched;
+}
+
+// 8레인 마스크별로 켜진 레인 번호를 앞으로 모은 순열 (AVX2 compress 용)
+struct CompressTable {
+    alignas(32) uint32_t lanes[256][8];
+
+    CompressTable() {
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            unsigned count = 0;
+            for (unsigned lane = 0; lane < 8; ++lane) {
+                if (mask & (1u << lane)) {
+                    lanes[mask][count++] = lane;
+                }
+            }
+            while (count < 8) {
+                lanes[mask][count++] = 0;
+            }
+        }
+    }
+};
+
+const CompressTable& compressTable() {
+    static const CompressTable table;
+    return table;
+}
+
+__attribute__((target("sse2")))
+size_t filterSSE(const int32_t* prices, const int32_t* codes, size_t count,
+                 int32_t code, int32_t min_price, int32_t max_price, uint32_t* out) {
+    const __m128i lo = _mm_set1_epi32(min_price);
+    const __m128i hi = _mm_set1_epi32(max_price);
+    const __m128i wanted = _mm_set1_epi32(code);
+    const bool check_price = min_price != std::numeric_limits<int32_t>::min() ||
+                             max_price != std::numeric_limits<int32_t>::max();
+    const bool check_category = code != kAnyCategory;
+
+    size_t matched = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        unsigned mask = 0xF;
+        if (check_price) {
+            __m128i price = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prices + i));
+            // lo <= price <= hi  ⇔  !(lo > price) && !(price > hi)
+            __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lo, price), _mm_cmpgt_epi32(price, hi));
+            mask &= ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(outside)));
+        }
+        if (check_category) {
+            __m128i category = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i));
+            mask &= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(category, wanted))));
+        }
+        matched += emitMask4(mask, i, out + matched);
+    }
+    return matched + filterScalar(prices, codes, i, count, code, min_price, max_price, out + matched);
+}
+
+__attribute__((target("avx2,popcnt")))
+size_t filterAVX2(const int32_t* prices, const int32_t* codes, size_t count,
+                  int32_t code, int32_t min_price, int32_t max_price, uint32_t* out) {
+    const __m256i lo = _mm256_set1_epi32(min_price);
+    const __m256i hi = _mm256_set1_epi32(max_price);
+    const __m256i wanted = _mm256_set1_epi32(code);
+    const __m256i lane_offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const bool check_price = min_price != std::numeric_limits<int32_t>::min() ||
+                             max_price != std::numeric_limits<int32_t>::max();
+    const bool check_category = code != kAnyCategory;
+    const CompressTable& table = compressTable();
+
+    size_t matched = 0;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        unsigned mask = 0xFF;
+        if (check_price) {
+            __m256i price = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prices + i));
+            __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lo, price), _mm256_cmpgt_epi32(price, hi));
+            mask &= ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+        }
+        if (check_category) {
+            __m256i category = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i));
+            mask &= static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(category, wanted))));
+        }
+        // 일치한 레인의 행 번호를 앞으로 모아 8개를 한 번에 저장하고, 일치한 수만큼만 전진
+        __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.lanes[mask]));
+        __m256i rows = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int32_t>(i)), lane_offsets);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + matched), _mm256_permutevar8x32_epi32(rows, lanes));
+        matched += static_cast<size_t>(__builtin_popcount(mask));
+    }
+    return matched + filterScalar(prices, codes, i, count, code, min_price, max_price, out + matched);
+}
+
+#endif
+
+ProductSnapshot::Kernel resolveKernel(ProductSnapshot::Kernel kernel) {
+    if (kernel != ProductSnapshot::Kernel::Auto) {
+        return ProductSnapshot::kernelSupported(kernel) ? kernel : ProductSnapshot::Kernel::Scalar;
+    }
+    static const ProductSnapshot::Kernel best =
+        ProductSnapshot::kernelSupported(ProductSnapshot::Kernel::AVX2) ? ProductSnapshot::Kernel::AVX2 :
+        ProductSnapshot::kernelSupported(ProductSnapshot::Kernel::SSE) ? ProductSnapshot::Kernel::SSE :
+        ProductSnapshot::Kernel::Scalar;
+    return best;
+}
+
+} // namespace
+
+size_t ProductSnapshot::memoryBytes() const {
+    size_t bytes = prices.capacity() * sizeof(int32_t) + category_codes.capacity() * sizeof(int32_t) +
+                   id_arena.capacity() + name_arena.capacity() +
+                   (id_offsets.capacity() + name_offsets.capacity()) * sizeof(uint32_t);
+    for (const auto& category : category_dictionary) {
+        bytes += sizeof(std::string) + category.capacity();
+    }
+    return bytes;
+}
+
+ProductSnapshot::ProductSnapshot(const std::vector<ProductRow>& rows) {
+    prices.reserve(rows.size());
+    category_codes.reserve(rows.size());
+    id_offsets.reserve(rows.size() + 1);
+    name_offsets.reserve(rows.size() + 1);
+    id_offsets.push_back(0);
+    name_offsets.push_back(0);
+
+    for (const auto& row : rows) {
+        prices.push_back(row.price);
+
+        auto it = category_lookup.find(row.category);
+        if (it == category_lookup.end()) {
+            it = category_lookup.emplace(row.category, static_cast<int32_t>(category_dictionary.size())).first;
+            category_dictionary.push_back(row.category);
+        }
+        category_codes.push_back(it->second);
+
+        id_arena += row.id;
+        id_offsets.push_back(static_cast<uint32_t>(id_arena.size()));
+        name_arena += row.name;
+        name_offsets.push_back(static_cast<uint32_t>(name_arena.size()));
+    }
+}
+
+std::vector<uint32_t> ProductSnapshot::filter(const ProductFilter& filter, Kernel kernel) const {
+    int32_t code = kAnyCategory;
+    if (!filter.category.empty()) {
+        auto it = category_lookup.find(filter.category);
+        if (it == category_lookup.end()) {
+            return {};
+        }
+        code = it->second;
+    }
+    if (filter.min_price > filter.max_price || prices.empty()) {
+        return {};
+    }
+
+    // 최대 크기로 잡아두고 커널이 채운 만큼만 남긴다
+    std::vector<uint32_t> rows(prices.size() + kOutputSlack);
+    size_t matched = 0;
+    switch (resolveKernel(kernel)) {
+#ifdef PRODUCT_SNAPSHOT_X86
+        case Kernel::AVX2:
+            matched = filterAVX2(prices.data(), category_codes.data(), prices.size(),
+                                 code, filter.min_price, filter.max_price, rows.data());
+            break;
+        case Kernel::SSE:
+            matched = filterSSE(prices.data(), category_codes.data(), prices.size(),
+                                code, filter.min_price, filter.max_price, rows.data());
+            break;
+#endif
+        default:
+            matched = filterScalar(prices.data(), category_codes.data(), 0, prices.size(),
+                                   code, filter.min_price, filter.max_price, rows.data());
+            break;
+    }
+    rows.resize(matched);
+    return rows;
+}
+
+std::string_view ProductSnapshot::id(uint32_t row) const {
+    return std::string_view(id_arena).substr(id_offsets[row], id_offsets[row + 1] - id_offsets[row]);
+}
+
+std::string_view ProductSnapshot::name(uint32_t row) const {
+    return std::string_view(name_arena).substr(name_offsets[row], name_offsets[row + 1] - name_offsets[row]);
+}
+
+bool ProductSnapshot::kernelSupported(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Auto:
+        case Kernel::Scalar:
+            return true;
+#ifdef PRODUCT_SNAPSHOT_X86
+        case Kernel::SSE:
+            return __builtin_cpu_supports("sse2");
+        case Kernel::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* ProductSnapshot::kernelName(Kernel kernel) {
+    switch (resolveKernel(kernel)) {
+        case Kernel::AVX2: return "avx2";
+        case Kernel::SSE: return "sse";
+        default: return "scalar";
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// products 테이블의 한 행
+struct ProductRow {
+    std::string id;
+    std::string name;
+    int32_t price = 0;
+    std::string category;
+};
+
+// 상품 필터 조건 (category 가 비어 있으면 카테고리 조건 없음)
+struct ProductFilter {
+    std::string category;
+    int32_t min_price = std::numeric_limits<int32_t>::min();
+    int32_t max_price = std::numeric_limits<int32_t>::max();
+
+    // 스냅샷 밖의 행(쓰기 누적분)에 같은 조건 적용
+    bool matches(const ProductRow& row) const {
+        return (category.empty() || row.category == category) && row.price >= min_price && row.price <= max_price;
+    }
+};
+
+// products 테이블의 읽기 전용 컬럼형 스냅샷.
+// 가격은 연속된 int32 컬럼, 카테고리는 사전(dictionary) 코드 컬럼,
+// id/name 은 하나의 문자열 아레나와 오프셋 배열로 저장해 필터를 SIMD 로 스캔한다.
+class ProductSnapshot {
+public:
+    // 필터 커널 종류 (Auto 는 CPU 가 지원하는 가장 넓은 커널)
+    enum class Kernel { Auto, Scalar, SSE, AVX2 };
+
+private:
+    std::vector<int32_t> prices;
+    std::vector<int32_t> category_codes;
+    std::vector<std::string> category_dictionary;
+    std::unordered_map<std::string, int32_t> category_lookup;
+    std::string id_arena;
+    std::vector<uint32_t> id_offsets;      // 행 i 의 id 는 [id_offsets[i], id_offsets[i + 1])
+    std::string name_arena;
+    std::vector<uint32_t> name_offsets;
+
+public:
+    explicit ProductSnapshot(const std::vector<ProductRow>& rows);
+
+    size_t size() const { return prices.size(); }
+
+    // 컬럼과 문자열 아레나가 차지하는 바이트 (근사값)
+    size_t memoryBytes() const;
+
+    // 조건에 맞는 행 번호 목록 (행 순서 유지)
+    std::vector<uint32_t> filter(const ProductFilter& filter, Kernel kernel = Kernel::Auto) const;
+
+    std::string_view id(uint32_t row) const;
+    std::string_view name(uint32_t row) const;
+    int32_t price(uint32_t row) const { return prices[row]; }
+    const std::string& category(uint32_t row) const { return category_dictionary[category_codes[row]]; }
+
+    // 현재 CPU 에서 사용할 수 있는 커널인지 여부
+    static bool kernelSupported(Kernel kernel);
+    static const char* kernelName(Kernel kernel);
+};
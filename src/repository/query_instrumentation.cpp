@@ -0,0 +1,306 @@
+#include "query_instrumentation.h"
+#include "crow.h"
+#include "../utils/request_context.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <sstream>
+
+int64_t QueryShapeStats::percentileMicros(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(count * percentile);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return std::min<int64_t>(int64_t(1) << i, max_us);
+        }
+    }
+    return max_us;
+}
+
+QueryInstrumentation::QueryInstrumentation(std::shared_ptr<MySQLConnectionPool> pool, const DatabaseConfig& config)
+    : connectionPool(pool),
+      slow_threshold_us(static_cast<int64_t>(config.slow_query_threshold_ms) * 1000),
+      explain_sample_rate(config.explain_sample_rate) {
+    explain_worker = std::thread([this] { explainLoop(); });
+}
+
+QueryInstrumentation::~QueryInstrumentation() {
+    {
+        std::lock_guard<std::mutex> lock(explain_mutex);
+        stopping = true;
+    }
+    explain_condition.notify_all();
+    if (explain_worker.joinable()) {
+        explain_worker.join();
+    }
+}
+
+int QueryInstrumentation::execute(MYSQL* conn, std::string_view query) {
+    StageTimer timer(Stage::Query);
+    auto start_time = std::chrono::high_resolution_clock::now();
+    int status = mysql_real_query(conn, query.data(), static_cast<unsigned long>(query.size()));
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - start_time);
+    timer.stop();
+
+    record(normalize(query), query, elapsed.count(), status != 0);
+
+    // 연결이 끊긴 오류는 circuit breaker 에 반영하고 DatabaseUnavailableError 로 전달
+    connectionPool->recordQueryResult(conn, status);
+    return status;
+}
+
+std::vector<QueryShapeStats> QueryInstrumentation::topShapes(size_t limit) {
+    std::vector<QueryShapeStats> result;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& entry : shard.shapes) {
+            result.push_back(entry.second);
+        }
+    }
+
+    std::sort(result.begin(), result.end(), [](const QueryShapeStats& a, const QueryShapeStats& b) {
+        return a.total_us > b.total_us;
+    });
+    if (result.size() > limit) {
+        result.resize(limit);
+    }
+    return result;
+}
+
+size_t QueryInstrumentation::shapeCount() {
+    size_t count = 0;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.shapes.size();
+    }
+    return count;
+}
+
+void QueryInstrumentation::reset() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.shapes.clear();
+    }
+}
+
+void QueryInstrumentation::setSlowQueryThreshold(int64_t threshold_ms) {
+    slow_threshold_us = threshold_ms * 1000;
+}
+
+void QueryInstrumentation::setExplainSampleRate(double rate) {
+    explain_sample_rate = std::max(0.0, std::min(1.0, rate));
+}
+
+std::string QueryInstrumentation::normalize(std::string_view query) {
+    std::string shape;
+    shape.reserve(query.size());
+
+    size_t i = 0;
+    while (i < query.size()) {
+        char c = query[i];
+
+        // 문자열 리터럴
+        if (c == '\'' || c == '"') {
+            char quote = c;
+            ++i;
+            while (i < query.size()) {
+                if (query[i] == '\\') {
+                    i += 2;
+                    continue;
+                }
+                if (query[i] == quote) {
+                    if (i + 1 < query.size() && query[i + 1] == quote) {
+                        i += 2;
+                        continue;
+                    }
+                    break;
+                }
+                ++i;
+            }
+            ++i;
+            shape += '?';
+            continue;
+        }
+
+        // 숫자 리터럴 (식별자 일부인 숫자는 제외)
+        if (std::isdigit(static_cast<unsigned char>(c)) &&
+            (shape.empty() || !(std::isalnum(static_cast<unsigned char>(shape.back())) || shape.back() == '_'))) {
+            while (i < query.size() && (std::isalnum(static_cast<unsigned char>(query[i])) || query[i] == '.')) {
+                ++i;
+            }
+            shape += '?';
+            continue;
+        }
+
+        // 연속 공백은 하나로
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!shape.empty() && shape.back() != ' ') {
+                shape += ' ';
+            }
+            ++i;
+            continue;
+        }
+
+        shape += c;
+        ++i;
+    }
+
+    while (!shape.empty() && shape.back() == ' ') {
+        shape.pop_back();
+    }
+    return shape;
+}
+
+QueryInstrumentation::Shard& QueryInstrumentation::shardFor(const std::string& shape) {
+    return shards[std::hash<std::string>{}(shape) % SHARD_COUNT];
+}
+
+void QueryInstrumentation::record(const std::string& shape, std::string_view query, int64_t elapsed_us, bool failed) {
+    bool slow = elapsed_us >= slow_threshold_us.load();
+
+    {
+        Shard& shard = shardFor(shape);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        QueryShapeStats& stats = shard.shapes[shape];
+        if (stats.shape.empty()) {
+            stats.shape = shape;
+        }
+        stats.count++;
+        stats.total_us += elapsed_us;
+        stats.max_us = std::max(stats.max_us, elapsed_us);
+
+        size_t bucket = 0;
+        while (bucket + 1 < stats.buckets.size() && (int64_t(1) << bucket) < elapsed_us) {
+            ++bucket;
+        }
+        stats.buckets[bucket]++;
+
+        if (failed) {
+            stats.errors++;
+        }
+        if (slow) {
+            stats.slow_count++;
+        }
+    }
+
+    if (slow) {
+        // 리터럴에는 개인정보가 들어 있을 수 있으므로 로그에는 문장 형태만 남긴다
+        CROW_LOG_WARNING << "[SLOW QUERY] " << elapsed_us << "μs " << shape;
+        // 파이프라인(여러 문장)은 EXPLAIN 을 붙이면 뒤 문장이 다시 실행되므로 제외.
+        // 문자열 리터럴은 shape 에서 ? 로 바뀌었으므로 남은 ';' 는 문장 구분자다
+        if (!failed && shape.find(';') == std::string::npos && shouldExplain(query)) {
+            scheduleExplain(shape, query);
+        }
+    }
+}
+
+bool QueryInstrumentation::shouldExplain(std::string_view query) {
+    // EXPLAIN 가능한 문장만 대상
+    size_t start = query.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+        return false;
+    }
+    std::string verb;
+    for (size_t i = start; i < query.size() && std::isalpha(static_cast<unsigned char>(query[i])); ++i) {
+        verb += static_cast<char>(std::toupper(static_cast<unsigned char>(query[i])));
+    }
+    if (verb != "SELECT" && verb != "UPDATE" && verb != "DELETE" && verb != "INSERT" && verb != "REPLACE") {
+        return false;
+    }
+
+    double rate = explain_sample_rate.load();
+    if (rate <= 0.0) {
+        return false;
+    }
+    thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    return distribution(generator) < rate;
+}
+
+void QueryInstrumentation::scheduleExplain(const std::string& shape, std::string_view query) {
+    {
+        std::lock_guard<std::mutex> lock(explain_mutex);
+        if (pending_explains.size() >= MAX_PENDING_EXPLAINS) {
+            return;
+        }
+        pending_explains.push_back({shape, std::string(query)});
+    }
+    explain_condition.notify_one();
+}
+
+void QueryInstrumentation::explainLoop() {
+    while (true) {
+        ExplainRequest request;
+        {
+            std::unique_lock<std::mutex> lock(explain_mutex);
+            explain_condition.wait(lock, [this] { return stopping || !pending_explains.empty(); });
+            if (stopping) {
+                return;
+            }
+            request = std::move(pending_explains.front());
+            pending_explains.pop_front();
+        }
+
+        std::string plan = runExplain(request.query);
+        if (plan.empty()) {
+            continue;
+        }
+
+        CROW_LOG_WARNING << "[SLOW QUERY] EXPLAIN " << request.shape << " => " << plan;
+
+        Shard& shard = shardFor(request.shape);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.shapes.find(request.shape);
+        if (it != shard.shapes.end()) {
+            it->second.last_explain = plan;
+        }
+    }
+}
+
+std::string QueryInstrumentation::runExplain(const std::string& query) {
+    // 요청 처리를 막지 않도록 여유 연결이 있을 때만 실행
+    auto mysql = connectionPool->tryGetConnection();
+    if (!mysql) {
+        return "";
+    }
+
+    std::string explain_query = "EXPLAIN " + query;
+    if (mysql_query(mysql.get(), explain_query.c_str())) {
+        std::cerr << "Error running EXPLAIN: " << mysql_error(mysql.get()) << std::endl;
+        return "";
+    }
+
+    MYSQL_RES* result = mysql_store_result(mysql.get());
+    if (result == NULL) {
+        return "";
+    }
+
+    unsigned int num_fields = mysql_num_fields(result);
+    MYSQL_FIELD* fields = mysql_fetch_fields(result);
+
+    std::ostringstream plan;
+    MYSQL_ROW row;
+    bool first_row = true;
+    while ((row = mysql_fetch_row(result)) != NULL) {
+        if (!first_row) {
+            plan << " | ";
+        }
+        first_row = false;
+        for (unsigned int i = 0; i < num_fields; ++i) {
+            if (row[i] == NULL) {
+                continue;
+            }
+            plan << fields[i].name << "=" << row[i] << (i + 1 < num_fields ? " " : "");
+        }
+    }
+
+    mysql_free_result(result);
+    return plan.str();
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <mysql/mysql.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../config/config.h"
+#include "mysql_connection_pool.h"
+
+// 문장 형태(shape)별 지연시간 집계
+struct QueryShapeStats {
+    std::string shape;          // 리터럴을 ? 로 치환한 문장
+    uint64_t count = 0;
+    uint64_t errors = 0;
+    uint64_t slow_count = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    std::array<uint64_t, 32> buckets{};  // log2(마이크로초) 히스토그램
+    std::string last_explain;   // 마지막으로 수집된 EXPLAIN 결과
+
+    int64_t averageMicros() const { return count > 0 ? total_us / static_cast<int64_t>(count) : 0; }
+
+    // 히스토그램 버킷 상한으로 근사한 백분위 (마이크로초)
+    int64_t percentileMicros(double percentile) const;
+};
+
+// 리포지토리의 모든 mysql_query 호출을 감싸는 계측 계층.
+// 문장별 소요시간을 집계하고, 임계값을 넘는 쿼리는 slow query 로그로 남기며
+// 샘플링된 쿼리에 대해서는 별도 연결에서 EXPLAIN 을 실행해 결과를 보관한다.
+class QueryInstrumentation {
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t MAX_PENDING_EXPLAINS = 16;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, QueryShapeStats> shapes;
+    };
+
+    struct ExplainRequest {
+        std::string shape;
+        std::string query;
+    };
+
+    std::shared_ptr<MySQLConnectionPool> connectionPool;
+    std::array<Shard, SHARD_COUNT> shards;
+
+    std::atomic<int64_t> slow_threshold_us;
+    std::atomic<double> explain_sample_rate;
+
+    // EXPLAIN 은 요청 스레드가 아닌 백그라운드 스레드에서 실행
+    std::mutex explain_mutex;
+    std::condition_variable explain_condition;
+    std::deque<ExplainRequest> pending_explains;
+    bool stopping = false;
+    std::thread explain_worker;
+
+public:
+    QueryInstrumentation(std::shared_ptr<MySQLConnectionPool> pool, const DatabaseConfig& config);
+    ~QueryInstrumentation();
+
+    QueryInstrumentation(const QueryInstrumentation&) = delete;
+    QueryInstrumentation& operator=(const QueryInstrumentation&) = delete;
+
+    // mysql_query 실행 및 계측 (반환값은 mysql_query 와 동일).
+    // 서버와의 연결이 끊긴 경우에는 circuit breaker 에 기록하고 DatabaseUnavailableError 를 던진다
+    int execute(MYSQL* conn, std::string_view query);
+
+    // 누적 소요시간 기준 상위 문장 형태
+    std::vector<QueryShapeStats> topShapes(size_t limit);
+
+    // 집계 중인 문장 형태 수
+    size_t shapeCount();
+
+    // 집계 초기화
+    void reset();
+
+    // 임계값/샘플링 비율 변경
+    void setSlowQueryThreshold(int64_t threshold_ms);
+    void setExplainSampleRate(double rate);
+
+    // 문자열/숫자 리터럴을 ? 로 치환하고 공백을 정리해 문장 형태를 만든다
+    static std::string normalize(std::string_view query);
+
+private:
+    Shard& shardFor(const std::string& shape);
+    void record(const std::string& shape, std::string_view query, int64_t elapsed_us, bool failed);
+    bool shouldExplain(std::string_view query);
+    void scheduleExplain(const std::string& shape, std::string_view query);
+    void explainLoop();
+    std::string runExplain(const std::string& query);
+};
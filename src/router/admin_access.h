@@ -0,0 +1,78 @@
+#pragma once
+
+#include "crow.h"
+#include "../config/config.h"
+#include <memory>
+#include <string>
+#include <string_view>
+
+// 운영용 라우트(/debug/*, /admin/*) 접근 제어.
+// 루프백 주소에서 직접 온 요청(allow_loopback)이나 Authorization: Bearer <token> 이 맞는 요청만 허용하고,
+// 나머지는 핸들러를 실행하지 않고 403 으로 끝낸다.
+// 프록시를 거친 요청(X-Forwarded-For 있음)은 원래 주소를 알 수 없으므로 루프백으로 보지 않는다.
+class AdminAccess {
+private:
+    struct Settings {
+        bool allow_loopback = true;
+        std::string token;
+    };
+
+    std::shared_ptr<const Settings> settings = std::make_shared<const Settings>();
+
+public:
+    // 설정 재로드 시에도 호출 (요청 처리 중에 바꿔도 된다)
+    void configure(const AdminAccessConfig& config)
+    {
+        auto next = std::make_shared<Settings>();
+        next->allow_loopback = config.allow_loopback;
+        next->token = config.token;
+        std::atomic_store(&settings, std::shared_ptr<const Settings>(std::move(next)));
+    }
+
+    // 허용되지 않으면 403 응답을 끝내고 false
+    bool authorize(const crow::request& req, crow::response& res) const
+    {
+        auto current = std::atomic_load(&settings);
+        if ((current->allow_loopback && isLoopback(req)) ||
+            (!current->token.empty() && tokenMatches(req, current->token))) {
+            return true;
+        }
+
+        res.code = 403;
+        res.set_header("Content-Type", "application/json");
+        res.write(crow::json::wvalue({
+            {"error", "Forbidden"}
+        }).dump());
+        res.end();
+        return false;
+    }
+
+private:
+    static bool isLoopback(const crow::request& req)
+    {
+        if (!req.get_header_value("X-Forwarded-For").empty()) {
+            return false;
+        }
+        std::string_view address(req.remote_ip_address);
+        return address.compare(0, 4, "127.") == 0 || address == "::1" || address.compare(0, 11, "::ffff:127.") == 0;
+    }
+
+    static bool tokenMatches(const crow::request& req, const std::string& token)
+    {
+        std::string_view header(req.get_header_value("Authorization"));
+        constexpr std::string_view prefix = "Bearer ";
+        if (header.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        std::string_view presented = header.substr(prefix.size());
+        if (presented.size() != token.size()) {
+            return false;
+        }
+        // 비교 시간으로 토큰이 드러나지 않도록 끝까지 비교
+        unsigned char diff = 0;
+        for (size_t i = 0; i < token.size(); ++i) {
+            diff |= static_cast<unsigned char>(presented[i] ^ token[i]);
+        }
+        return diff == 0;
+    }
+};
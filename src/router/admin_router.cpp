@@ -0,0 +1,49 @@
+#include "admin_router.h"
+
+template<typename... Middlewares>
+AdminRouter<Middlewares...>::AdminRouter(crow::App<Middlewares...>& app, ConfigReloader& reloader,
+                                         const AdminAccess& access)
+    : app(app), configReloader(reloader), access(access) {
+}
+
+template<typename... Middlewares>
+void AdminRouter<Middlewares...>::setupRoutes() {
+    // 설정 재로드 라우트 (POST)
+    CROW_ROUTE(app, "/admin/reload")
+    .methods("POST"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            reloadConfig(req, res);
+        }
+    });
+}
+
+template<typename... Middlewares>
+void AdminRouter<Middlewares...>::reloadConfig(const crow::request& /*req*/, crow::response& res) {
+    ReloadResult result = configReloader.reload();
+
+    res.set_header("Content-Type", "application/json");
+    if (!result.success) {
+        res.code = 400;
+        res.write(crow::json::wvalue({
+            {"error", result.error}
+        }).dump());
+        res.end();
+        return;
+    }
+
+    std::vector<crow::json::wvalue> applied(result.applied.begin(), result.applied.end());
+    std::vector<crow::json::wvalue> restart_required(result.restart_required.begin(), result.restart_required.end());
+
+    crow::json::wvalue body;
+    body["message"] = "Configuration reloaded";
+    body["applied"] = std::move(applied);
+    body["restart_required"] = std::move(restart_required);
+
+    res.code = 200;
+    res.write(body.dump());
+    res.end();
+}
+
+// 명시적 인스턴스 선언
+template class AdminRouter<struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "crow.h"
+#include "admin_access.h"
+#include "../config/config_reloader.h"
+#include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include <string>
+
+template<typename... Middlewares>
+class AdminRouter {
+private:
+    crow::App<Middlewares...>& app;
+    ConfigReloader& configReloader;
+    const AdminAccess& access;
+
+public:
+    AdminRouter(crow::App<Middlewares...>& app, ConfigReloader& reloader, const AdminAccess& access);
+    
+    // 관리용 라우트들 설정 (모두 AdminAccess 를 통과해야 실행)
+    void setupRoutes();
+    
+    // 설정 파일 재로드
+    void reloadConfig(const crow::request& req, crow::response& res);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "crow.h"
+#include "../utils/db_executor.h"
+#include "../utils/request_context.h"
+#include "../repository/mysql_connection_pool.h"
+#include <functional>
+
+// DB 를 사용하는 핸들러를 executor 로 넘기고 I/O 스레드는 바로 반환한다.
+// 응답은 executor 워커에서 핸들러가 res.end() 를 호출할 때 완료된다.
+// req/res 는 응답이 완료될 때까지 연결이 소유하므로 참조로 넘겨도 안전하다.
+inline void dispatchToExecutor(DbExecutor& executor, crow::response& res, std::function<void()> handler) {
+    // 워커가 응답을 끝내기 전에 I/O 스레드에서의 할당량을 요청에 반영
+    request_context::flushAllocations();
+    bool accepted = executor.submit([&res, handler = std::move(handler)] {
+        try {
+            handler();
+        } catch (const DatabaseUnavailableError& e) {
+            // DB 장애 중이고 대신 응답할 마지막 정상값도 없음
+            if (!res.is_completed()) {
+                res.code = 503;
+                res.set_header("Content-Type", "application/json");
+                res.set_header("Retry-After", "1");
+                res.write(crow::json::wvalue({
+                    {"error", "Database unavailable, please retry later"}
+                }).dump());
+                res.end();
+            }
+        } catch (const std::exception& e) {
+            if (!res.is_completed()) {
+                res.code = 500;
+                res.set_header("Content-Type", "application/json");
+                res.write(crow::json::wvalue({
+                    {"error", "Internal server error"}
+                }).dump());
+                res.end();
+            }
+        }
+    });
+
+    // 요청 컨텍스트는 작업과 함께 넘어갔으므로 I/O 스레드에서는 바인딩 해제
+    request_context::bind(nullptr);
+
+    if (!accepted) {
+        res.code = 503;
+        res.set_header("Content-Type", "application/json");
+        res.set_header("Retry-After", "1");
+        res.write(crow::json::wvalue({
+            {"error", "Server is overloaded, please retry later"}
+        }).dump());
+        res.end();
+    }
+}
+
+// executor 워커에서 준비한 응답을 연결의 I/O 스레드에서 끝낸다 (res.end() 를 io_context 로 post).
+// 정적 파일 응답은 res.end() 안에서 파일 끝까지 전송하므로, 느린 클라이언트가 DB 워커를 붙잡지 않게 할 때 쓴다.
+// after 는 res.end() 가 반환된 뒤 같은 I/O 스레드에서 호출된다 (전송한 임시 파일 정리 등)
+inline void endOnIoThread(const crow::request& req, crow::response& res, std::function<void()> after = {}) {
+    RequestContext* ctx = request_context::current();
+    asio::post(*req.io_context, [&res, ctx, after = std::move(after)] {
+        request_context::Binding binding(ctx);
+        res.end();
+        if (after) {
+            after();
+        }
+    });
+}
@@ -0,0 +1,185 @@
+#include "batch_router.h"
+#include "async_dispatch.h"
+#include "entity_json.h"
+
+namespace {
+
+// 응답 본문의 결과 항목 ("skipped" 는 앞선 실패로 실행되지 않은 작업)
+crow::json::wvalue resultEntry(const BatchOperation& op, int status) {
+    crow::json::wvalue entry;
+    entry["id"] = op.kind == BatchOperation::Kind::Delete ? op.id
+        : op.target == BatchOperation::Target::Member ? op.member.id : op.product.id;
+    if (status == 0) {
+        entry["status"] = "skipped";
+    } else {
+        entry["status"] = status;
+    }
+    return entry;
+}
+
+// data 객체를 Row 로 읽기 (수정은 키를 id 필드에서 가져온다)
+template<typename Entity>
+bool decodeData(const crow::json::rvalue& item, BatchOperation::Kind kind, const std::string& id,
+                typename Entity::Row& row, std::string& error) {
+    if (!item.has("data") || item["data"].t() != crow::json::type::Object) {
+        error = "Missing required field: data";
+        return false;
+    }
+    bool with_key = kind == BatchOperation::Kind::Create;
+    entity::FieldCheck check = entity_json::decode<Entity>(item["data"], row, with_key);
+    if (!check) {
+        error = entity::errorMessage<Entity>(check);
+        return false;
+    }
+    if (!with_key) {
+        row.*(std::get<0>(Entity::fields).member) = id;
+    }
+    return true;
+}
+
+} // namespace
+
+template<typename... Middlewares>
+BatchRouter<Middlewares...>::BatchRouter(crow::App<Middlewares...>& app, BatchService& service, DbExecutor& executor)
+    : app(app), batchService(service), executor(executor) {
+}
+
+template<typename... Middlewares>
+void BatchRouter<Middlewares...>::setupRoutes() {
+    // 일괄 처리 라우트 (POST)
+    CROW_ROUTE(app, "/batch")
+    .methods("POST"_method)
+    ([this](const crow::request& req, crow::response& res){
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            executeBatch(req, res);
+        });
+    });
+}
+
+template<typename... Middlewares>
+void BatchRouter<Middlewares...>::executeBatch(const crow::request& req, crow::response& res) {
+    if (!entity_json::isJsonContentType(req.get_header_value("Content-Type"))) {
+        finish(res, 400, entity::jsonErrorBody("Content-Type must be application/json"));
+        return;
+    }
+    auto body = crow::json::load(req.body);
+    if (body.error() || body.t() != crow::json::type::Object) {
+        finish(res, 400, entity::jsonErrorBody("Invalid JSON format"));
+        return;
+    }
+
+    // 모든 작업을 먼저 읽고 검증해, 형식 오류로 트랜잭션을 여는 일이 없게 한다
+    std::vector<BatchOperation> operations;
+    std::string error;
+    size_t index = 0;
+    if (!parseOperations(body, operations, error, index)) {
+        crow::json::wvalue failure;
+        failure["committed"] = false;
+        failure["failed_index"] = index;
+        failure["error"] = error;
+        finish(res, 400, failure.dump());
+        return;
+    }
+
+    BatchOutcome outcome = batchService.execute(operations);
+
+    crow::json::wvalue response;
+    response["committed"] = outcome.committed;
+    std::vector<crow::json::wvalue> results;
+    for (size_t i = 0; i < operations.size(); ++i) {
+        results.push_back(resultEntry(operations[i], outcome.statuses[i]));
+    }
+    response["results"] = std::move(results);
+
+    if (outcome.committed) {
+        finish(res, 200, response.dump());
+        return;
+    }
+
+    // 실패한 작업의 상태로 응답 코드 결정 (검증 400, 없음 404, 중복 409, 그 외 DB 오류 500)
+    int failed_status = outcome.failed_index < operations.size() ? outcome.statuses[outcome.failed_index] : 0;
+    int code = (failed_status == 400 || failed_status == 404 || failed_status == 409) ? failed_status : 500;
+    response["failed_index"] = outcome.failed_index;
+    response["error"] = code == 500 ? "Transaction failed" : outcome.error;
+    finish(res, code, response.dump());
+}
+
+template<typename... Middlewares>
+bool BatchRouter<Middlewares...>::parseOperations(const crow::json::rvalue& body, std::vector<BatchOperation>& operations,
+                                                  std::string& error, size_t& index) {
+    if (!body.has("operations") || body["operations"].t() != crow::json::type::List) {
+        error = "Missing required field: operations";
+        return false;
+    }
+    const auto& items = body["operations"];
+    if (items.size() == 0 || items.size() > kMaxOperations) {
+        error = "operations must contain 1 to " + std::to_string(kMaxOperations) + " items";
+        return false;
+    }
+
+    operations.reserve(items.size());
+    for (index = 0; index < items.size(); ++index) {
+        const auto& item = items[index];
+        if (item.t() != crow::json::type::Object || !item.has("op") || !item.has("entity") ||
+            item["op"].t() != crow::json::type::String || item["entity"].t() != crow::json::type::String) {
+            error = "Each operation needs string fields op and entity";
+            return false;
+        }
+
+        BatchOperation op;
+        std::string kind = item["op"].s();
+        if (kind == "create") {
+            op.kind = BatchOperation::Kind::Create;
+        } else if (kind == "update") {
+            op.kind = BatchOperation::Kind::Update;
+        } else if (kind == "delete") {
+            op.kind = BatchOperation::Kind::Delete;
+        } else {
+            error = "op must be one of: create, update, delete";
+            return false;
+        }
+
+        std::string target = item["entity"].s();
+        if (target == "members") {
+            op.target = BatchOperation::Target::Member;
+        } else if (target == "products") {
+            op.target = BatchOperation::Target::Product;
+        } else {
+            error = "entity must be one of: members, products";
+            return false;
+        }
+
+        // 수정/삭제는 id 로 대상을 지정
+        if (op.kind != BatchOperation::Kind::Create) {
+            if (!item.has("id") || item["id"].t() != crow::json::type::String) {
+                error = "Missing required field: id";
+                return false;
+            }
+            op.id = item["id"].s();
+        }
+
+        if (op.kind != BatchOperation::Kind::Delete) {
+            bool decoded = op.target == BatchOperation::Target::Member
+                ? decodeData<MemberEntity>(item, op.kind, op.id, op.member, error)
+                : decodeData<ProductEntity>(item, op.kind, op.id, op.product, error);
+            if (!decoded) {
+                return false;
+            }
+        }
+        operations.push_back(std::move(op));
+    }
+    return true;
+}
+
+template<typename... Middlewares>
+void BatchRouter<Middlewares...>::finish(crow::response& res, int code, const std::string& body) {
+    res.code = code;
+    res.set_header("Content-Type", "application/json");
+    StageTimer bodyTimer(Stage::Body);
+    res.write(body);
+    bodyTimer.stop();
+    res.end();
+}
+
+// 명시적 인스턴스 선언
+template class BatchRouter<struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "crow.h"
+#include "../service/batch_service.h"
+#include "../utils/db_executor.h"
+#include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include <string>
+#include <vector>
+
+// POST /batch
+//   {"operations": [{"op": "create|update|delete", "entity": "members|products", "id": "...", "data": {...}}, ...]}
+// 작업은 순서대로 한 트랜잭션에서 실행되며, 응답에는 작업별 결과가 같은 순서로 담긴다.
+template<typename... Middlewares>
+class BatchRouter {
+private:
+    crow::App<Middlewares...>& app;
+    BatchService& batchService;
+    DbExecutor& executor;
+
+    // 한 요청에 허용하는 최대 작업 수 (트랜잭션이 잠그는 행 수 제한)
+    static constexpr size_t kMaxOperations = 100;
+
+public:
+    BatchRouter(crow::App<Middlewares...>& app, BatchService& service, DbExecutor& executor);
+
+    // 일괄 처리 라우트 설정
+    void setupRoutes();
+
+    // 일괄 처리 실행
+    void executeBatch(const crow::request& req, crow::response& res);
+
+private:
+    // 요청 본문을 작업 목록으로 변환. 실패 시 오류 메시지를 error 에, 위치를 index 에 기록
+    bool parseOperations(const crow::json::rvalue& body, std::vector<BatchOperation>& operations,
+                         std::string& error, size_t& index);
+
+    // JSON 응답 쓰기 후 완료
+    void finish(crow::response& res, int code, const std::string& body);
+};
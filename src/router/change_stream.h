@@ -0,0 +1,54 @@
+#pragma once
+
+#include "crow.h"
+#include "../utils/change_feed.h"
+#include "../utils/request_context.h"
+#include <cstdlib>
+#include <string>
+
+// 변경 이벤트 피드를 Server-Sent Events 응답으로 보낸다 (GET /products/stream, /members/stream).
+// Crow 는 끝나지 않는 응답 본문을 쓸 수 없으므로, 응답 하나에 이벤트 배치를 담아 끝내고
+// EventSource 가 retry 간격 뒤 Last-Event-ID 로 다시 연결하는 방식으로 이어 간다.
+// 새 이벤트가 없으면 max_wait 동안 응답을 붙잡아 두므로 DB 조회도, 빈 폴링 응답도 없다.
+// 응답은 이벤트가 발행된 뒤 피드의 디스패처 스레드에서 완료될 수 있다.
+inline void streamChanges(ChangeFeed& feed, const crow::request& req, crow::response& res) {
+    // 재개 위치: Last-Event-ID 헤더, 헤더를 못 보내는 클라이언트는 last_event_id 쿼리.
+    // 없으면 지금부터의 변경만, 해석할 수 없으면 0 (reset 을 받는다)
+    std::string last_event_id = req.get_header_value("Last-Event-ID");
+    if (last_event_id.empty()) {
+        if (const char* param = req.url_params.get("last_event_id")) {
+            last_event_id = param;
+        }
+    }
+    uint64_t after_id = feed.lastId();
+    if (!last_event_id.empty()) {
+        char* end = nullptr;
+        after_id = std::strtoull(last_event_id.c_str(), &end, 10);
+        if (end == last_event_id.c_str() || *end != '\0') {
+            after_id = 0;
+        }
+    }
+
+    // 다른 스레드에서 완료될 수 있으므로 I/O 스레드에서의 할당량을 먼저 요청에 반영
+    request_context::flushAllocations();
+    RequestContext* context = request_context::current();
+    bool accepted = feed.subscribe(after_id, [&res, context](ChangeFeed::Batch&& batch) {
+        request_context::Binding binding(context);
+        res.code = 200;
+        res.set_header("Content-Type", "text/event-stream; charset=utf-8");
+        res.set_header("Cache-Control", "no-cache");
+        res.write(batch.body);
+        res.end();
+    });
+    request_context::bind(nullptr);
+
+    if (!accepted) {
+        res.code = 503;
+        res.set_header("Content-Type", "application/json");
+        res.set_header("Retry-After", "1");
+        res.write(crow::json::wvalue({
+            {"error", "Too many stream subscribers, please retry later"}
+        }).dump());
+        res.end();
+    }
+}
@@ -0,0 +1,250 @@
+#include "crud_router.h"
+#include "../service/member_service.h"
+#include "../service/product_service.h"
+
+namespace {
+
+// 엔티티별 고정 응답 본문 (처음 사용할 때 한 번 직렬화)
+struct CrudBodies {
+    std::string invalid_json;
+    std::string content_type;
+    std::string not_found;
+    std::string conflict;
+    std::string update_failed;
+    std::string internal_error;
+    std::string created_prefix;
+    std::string updated_prefix;
+    std::string deleted_prefix;
+};
+
+std::string messagePrefix(const std::string& message) {
+    std::string prefix = "{\"message\":";
+    export_format::appendJsonString(prefix, message);
+    prefix += ",\"id\":";
+    return prefix;
+}
+
+template<typename Entity>
+const CrudBodies& crudBodies() {
+    static const CrudBodies bodies = [] {
+        std::string name(Entity::singular);
+        CrudBodies result;
+        result.invalid_json = entity::jsonErrorBody("Invalid JSON format");
+        result.content_type = entity::jsonErrorBody("Content-Type must be application/json");
+        result.not_found = entity::jsonErrorBody(name + " not found");
+        result.conflict = entity::jsonErrorBody(name + " already exists or invalid data");
+        result.update_failed = entity::jsonErrorBody(name + " not found or invalid data");
+        result.internal_error = entity::jsonErrorBody("Internal server error");
+        result.created_prefix = messagePrefix(name + " created successfully");
+        result.updated_prefix = messagePrefix(name + " updated successfully");
+        result.deleted_prefix = messagePrefix(name + " deleted successfully");
+        return result;
+    }();
+    return bodies;
+}
+
+} // namespace
+
+template<typename Entity, typename Service, typename... Middlewares>
+CrudRouter<Entity, Service, Middlewares...>::CrudRouter(crow::App<Middlewares...>& app, Service& service,
+                                                        DbExecutor& executor, std::string path)
+    : app(app), service(service), executor(executor), path(std::move(path)) {
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::setupRoutes(bool with_list) {
+    // 경로가 런타임 문자열이므로 CROW_ROUTE 대신 route_dynamic 으로 등록
+    if (with_list) {
+        // 목록 조회 라우트 (GET)
+        app.route_dynamic(path)
+        .methods("GET"_method)
+        ([this](const crow::request& req, crow::response& res){
+            dispatchToExecutor(executor, res, [this, &req, &res] {
+                getAll(req, res);
+            });
+        });
+    }
+
+    // 생성 라우트 (POST)
+    app.route_dynamic(path)
+    .methods("POST"_method)
+    ([this](const crow::request& req, crow::response& res){
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            create(req, res);
+        });
+    });
+
+    // 개별 조회 라우트 (GET)
+    app.route_dynamic(path + "/<string>")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res, std::string id){
+        dispatchToExecutor(executor, res, [this, &req, &res, id] {
+            getOne(req, res, id);
+        });
+    });
+
+    // 수정 라우트 (PUT)
+    app.route_dynamic(path + "/<string>")
+    .methods("PUT"_method)
+    ([this](const crow::request& req, crow::response& res, std::string id){
+        dispatchToExecutor(executor, res, [this, &req, &res, id] {
+            update(req, res, id);
+        });
+    });
+
+    // 삭제 라우트 (DELETE)
+    app.route_dynamic(path + "/<string>")
+    .methods("DELETE"_method)
+    ([this](const crow::request& req, crow::response& res, std::string id){
+        dispatchToExecutor(executor, res, [this, &req, &res, id] {
+            remove(req, res, id);
+        });
+    });
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::getAll(const crow::request& req, crow::response& res) {
+    writeRows(req, res, service.getAllRows());
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::getOne(const crow::request& /*req*/, crow::response& res,
+                                                        const std::string& id) {
+    auto row = service.getRowById(id);
+    if (!row) {
+        finish(res, 404, crudBodies<Entity>().not_found);
+        return;
+    }
+
+    StageTimer serializeTimer(Stage::Serialize);
+    std::string payload;
+    entity::appendJson<Entity>(payload, *row);
+    serializeTimer.stop();
+    finish(res, 200, payload);
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::create(const crow::request& req, crow::response& res) {
+    const auto& bodies = crudBodies<Entity>();
+    try {
+        Row row;
+        if (const std::string* error = decodeBody(req, row, true)) {
+            finish(res, 400, *error);
+            return;
+        }
+        if (service.addRow(row)) {
+            finish(res, 201, successBody(bodies.created_prefix, row.*(std::get<0>(Entity::fields).member)));
+        } else {
+            finish(res, 409, bodies.conflict);
+        }
+    } catch (const DatabaseUnavailableError&) {
+        throw;
+    } catch (const std::exception& e) {
+        finish(res, 500, bodies.internal_error);
+    }
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::update(const crow::request& req, crow::response& res,
+                                                        const std::string& id) {
+    const auto& bodies = crudBodies<Entity>();
+    try {
+        if (auto check = entity::checkKey<Entity>(id); !check) {
+            finish(res, 400, entity::errorBody<Entity>(check));
+            return;
+        }
+        Row row;
+        if (const std::string* error = decodeBody(req, row, false)) {
+            finish(res, 400, *error);
+            return;
+        }
+        row.*(std::get<0>(Entity::fields).member) = id;
+        if (service.updateRow(row)) {
+            finish(res, 200, successBody(bodies.updated_prefix, id));
+        } else {
+            finish(res, 404, bodies.update_failed);
+        }
+    } catch (const DatabaseUnavailableError&) {
+        throw;
+    } catch (const std::exception& e) {
+        finish(res, 500, bodies.internal_error);
+    }
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::remove(const crow::request& /*req*/, crow::response& res,
+                                                        const std::string& id) {
+    const auto& bodies = crudBodies<Entity>();
+    if (service.deleteRow(id)) {
+        finish(res, 200, successBody(bodies.deleted_prefix, id));
+    } else {
+        finish(res, 404, bodies.not_found);
+    }
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::writeRows(const crow::request& req, crow::response& res,
+                                                           const std::vector<Row>& rows) {
+    auto encoding = binary_encoding::negotiate(req.get_header_value("Accept"));
+    res.set_header("Vary", "Accept");
+
+    // 행 구조체에서 바로 직렬화 (wvalue 트리를 만들지 않음)
+    StageTimer serializeTimer(Stage::Serialize);
+    std::string payload;
+    payload.reserve(rows.size() * 64 + 2);
+    if (encoding == binary_encoding::Encoding::MsgPack) {
+        binary_encoding::MsgPackWriter writer(payload);
+        entity::encodeRows<Entity>(writer, rows);
+    } else if (encoding == binary_encoding::Encoding::Cbor) {
+        binary_encoding::CborWriter writer(payload);
+        entity::encodeRows<Entity>(writer, rows);
+    } else {
+        entity::appendJsonArray<Entity>(payload, rows);
+    }
+    serializeTimer.stop();
+
+    res.code = 200;
+    res.set_header("Content-Type", binary_encoding::contentType(encoding));
+    StageTimer bodyTimer(Stage::Body);
+    res.body = std::move(payload);      // 큰 목록은 복사하지 않고 본문으로 넘김
+    bodyTimer.stop();
+    res.end();
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+const std::string* CrudRouter<Entity, Service, Middlewares...>::decodeBody(const crow::request& req, Row& row,
+                                                                          bool with_key) {
+    const auto& bodies = crudBodies<Entity>();
+    if (!entity_json::isJsonContentType(req.get_header_value("Content-Type"))) {
+        return &bodies.content_type;
+    }
+    auto json = crow::json::load(req.body);
+    if (json.error() || json.t() != crow::json::type::Object) {
+        return &bodies.invalid_json;
+    }
+
+    entity::FieldCheck check = entity_json::decode<Entity>(json, row, with_key);
+    return check ? nullptr : &entity::errorBody<Entity>(check);
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+void CrudRouter<Entity, Service, Middlewares...>::finish(crow::response& res, int code, const std::string& body) {
+    res.code = code;
+    res.set_header("Content-Type", "application/json");
+    StageTimer bodyTimer(Stage::Body);
+    res.write(body);
+    bodyTimer.stop();
+    res.end();
+}
+
+template<typename Entity, typename Service, typename... Middlewares>
+std::string CrudRouter<Entity, Service, Middlewares...>::successBody(const std::string& prefix, const std::string& id) {
+    std::string body = prefix;
+    export_format::appendJsonString(body, id);
+    body += "}";
+    return body;
+}
+
+// 명시적 인스턴스 선언
+template class CrudRouter<MemberEntity, MemberService, struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
+template class CrudRouter<ProductEntity, ProductService, struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
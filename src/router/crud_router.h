@@ -0,0 +1,70 @@
+#pragma once
+
+#include "crow.h"
+#include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include "../utils/request_context.h"
+#include "../utils/db_executor.h"
+#include "../utils/binary_encoding.h"
+#include "../utils/entity_fields.h"
+#include "async_dispatch.h"
+#include "entity_json.h"
+#include <string>
+#include <vector>
+
+// 엔티티 필드 기술자로부터 생성되는 CRUD 라우트.
+//   GET    <path>          목록 (Accept 에 따라 JSON, MessagePack, CBOR)
+//   GET    <path>/<id>     단건
+//   POST   <path>          생성
+//   PUT    <path>/<id>     수정
+//   DELETE <path>/<id>     삭제
+// 본문 검증, JSON 쓰기, 바이너리 인코딩은 Entity::fields 를 컴파일 타임에 펼쳐 만들고,
+// 오류 응답 본문은 처음 사용할 때 한 번 직렬화해 재사용한다.
+//
+// Service 는 getAllRows(), getRowById(id), addRow(row), updateRow(row), deleteRow(id) 를 제공해야 한다.
+template<typename Entity, typename Service, typename... Middlewares>
+class CrudRouter {
+public:
+    using Row = typename Entity::Row;
+
+private:
+    crow::App<Middlewares...>& app;
+    Service& service;
+    DbExecutor& executor;
+    std::string path;
+
+public:
+    CrudRouter(crow::App<Middlewares...>& app, Service& service, DbExecutor& executor, std::string path);
+
+    // CRUD 라우트 설정 (with_list 가 false 면 목록 라우트는 호출자가 직접 등록)
+    void setupRoutes(bool with_list = true);
+
+    // 모든 행 조회
+    void getAll(const crow::request& req, crow::response& res);
+
+    // 개별 행 조회
+    void getOne(const crow::request& req, crow::response& res, const std::string& id);
+
+    // 행 생성
+    void create(const crow::request& req, crow::response& res);
+
+    // 행 수정
+    void update(const crow::request& req, crow::response& res, const std::string& id);
+
+    // 행 삭제
+    void remove(const crow::request& req, crow::response& res, const std::string& id);
+
+    // 목록 응답 직렬화 및 쓰기 (Accept 에 따라 JSON, MessagePack, CBOR, 단계별 시간 측정 포함)
+    void writeRows(const crow::request& req, crow::response& res, const std::vector<Row>& rows);
+
+private:
+    // JSON 본문을 Row 로 읽고 검증 (with_key 가 false 면 키 필드는 건너뜀). 실패 시 오류 본문, 성공 시 nullptr
+    const std::string* decodeBody(const crow::request& req, Row& row, bool with_key);
+
+    // JSON 응답 쓰기 후 완료
+    void finish(crow::response& res, int code, const std::string& body);
+
+    // {"message": "<Entity> <action> successfully", "id": id}
+    std::string successBody(const std::string& prefix, const std::string& id);
+};
@@ -0,0 +1,247 @@
+#include "debug_router.h"
+#include <algorithm>
+#include <thread>
+
+template<typename... Middlewares>
+DebugRouter<Middlewares...>::DebugRouter(crow::App<Middlewares...>& app, std::shared_ptr<QueryInstrumentation> queries,
+                                         DbExecutor& executor, const AdminAccess& access)
+    : app(app), queryInstrumentation(queries), executor(executor), access(access) {
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::setupRoutes() {
+    // 쿼리 통계 조회 라우트 (GET)
+    CROW_ROUTE(app, "/debug/queries")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            getQueryStats(req, res);
+        }
+    });
+
+    // 쿼리 통계 초기화 라우트 (DELETE)
+    CROW_ROUTE(app, "/debug/queries")
+    .methods("DELETE"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            resetQueryStats(req, res);
+        }
+    });
+
+    // executor 상태 조회 라우트 (GET)
+    CROW_ROUTE(app, "/debug/executor")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            getExecutorStats(req, res);
+        }
+    });
+
+    // 할당 집계 조회 라우트 (GET)
+    CROW_ROUTE(app, "/debug/allocations")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            getAllocationStats(req, res);
+        }
+    });
+
+    // 할당 집계 초기화 라우트 (DELETE)
+    CROW_ROUTE(app, "/debug/allocations")
+    .methods("DELETE"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            resetAllocationStats(req, res);
+        }
+    });
+
+    // CPU 프로파일 라우트 (GET)
+    CROW_ROUTE(app, "/debug/profile")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        if (access.authorize(req, res)) {
+            getProfile(req, res);
+        }
+    });
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::getQueryStats(const crow::request& req, crow::response& res) {
+    size_t limit = 20;
+    if (const char* limit_param = req.url_params.get("limit")) {
+        try {
+            limit = static_cast<size_t>(std::max(1, std::stoi(limit_param)));
+        } catch (const std::exception&) {
+            // 잘못된 값이면 기본값 사용
+        }
+    }
+
+    std::vector<crow::json::wvalue> shapes_list;
+    for (const auto& stats : queryInstrumentation->topShapes(limit)) {
+        crow::json::wvalue shape_obj;
+        shape_obj["shape"] = stats.shape;
+        shape_obj["count"] = stats.count;
+        shape_obj["errors"] = stats.errors;
+        shape_obj["slow_count"] = stats.slow_count;
+        shape_obj["total_us"] = stats.total_us;
+        shape_obj["avg_us"] = stats.averageMicros();
+        shape_obj["p99_us"] = stats.percentileMicros(0.99);
+        shape_obj["max_us"] = stats.max_us;
+        shape_obj["last_explain"] = stats.last_explain;
+        shapes_list.push_back(std::move(shape_obj));
+    }
+
+    crow::json::wvalue body;
+    body["queries"] = std::move(shapes_list);
+
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    res.write(body.dump());
+    res.end();
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::resetQueryStats(const crow::request& /*req*/, crow::response& res) {
+    queryInstrumentation->reset();
+
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    res.write(crow::json::wvalue({
+        {"message", "Query statistics reset"}
+    }).dump());
+    res.end();
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::getExecutorStats(const crow::request& /*req*/, crow::response& res) {
+    DbExecutor::Stats stats = executor.stats();
+
+    std::vector<crow::json::wvalue> depths;
+    for (size_t depth : stats.worker_depths) {
+        depths.push_back(crow::json::wvalue(depth));
+    }
+
+    crow::json::wvalue body;
+    body["threads"] = stats.threads;
+    body["capacity"] = stats.capacity;
+    body["queued"] = stats.queued;
+    body["worker_depths"] = std::move(depths);
+    body["active"] = stats.active;
+    body["submitted"] = stats.submitted;
+    body["rejected"] = stats.rejected;
+    body["completed"] = stats.completed;
+    body["stolen"] = stats.stolen;
+    body["avg_wait_us"] = stats.avg_wait_us;
+    body["max_wait_us"] = stats.max_wait_us;
+
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    res.write(body.dump());
+    res.end();
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::getAllocationStats(const crow::request& /*req*/, crow::response& res) {
+    // 라우트별 집계는 operator new 계측 빌드에서만 채워진다
+    std::vector<crow::json::wvalue> routes_list;
+    for (const auto& stats : alloc_stats::routes()) {
+        std::vector<crow::json::wvalue> histogram;
+        for (size_t i = 0; i < stats.buckets.size(); ++i) {
+            if (stats.buckets[i] == 0) {
+                continue;
+            }
+            crow::json::wvalue bucket;
+            bucket["le"] = uint64_t(1) << i;
+            bucket["requests"] = stats.buckets[i];
+            histogram.push_back(std::move(bucket));
+        }
+
+        crow::json::wvalue route_obj;
+        route_obj["route"] = stats.route;
+        route_obj["requests"] = stats.requests;
+        route_obj["avg_allocations"] = stats.averageAllocations();
+        route_obj["p50_allocations"] = stats.percentileAllocations(0.5);
+        route_obj["p99_allocations"] = stats.percentileAllocations(0.99);
+        route_obj["max_allocations"] = stats.max_allocations;
+        route_obj["avg_bytes"] = stats.averageBytes();
+        route_obj["histogram"] = std::move(histogram);
+        routes_list.push_back(std::move(route_obj));
+    }
+
+    crow::json::wvalue gauges;
+    for (const auto& gauge : alloc_stats::gauges()) {
+        gauges[gauge.first] = gauge.second;
+    }
+
+    alloc_stats::ProcessHeap heap = alloc_stats::processHeap();
+    crow::json::wvalue process;
+    process["rss_bytes"] = heap.rss_bytes;
+    process["heap_in_use_bytes"] = heap.heap_in_use_bytes;
+    process["heap_free_bytes"] = heap.heap_free_bytes;
+    process["mmap_bytes"] = heap.mmap_bytes;
+
+    crow::json::wvalue body;
+    body["enabled"] = alloc_stats::enabled();
+    body["routes"] = std::move(routes_list);
+    body["gauges"] = std::move(gauges);
+    body["process"] = std::move(process);
+
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    res.write(body.dump());
+    res.end();
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::resetAllocationStats(const crow::request& /*req*/, crow::response& res) {
+    alloc_stats::reset();
+
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    res.write(crow::json::wvalue({
+        {"message", "Allocation statistics reset"}
+    }).dump());
+    res.end();
+}
+
+template<typename... Middlewares>
+void DebugRouter<Middlewares...>::getProfile(const crow::request& req, crow::response& res) {
+    int seconds = 10;
+    if (const char* seconds_param = req.url_params.get("seconds")) {
+        try {
+            seconds = std::max(1, std::stoi(seconds_param));
+        } catch (const std::exception&) {
+            // 잘못된 값이면 기본값 사용
+        }
+    }
+
+    // 수집 동안 I/O 스레드를 막지 않도록 별도 스레드에서 대기 (max_seconds 로 제한됨)
+    std::thread([&res, seconds] {
+        CpuProfiler::Profile profile;
+        CpuProfiler::Status status = CpuProfiler::instance().run(std::chrono::seconds(seconds), profile);
+        if (status != CpuProfiler::Status::Ok) {
+            res.code = status == CpuProfiler::Status::Busy ? 409 : status == CpuProfiler::Status::Disabled ? 404 : 500;
+            res.set_header("Content-Type", "application/json");
+            res.write(crow::json::wvalue({
+                {"error", std::string("Profiler ") + CpuProfiler::statusName(status)}
+            }).dump());
+            res.end();
+            return;
+        }
+
+        res.code = 200;
+        res.set_header("Content-Type", "text/plain; charset=utf-8");
+        res.set_header("X-Profile-Samples", std::to_string(profile.samples));
+        res.set_header("X-Profile-Dropped", std::to_string(profile.dropped));
+        res.set_header("X-Profile-Frequency", std::to_string(profile.frequency_hz));
+        res.set_header("X-Profile-Duration-Ms", std::to_string(profile.duration.count()));
+        res.body = std::move(profile.folded);
+        res.end();
+    }).detach();
+
+    // 요청 컨텍스트는 수집 스레드에서 완료되므로 I/O 스레드에서는 바인딩 해제
+    request_context::bind(nullptr);
+}
+
+// 명시적 인스턴스 선언
+template class DebugRouter<struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "crow.h"
+#include "admin_access.h"
+#include "../repository/query_instrumentation.h"
+#include "../utils/db_executor.h"
+#include "../utils/alloc_stats.h"
+#include "../utils/cpu_profiler.h"
+#include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include <memory>
+#include <string>
+
+template<typename... Middlewares>
+class DebugRouter {
+private:
+    crow::App<Middlewares...>& app;
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
+    DbExecutor& executor;
+    const AdminAccess& access;
+
+public:
+    DebugRouter(crow::App<Middlewares...>& app, std::shared_ptr<QueryInstrumentation> queries, DbExecutor& executor,
+                const AdminAccess& access);
+    
+    // 디버그 라우트들 설정 (모두 AdminAccess 를 통과해야 실행)
+    void setupRoutes();
+    
+    // 문장 형태별 쿼리 통계 조회 (누적 소요시간 상위 순)
+    void getQueryStats(const crow::request& req, crow::response& res);
+    
+    // 쿼리 통계 초기화
+    void resetQueryStats(const crow::request& req, crow::response& res);
+    
+    // DB executor 큐 길이 및 대기시간 조회
+    void getExecutorStats(const crow::request& req, crow::response& res);
+    
+    // 라우트별 요청당 할당 집계와 힙 게이지 조회
+    void getAllocationStats(const crow::request& req, crow::response& res);
+    
+    // 라우트별 할당 집계 초기화
+    void resetAllocationStats(const crow::request& req, crow::response& res);
+    
+    // seconds 동안 CPU 샘플링 후 folded stack 반환 (별도 스레드에서 수집)
+    void getProfile(const crow::request& req, crow::response& res);
+};
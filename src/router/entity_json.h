@@ -0,0 +1,63 @@
+#pragma once
+
+#include "crow.h"
+#include "../utils/entity_fields.h"
+#include <string>
+
+// 필드 기술자에 따라 JSON 객체를 Row 로 읽고 검증
+namespace entity_json {
+
+namespace detail {
+
+template<typename Row>
+entity::Violation readField(const entity::StringField<Row>& field, const crow::json::rvalue& value, Row& row) {
+    if (value.t() != crow::json::type::String) {
+        return entity::Violation::WrongType;
+    }
+    row.*(field.member) = value.s();
+    return entity::checkValue(field, row.*(field.member));
+}
+
+template<typename Row>
+entity::Violation readField(const entity::IntField<Row>& field, const crow::json::rvalue& value, Row& row) {
+    if (value.t() != crow::json::type::Number ||
+        (value.nt() != crow::json::num_type::Signed_integer && value.nt() != crow::json::num_type::Unsigned_integer)) {
+        return entity::Violation::WrongType;
+    }
+    int64_t number = value.i();
+    entity::Violation violation = entity::checkValue(field, number);
+    if (violation == entity::Violation::None) {
+        row.*(field.member) = static_cast<int32_t>(number);
+    }
+    return violation;
+}
+
+} // namespace detail
+
+// Content-Type 이 application/json 인지 (매개변수 허용)
+inline bool isJsonContentType(const std::string& value) {
+    static const std::string json = "application/json";
+    return value.compare(0, json.size(), json) == 0 &&
+           (value.size() == json.size() || value[json.size()] == ';');
+}
+
+// object 의 필드를 row 로 읽는다 (with_key 가 false 면 키 필드는 건너뜀). 첫 번째 위반 반환
+template<typename Entity>
+entity::FieldCheck decode(const crow::json::rvalue& object, typename Entity::Row& row, bool with_key) {
+    entity::FieldCheck check;
+    entity::allFields<Entity>([&](const auto& field, size_t index) {
+        if (index == 0 && !with_key) {
+            return true;
+        }
+        std::string name(field.name);
+        if (!object.has(name)) {
+            check = entity::FieldCheck{entity::Violation::Missing, index};
+            return false;
+        }
+        check = entity::FieldCheck{detail::readField(field, object[name], row), index};
+        return static_cast<bool>(check);
+    });
+    return check;
+}
+
+} // namespace entity_json
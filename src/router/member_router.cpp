@@ -1,293 +1,184 @@
 #include "member_router.h"
+#include <algorithm>
 
-template<typename Middleware>
-MemberRouter<Middleware>::MemberRouter(crow::App<Middleware>& app, MemberService& service) : app(app), memberService(service) {
+template<typename... Middlewares>
+MemberRouter<Middlewares...>::MemberRouter(crow::App<Middlewares...>& app, MemberService& service, DbExecutor& executor)
+    : app(app), memberService(service), executor(executor), crud(app, service, executor, "/members") {
     // Service는 생성자 매개변수로 전달받음
 }
 
-template<typename Middleware>
-void MemberRouter<Middleware>::setupRoutes() {
-    // 모든 멤버 조회 라우트 (GET)
-    CROW_ROUTE(app, "/members")
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::setupRoutes() {
+    // 멤버 내보내기 라우트 (GET)
+    CROW_ROUTE(app, "/members/export")
     .methods("GET"_method)
     ([this](const crow::request& req, crow::response& res){
-        getAllMembers(req, res);
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            exportMembers(req, res);
+        });
     });
 
-    // 멤버 생성 라우트 (POST)
-    CROW_ROUTE(app, "/members")
+    // 멤버 대량 적재 라우트 (POST)
+    CROW_ROUTE(app, "/members/import")
     .methods("POST"_method)
     ([this](const crow::request& req, crow::response& res){
-        createMember(req, res);
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            importMembers(req, res);
+        });
     });
 
-    // 개별 멤버 조회 라우트 (GET)
-    CROW_ROUTE(app, "/members/<string>")
+    // 멤버 집계 라우트 (GET). 메모리 집계만 읽으므로 executor 를 거치지 않는다.
+    CROW_ROUTE(app, "/members/stats")
     .methods("GET"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        getMember(req, res, id);
+    ([this](const crow::request& req, crow::response& res){
+        getMemberStats(req, res);
     });
 
-    // 멤버 업데이트 라우트 (PUT)
-    CROW_ROUTE(app, "/members/<string>")
-    .methods("PUT"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        updateMember(req, res, id);
+    // 멤버 이름 검색 라우트 (GET)
+    CROW_ROUTE(app, "/members/search")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            searchMembers(req, res);
+        });
     });
 
-    // 멤버 삭제 라우트 (DELETE)
-    CROW_ROUTE(app, "/members/<string>")
-    .methods("DELETE"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        deleteMember(req, res, id);
+    // 변경 이벤트 스트림 (Server-Sent Events). DB 를 사용하지 않으므로 executor 를 거치지 않는다.
+    CROW_ROUTE(app, "/members/stream")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        streamChanges(memberService.changes(), req, res);
     });
+
+    // 목록/개별 조회, 생성, 수정, 삭제는 필드 기술자로 생성된 CrudRouter 가 담당.
+    // 위의 고정 경로가 /<string> 보다 먼저 등록되도록 마지막에 호출한다.
+    crud.setupRoutes();
 }
 
-template<typename Middleware>
-void MemberRouter<Middleware>::getMember(const crow::request& /*req*/, crow::response& res, std::string id) {
-    if (memberService.memberExists(id)) {
-        auto member = memberService.getMemberById(id);
-        res.code = 200;
-        res.set_header("Content-Type", "application/json");
-        res.write(member.dump());
-    } else {
-        res.code = 404;
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::exportMembers(const crow::request& req, crow::response& res) {
+    const char* format_param = req.url_params.get("format");
+    export_format::Format format;
+    if (!export_format::parse(format_param ? format_param : "", format)) {
+        res.code = 400;
         res.set_header("Content-Type", "application/json");
         res.write(crow::json::wvalue({
-            {"error", "Member not found"}
+            {"error", "format must be ndjson or csv"}
         }).dump());
+        res.end();
+        return;
     }
-    res.end();
-}
-
-template<typename Middleware>
-void MemberRouter<Middleware>::getAllMembers(const crow::request& /*req*/, crow::response& res) {
-    // Service에서 모든 멤버 조회
-    auto members_list = memberService.getAllMembers();
-    
-    // vector를 wvalue로 변환 (복사 대신 이동 시맨틱 사용)
-    crow::json::wvalue members_array;
-    members_array = std::move(members_list);
     
-    res.code = 200;
-    res.set_header("Content-Type", "application/json");
-    res.write(members_array.dump());
-    res.end();
-}
-
-template<typename Middleware>
-void MemberRouter<Middleware>::createMember(const crow::request& req, crow::response& res) {
-    try {
-        // Content-Type 검증
-        if (req.get_header_value("Content-Type") != "application/json") {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Content-Type must be application/json"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // JSON 파싱
-        auto json_data = crow::json::load(req.body);
-        if (json_data.error()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Invalid JSON format"}
-            }).dump());
-            res.end();
-            return;
+    // 행을 하나씩 스풀 파일에 쓰고, Crow 가 파일을 청크 단위로 전송한다
+    std::ofstream out;
+    std::string path = exportSpool.create(export_format::extension(format), out);
+    bool exported = !path.empty() && memberService.exportMembers(out, format);
+    out.close();
+    if (!exported || out.fail()) {
+        if (!path.empty()) {
+            exportSpool.discard(path);
         }
-
-        // 필수 필드 존재 여부 검증
-        if (!json_data.has("id") || !json_data.has("name") || !json_data.has("gender")) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Missing required fields: id, name, gender"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // ID 추출 및 검증
-        std::string id = json_data["id"].s();
-        if (id.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "ID cannot be empty"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 이름 추출 및 검증
-        std::string name = json_data["name"].s();
-        if (name.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Name cannot be empty"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 성별 추출 및 검증
-        std::string gender = json_data["gender"].s();
-        if (gender.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Gender cannot be empty"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 멤버 데이터 생성
-        crow::json::wvalue member_data;
-        member_data["name"] = name;
-        member_data["gender"] = gender;
-
-        // Service를 통한 멤버 생성
-        if (memberService.addMember(id, member_data)) {
-            res.code = 201;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"message", "Member created successfully"},
-                {"id", id}
-            }).dump());
-        } else {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Member already exists or invalid data format"}
-            }).dump());
-        }
-    } catch (const std::exception& e) {
         res.code = 500;
         res.set_header("Content-Type", "application/json");
         res.write(crow::json::wvalue({
-            {"error", "Internal server error"}
+            {"error", "Export failed"}
         }).dump());
+        res.end();
+        return;
     }
-    res.end();
+    
+    res.set_static_file_info_unsafe(path);
+    res.set_header("Content-Type", export_format::contentType(format));
+    res.set_header("Content-Disposition", std::string("attachment; filename=\"members.") + export_format::extension(format) + "\"");
+    
+    // res.end() 는 Crow 의 complete_request 를 바로 실행해 파일을 끝까지 보낸 뒤 반환한다.
+    // 전송은 I/O 스레드에서 하고 (DB 워커는 바로 반환), 끝나면 스풀 파일을 삭제
+    endOnIoThread(req, res, [this, path] {
+        exportSpool.discard(path);
+    });
 }
 
-template<typename Middleware>
-void MemberRouter<Middleware>::updateMember(const crow::request& req, crow::response& res, std::string id) {
-    try {
-        // Content-Type 검증
-        if (req.get_header_value("Content-Type") != "application/json") {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Content-Type must be application/json"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // JSON 파싱
-        auto json_data = crow::json::load(req.body);
-        if (json_data.error()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Invalid JSON format"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 필수 필드 존재 여부 검증
-        if (!json_data.has("name") || !json_data.has("gender")) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Missing required fields: name, gender"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 이름 추출 및 검증
-        std::string name = json_data["name"].s();
-        if (name.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Name cannot be empty"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 성별 추출 및 검증
-        std::string gender = json_data["gender"].s();
-        if (gender.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Gender cannot be empty"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 멤버 데이터 생성
-        crow::json::wvalue member_data;
-        member_data["name"] = name;
-        member_data["gender"] = gender;
-
-        // Service를 통한 멤버 업데이트
-        if (memberService.updateMember(id, member_data)) {
-            res.code = 200;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"message", "Member updated successfully"},
-                {"id", id}
-            }).dump());
-        } else {
-            res.code = 404;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Member not found or invalid data format"}
-            }).dump());
-        }
-    } catch (const std::exception& e) {
-        res.code = 500;
-        res.set_header("Content-Type", "application/json");
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::importMembers(const crow::request& req, crow::response& res) {
+    const char* format_param = req.url_params.get("format");
+    const char* replace_param = req.url_params.get("replace");
+    export_format::Format format;
+    res.set_header("Content-Type", "application/json");
+    if (!export_format::parse(format_param ? format_param : "", format)) {
+        res.code = 400;
         res.write(crow::json::wvalue({
-            {"error", "Internal server error"}
+            {"error", "format must be ndjson or csv"}
         }).dump());
+        res.end();
+        return;
     }
+    
+    bool replace = replace_param && std::string(replace_param) == "true";
+    ImportResult result = memberService.importMembers(req.body, format, replace);
+    if (!result.success) {
+        res.code = result.disabled ? 403 : 400;
+        res.write(crow::json::wvalue({
+            {"error", result.error}
+        }).dump());
+        res.end();
+        return;
+    }
+    
+    res.code = 200;
+    res.write(crow::json::wvalue({
+        {"imported", result.rows},
+        {"rejected_lines", result.rejected_lines},
+        {"warnings", result.warnings}
+    }).dump());
     res.end();
 }
 
-template<typename Middleware>
-void MemberRouter<Middleware>::deleteMember(const crow::request& /*req*/, crow::response& res, std::string id) {
-    // Service를 통한 멤버 삭제
-    if (memberService.deleteMember(id)) {
-        res.code = 200;
-        res.set_header("Content-Type", "application/json");
-        res.write(crow::json::wvalue({
-            {"message", "Member deleted successfully"},
-            {"id", id}
-        }).dump());
-    } else {
-        res.code = 404;
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::getMemberStats(const crow::request& /*req*/, crow::response& res) {
+    auto stats = memberService.getMemberStats();
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    writeJson(res, stats);
+    res.end();
+}
+
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::searchMembers(const crow::request& req, crow::response& res) {
+    const char* query = req.url_params.get("q");
+    if (query == nullptr || std::string(query).empty()) {
+        res.code = 400;
         res.set_header("Content-Type", "application/json");
         res.write(crow::json::wvalue({
-            {"error", "Member not found"}
+            {"error", "Query parameter q is required"}
         }).dump());
+        res.end();
+        return;
     }
-    res.end();
+    
+    // 결과 수 제한 (기본 20, 최대 100)
+    size_t limit = 20;
+    if (const char* limit_param = req.url_params.get("limit")) {
+        try {
+            limit = static_cast<size_t>(std::clamp(std::stoi(limit_param), 1, 100));
+        } catch (const std::exception&) {
+            limit = 20;
+        }
+    }
+    
+    // 목록 조회와 같은 경로로 직렬화 (wvalue 트리를 만들지 않음)
+    crud.writeRows(req, res, memberService.searchMembers(query, limit));
+}
+
+template<typename... Middlewares>
+void MemberRouter<Middlewares...>::writeJson(crow::response& res, const crow::json::wvalue& body) {
+    // 직렬화와 본문 설정 시간을 각각 기록
+    StageTimer serializeTimer(Stage::Serialize);
+    std::string payload = body.dump();
+    serializeTimer.stop();
+
+    StageTimer bodyTimer(Stage::Body);
+    res.write(payload);
 }
 
 // 명시적 인스턴스 선언
-template class MemberRouter<struct AccessLogMiddleware>;
+template class MemberRouter<struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
@@ -3,32 +3,44 @@
 #include "crow.h"
 #include "../service/member_service.h"
 #include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include "../utils/request_context.h"
+#include "../utils/db_executor.h"
+#include "async_dispatch.h"
+#include "change_stream.h"
+#include "../utils/export_spool.h"
+#include "crud_router.h"
 #include <string>
 
-template<typename Middleware>
+template<typename... Middlewares>
 class MemberRouter {
 private:
-    crow::App<Middleware>& app;
+    crow::App<Middlewares...>& app;
     MemberService& memberService;
+    DbExecutor& executor;
+    ExportSpool exportSpool{"members"};
+    CrudRouter<MemberEntity, MemberService, Middlewares...> crud;
 
 public:
-    MemberRouter(crow::App<Middleware>& app, MemberService& service);
+    MemberRouter(crow::App<Middlewares...>& app, MemberService& service, DbExecutor& executor);
     
     // 멤버 관련 라우트들 설정
     void setupRoutes();
     
-    // 개별 멤버 조회
-    void getMember(const crow::request& req, crow::response& res, std::string id);
+    // 전체 멤버 내보내기 (format=ndjson|csv)
+    void exportMembers(const crow::request& req, crow::response& res);
     
-    // 모든 멤버 조회
-    void getAllMembers(const crow::request& req, crow::response& res);
+    // 멤버 대량 적재 (format=ndjson|csv, replace=true 이면 같은 ID 교체)
+    void importMembers(const crow::request& req, crow::response& res);
     
-    // 멤버 생성
-    void createMember(const crow::request& req, crow::response& res);
+    // 멤버 집계 조회
+    void getMemberStats(const crow::request& req, crow::response& res);
     
-    // 멤버 업데이트
-    void updateMember(const crow::request& req, crow::response& res, std::string id);
-    
-    // 멤버 삭제
-    void deleteMember(const crow::request& req, crow::response& res, std::string id);
+    // 이름 검색 (q, limit 쿼리)
+    void searchMembers(const crow::request& req, crow::response& res);
+
+private:
+    // JSON 응답 본문 직렬화 및 쓰기 (단계별 시간 측정 포함)
+    void writeJson(crow::response& res, const crow::json::wvalue& body);
 };
@@ -1,202 +1,236 @@
 #include "product_router.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 
-template<typename Middleware>
-ProductRouter<Middleware>::ProductRouter(crow::App<Middleware>& app, ProductService& service) : app(app), productService(service) {
+namespace {
+
+// 쿼리 값 전체가 int32 정수여야 한다 ("12abc", 빈 값, 범위 초과는 실패)
+bool parsePrice(const char* text, int32_t& out) {
+    const char* end = text + std::strlen(text);
+    auto result = std::from_chars(text, end, out);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+} // namespace
+
+template<typename... Middlewares>
+ProductRouter<Middlewares...>::ProductRouter(crow::App<Middlewares...>& app, ProductService& service, DbExecutor& executor)
+    : app(app), productService(service), executor(executor), crud(app, service, executor, "/products") {
     // Service는 생성자 매개변수로 전달받음
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::setupRoutes() {
-    // 모든 제품 조회 라우트 (GET)
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::setupRoutes() {
+    // 모든 제품 조회 라우트 (GET). 필터 쿼리를 처리하므로 CrudRouter 대신 직접 등록
     CROW_ROUTE(app, "/products")
     .methods("GET"_method)
     ([this](const crow::request& req, crow::response& res){
-        getAllProducts(req, res);
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            getAllProducts(req, res);
+        });
     });
 
-    // 제품 생성 라우트 (POST)
-    CROW_ROUTE(app, "/products")
+    // 제품 내보내기 라우트 (GET)
+    CROW_ROUTE(app, "/products/export")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            exportProducts(req, res);
+        });
+    });
+
+    // 제품 대량 적재 라우트 (POST)
+    CROW_ROUTE(app, "/products/import")
     .methods("POST"_method)
     ([this](const crow::request& req, crow::response& res){
-        createProduct(req, res);
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            importProducts(req, res);
+        });
     });
 
-    // 개별 제품 조회 라우트 (GET)
-    CROW_ROUTE(app, "/products/<string>")
+    // 제품 집계 라우트 (GET). 메모리 집계만 읽으므로 executor 를 거치지 않는다.
+    CROW_ROUTE(app, "/products/stats")
     .methods("GET"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        getProduct(req, res, id);
+    ([this](const crow::request& req, crow::response& res){
+        getProductStats(req, res);
     });
 
-    // 제품 업데이트 라우트 (PUT)
-    CROW_ROUTE(app, "/products/<string>")
-    .methods("PUT"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        updateProduct(req, res, id);
+    // 제품 이름 검색 라우트 (GET)
+    CROW_ROUTE(app, "/products/search")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        dispatchToExecutor(executor, res, [this, &req, &res] {
+            searchProducts(req, res);
+        });
     });
 
-    // 제품 삭제 라우트 (DELETE)
-    CROW_ROUTE(app, "/products/<string>")
-    .methods("DELETE"_method)
-    ([this](const crow::request& req, crow::response& res, std::string id){
-        deleteProduct(req, res, id);
+    // 변경 이벤트 스트림 (Server-Sent Events). DB 를 사용하지 않으므로 executor 를 거치지 않는다.
+    CROW_ROUTE(app, "/products/stream")
+    .methods("GET"_method)
+    ([this](const crow::request& req, crow::response& res){
+        streamChanges(productService.changes(), req, res);
     });
+
+    // 목록/개별 조회, 생성, 수정, 삭제는 필드 기술자로 생성된 CrudRouter 가 담당.
+    // 위의 고정 경로가 /<string> 보다 먼저 등록되도록 마지막에 호출한다.
+    crud.setupRoutes(false);
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::getProduct(const crow::request& /*req*/, crow::response& res, std::string id) {
-    if (productService.productExists(id)) {
-        auto product = productService.getProductById(id);
-        res.code = 200;
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::exportProducts(const crow::request& req, crow::response& res) {
+    const char* format_param = req.url_params.get("format");
+    export_format::Format format;
+    if (!export_format::parse(format_param ? format_param : "", format)) {
+        res.code = 400;
         res.set_header("Content-Type", "application/json");
-        res.write(product.dump());
-    } else {
-        res.code = 404;
+        res.write(crow::json::wvalue({
+            {"error", "format must be ndjson or csv"}
+        }).dump());
+        res.end();
+        return;
+    }
+    
+    // 행을 하나씩 스풀 파일에 쓰고, Crow 가 파일을 청크 단위로 전송한다
+    std::ofstream out;
+    std::string path = exportSpool.create(export_format::extension(format), out);
+    bool exported = !path.empty() && productService.exportProducts(out, format);
+    out.close();
+    if (!exported || out.fail()) {
+        if (!path.empty()) {
+            exportSpool.discard(path);
+        }
+        res.code = 500;
         res.set_header("Content-Type", "application/json");
         res.write(crow::json::wvalue({
-            {"error", "Product not found"}
+            {"error", "Export failed"}
         }).dump());
+        res.end();
+        return;
     }
-    res.end();
+    
+    res.set_static_file_info_unsafe(path);
+    res.set_header("Content-Type", export_format::contentType(format));
+    res.set_header("Content-Disposition", std::string("attachment; filename=\"products.") + export_format::extension(format) + "\"");
+    
+    // res.end() 는 Crow 의 complete_request 를 바로 실행해 파일을 끝까지 보낸 뒤 반환한다.
+    // 전송은 I/O 스레드에서 하고 (DB 워커는 바로 반환), 끝나면 스풀 파일을 삭제
+    endOnIoThread(req, res, [this, path] {
+        exportSpool.discard(path);
+    });
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::getAllProducts(const crow::request& /*req*/, crow::response& res) {
-    // Service에서 모든 제품 조회
-    auto products_list = productService.getAllProducts();
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::importProducts(const crow::request& req, crow::response& res) {
+    const char* format_param = req.url_params.get("format");
+    const char* replace_param = req.url_params.get("replace");
+    export_format::Format format;
+    res.set_header("Content-Type", "application/json");
+    if (!export_format::parse(format_param ? format_param : "", format)) {
+        res.code = 400;
+        res.write(crow::json::wvalue({
+            {"error", "format must be ndjson or csv"}
+        }).dump());
+        res.end();
+        return;
+    }
     
-    // vector를 wvalue로 변환
-    crow::json::wvalue products_array(std::move(products_list));
+    bool replace = replace_param && std::string(replace_param) == "true";
+    ImportResult result = productService.importProducts(req.body, format, replace);
+    if (!result.success) {
+        res.code = result.disabled ? 403 : 400;
+        res.write(crow::json::wvalue({
+            {"error", result.error}
+        }).dump());
+        res.end();
+        return;
+    }
     
     res.code = 200;
-    res.set_header("Content-Type", "application/json");
-    res.write(products_array.dump());
+    res.write(crow::json::wvalue({
+        {"imported", result.rows},
+        {"rejected_lines", result.rejected_lines},
+        {"warnings", result.warnings}
+    }).dump());
     res.end();
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::createProduct(const crow::request& req, crow::response& res) {
-    try {
-        // JSON 파싱
-        auto json_data = crow::json::load(req.body);
-        if (json_data.error()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Invalid JSON format"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // ID 추출
-        std::string id = json_data["id"].s();
-        if (id.empty()) {
-            res.code = 400;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "ID is required"}
-            }).dump());
-            res.end();
-            return;
-        }
-
-        // 제품 데이터 생성
-        crow::json::wvalue product_data;
-        product_data["name"] = json_data["name"].s();
-        product_data["price"] = json_data["price"].i();
-        product_data["category"] = json_data["category"].s();
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::getProductStats(const crow::request& /*req*/, crow::response& res) {
+    auto stats = productService.getProductStats();
+    res.code = 200;
+    res.set_header("Content-Type", "application/json");
+    writeJson(res, stats);
+    res.end();
+}
 
-        // Service를 통한 제품 생성
-        if (productService.addProduct(id, product_data)) {
-            res.code = 201;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"message", "Product created successfully"},
-                {"id", id}
-            }).dump());
-        } else {
-            res.code = 409;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Product already exists or invalid data"}
-            }).dump());
-        }
-    } catch (const std::exception& e) {
-        res.code = 500;
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::searchProducts(const crow::request& req, crow::response& res) {
+    const char* query = req.url_params.get("q");
+    if (query == nullptr || std::string(query).empty()) {
+        res.code = 400;
         res.set_header("Content-Type", "application/json");
         res.write(crow::json::wvalue({
-            {"error", "Internal server error"}
+            {"error", "Query parameter q is required"}
         }).dump());
+        res.end();
+        return;
     }
-    res.end();
+    
+    // 결과 수 제한 (기본 20, 최대 100)
+    size_t limit = 20;
+    if (const char* limit_param = req.url_params.get("limit")) {
+        try {
+            limit = static_cast<size_t>(std::clamp(std::stoi(limit_param), 1, 100));
+        } catch (const std::exception&) {
+            limit = 20;
+        }
+    }
+    
+    // 목록 조회와 같은 경로로 직렬화 (wvalue 트리를 만들지 않음)
+    crud.writeRows(req, res, productService.searchProducts(query, limit));
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::updateProduct(const crow::request& req, crow::response& res, std::string id) {
-    try {
-        // JSON 파싱
-        auto json_data = crow::json::load(req.body);
-        if (json_data.error()) {
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::getAllProducts(const crow::request& req, crow::response& res) {
+    const char* category = req.url_params.get("category");
+    const char* min_price = req.url_params.get("min_price");
+    const char* max_price = req.url_params.get("max_price");
+    
+    bool filtered = category || min_price || max_price;
+    ProductFilter filter;
+    if (filtered) {
+        // 필터 조건이 있으면 컬럼형 스냅샷에서 조회
+        if (category) {
+            filter.category = category;
+        }
+        if ((min_price && !parsePrice(min_price, filter.min_price)) ||
+            (max_price && !parsePrice(max_price, filter.max_price))) {
             res.code = 400;
             res.set_header("Content-Type", "application/json");
             res.write(crow::json::wvalue({
-                {"error", "Invalid JSON format"}
+                {"error", "min_price and max_price must be integers"}
             }).dump());
             res.end();
             return;
         }
-
-        // 제품 데이터 생성
-        crow::json::wvalue product_data;
-        product_data["name"] = json_data["name"].s();
-        product_data["price"] = json_data["price"].i();
-        product_data["category"] = json_data["category"].s();
-
-        // Service를 통한 제품 업데이트
-        if (productService.updateProduct(id, product_data)) {
-            res.code = 200;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"message", "Product updated successfully"},
-                {"id", id}
-            }).dump());
-        } else {
-            res.code = 404;
-            res.set_header("Content-Type", "application/json");
-            res.write(crow::json::wvalue({
-                {"error", "Product not found or invalid data"}
-            }).dump());
-        }
-    } catch (const std::exception& e) {
-        res.code = 500;
-        res.set_header("Content-Type", "application/json");
-        res.write(crow::json::wvalue({
-            {"error", "Internal server error"}
-        }).dump());
     }
-    res.end();
+    
+    // 필터 조건이 없으면 전체 조회. 직렬화는 필드 기술자로 생성된 경로를 사용
+    auto products = filtered ? productService.filterProductRows(filter) : productService.getAllRows();
+    crud.writeRows(req, res, products);
 }
 
-template<typename Middleware>
-void ProductRouter<Middleware>::deleteProduct(const crow::request& /*req*/, crow::response& res, std::string id) {
-    // Service를 통한 제품 삭제
-    if (productService.deleteProduct(id)) {
-        res.code = 200;
-        res.set_header("Content-Type", "application/json");
-        res.write(crow::json::wvalue({
-            {"message", "Product deleted successfully"},
-            {"id", id}
-        }).dump());
-    } else {
-        res.code = 404;
-        res.set_header("Content-Type", "application/json");
-        res.write(crow::json::wvalue({
-            {"error", "Product not found"}
-        }).dump());
-    }
-    res.end();
+template<typename... Middlewares>
+void ProductRouter<Middlewares...>::writeJson(crow::response& res, const crow::json::wvalue& body) {
+    // 직렬화와 본문 설정 시간을 각각 기록
+    StageTimer serializeTimer(Stage::Serialize);
+    std::string payload = body.dump();
+    serializeTimer.stop();
+
+    StageTimer bodyTimer(Stage::Body);
+    res.write(payload);
 }
 
 // 명시적 인스턴스 선언
-template class ProductRouter<struct AccessLogMiddleware>;
+template class ProductRouter<struct AccessLogMiddleware, struct RateLimitMiddleware, struct AdmissionMiddleware>;
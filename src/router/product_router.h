@@ -3,32 +3,47 @@
 #include "crow.h"
 #include "../service/product_service.h"
 #include "../middleware/access_log_middleware.h"
+#include "../middleware/admission_middleware.h"
+#include "../middleware/rate_limit_middleware.h"
+#include "../utils/request_context.h"
+#include "../utils/db_executor.h"
+#include "async_dispatch.h"
+#include "change_stream.h"
+#include "../utils/export_spool.h"
+#include "crud_router.h"
 #include <string>
 
-template<typename Middleware>
+template<typename... Middlewares>
 class ProductRouter {
 private:
-    crow::App<Middleware>& app;
+    crow::App<Middlewares...>& app;
     ProductService& productService;
+    DbExecutor& executor;
+    ExportSpool exportSpool{"products"};
+    CrudRouter<ProductEntity, ProductService, Middlewares...> crud;
 
 public:
-    ProductRouter(crow::App<Middleware>& app, ProductService& service);
+    ProductRouter(crow::App<Middlewares...>& app, ProductService& service, DbExecutor& executor);
     
     // 제품 관련 라우트들 설정
     void setupRoutes();
     
-    // 개별 제품 조회
-    void getProduct(const crow::request& req, crow::response& res, std::string id);
+    // 전체 제품 내보내기 (format=ndjson|csv)
+    void exportProducts(const crow::request& req, crow::response& res);
     
-    // 모든 제품 조회
-    void getAllProducts(const crow::request& req, crow::response& res);
+    // 제품 대량 적재 (format=ndjson|csv, replace=true 이면 같은 ID 교체)
+    void importProducts(const crow::request& req, crow::response& res);
     
-    // 제품 생성
-    void createProduct(const crow::request& req, crow::response& res);
+    // 제품 집계 조회
+    void getProductStats(const crow::request& req, crow::response& res);
     
-    // 제품 업데이트
-    void updateProduct(const crow::request& req, crow::response& res, std::string id);
+    // 이름 검색 (q, limit 쿼리)
+    void searchProducts(const crow::request& req, crow::response& res);
     
-    // 제품 삭제
-    void deleteProduct(const crow::request& req, crow::response& res, std::string id);
+    // 모든 제품 조회 (category, min_price, max_price 쿼리로 필터링, Accept 에 따라 JSON, MessagePack, CBOR)
+    void getAllProducts(const crow::request& req, crow::response& res);
+
+private:
+    // JSON 응답 본문 직렬화 및 쓰기 (단계별 시간 측정 포함)
+    void writeJson(crow::response& res, const crow::json::wvalue& body);
 };
@@ -0,0 +1,137 @@
+#include "batch_service.h"
+#include "../repository/mysql_transaction.h"
+#include <mysql/mysqld_error.h>
+#include <functional>
+#include <iostream>
+#include <optional>
+
+namespace {
+
+// 작업 하나를 트랜잭션 안에서 실행하고 상태 코드 반환.
+// 성공하면 커밋 후 적용할 메모리 갱신을 effects 에 추가한다.
+template<typename Entity, typename Service>
+int applyOperation(MySQLTransaction& transaction, Service& service, BatchOperation::Kind kind,
+                   const typename Entity::Row& row, const std::string& id,
+                   std::vector<std::function<void()>>& effects, std::string& error) {
+    using Row = typename Entity::Row;
+    std::string name(Entity::singular);
+
+    if (kind == BatchOperation::Kind::Create) {
+        if (!transaction.insert<Entity>(row)) {
+            if (transaction.errorNumber() == ER_DUP_ENTRY) {
+                error = name + " already exists";
+                return 409;
+            }
+            error = transaction.errorMessage();
+            return 500;
+        }
+        effects.push_back([&service, row] { service.recordAdded(row); });
+        return 201;
+    }
+
+    // 수정/삭제는 변경 전 행을 잠그고 확인 (집계 갱신에도 사용)
+    std::optional<Row> previous;
+    if (!transaction.lockById<Entity>(id, previous)) {
+        error = transaction.errorMessage();
+        return 500;
+    }
+    if (!previous) {
+        error = name + " not found";
+        return 404;
+    }
+
+    if (kind == BatchOperation::Kind::Update) {
+        if (!transaction.update<Entity>(row)) {
+            error = transaction.errorMessage();
+            return 500;
+        }
+        effects.push_back([&service, before = *previous, row] { service.recordUpdated(before, row); });
+        return 200;
+    }
+
+    if (!transaction.remove<Entity>(id)) {
+        error = transaction.errorMessage();
+        return 500;
+    }
+    effects.push_back([&service, before = *previous] { service.recordDeleted(before); });
+    return 200;
+}
+
+} // namespace
+
+BatchService::BatchService(std::shared_ptr<MySQLConnectionPool> pool, std::shared_ptr<QueryInstrumentation> queries,
+                           MemberService& members, ProductService& products)
+    : connectionPool(pool), queryInstrumentation(queries), memberService(members), productService(products) {
+}
+
+BatchOutcome BatchService::execute(const std::vector<BatchOperation>& operations) {
+    BatchOutcome outcome;
+    outcome.statuses.assign(operations.size(), 0);
+    if (!validate(operations, outcome)) {
+        return outcome;
+    }
+
+    std::vector<std::function<void()>> effects;
+    {
+        // 모든 문장이 같은 연결에서 실행되도록 트랜잭션 동안 연결을 고정
+        MySQLTransaction transaction(*connectionPool, queryInstrumentation);
+        if (!transaction.begin()) {
+            outcome.error = transaction.errorMessage();
+            return outcome;
+        }
+
+        for (size_t i = 0; i < operations.size(); ++i) {
+            const BatchOperation& op = operations[i];
+            int status = op.target == BatchOperation::Target::Member
+                ? applyOperation<MemberEntity>(transaction, memberService, op.kind, op.member, op.id, effects, outcome.error)
+                : applyOperation<ProductEntity>(transaction, productService, op.kind, op.product, op.id, effects, outcome.error);
+            outcome.statuses[i] = status;
+            if (status >= 400) {
+                outcome.failed_index = i;
+                transaction.rollback();
+                return outcome;
+            }
+        }
+
+        if (!transaction.commit()) {
+            outcome.failed_index = operations.size();
+            outcome.error = transaction.errorMessage();
+            return outcome;
+        }
+    }
+    outcome.committed = true;
+
+    // 고정했던 연결을 돌려준 뒤 적용한다 (연결을 쥔 채 다른 연결을 기다리지 않도록).
+    // 이미 커밋되었으므로 하나가 실패해도 나머지는 계속 적용하고 응답은 성공으로 둔다
+    for (auto& effect : effects) {
+        try {
+            effect();
+        } catch (const std::exception& e) {
+            std::cerr << "Failed to apply batch effect after commit: " << e.what() << std::endl;
+        }
+    }
+    return outcome;
+}
+
+bool BatchService::validate(const std::vector<BatchOperation>& operations, BatchOutcome& outcome) {
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const BatchOperation& op = operations[i];
+        bool valid;
+        if (op.kind == BatchOperation::Kind::Delete) {
+            valid = op.target == BatchOperation::Target::Member
+                ? static_cast<bool>(entity::checkKey<MemberEntity>(op.id))
+                : static_cast<bool>(entity::checkKey<ProductEntity>(op.id));
+        } else {
+            valid = op.target == BatchOperation::Target::Member
+                ? memberService.validateMember(op.member)
+                : productService.validateProduct(op.product);
+        }
+        if (!valid) {
+            outcome.failed_index = i;
+            outcome.statuses[i] = 400;
+            outcome.error = "Invalid data";
+            return false;
+        }
+    }
+    return true;
+}
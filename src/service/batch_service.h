@@ -0,0 +1,50 @@
+#pragma once
+
+#include "member_service.h"
+#include "product_service.h"
+#include "../repository/mysql_connection_pool.h"
+#include "../repository/query_instrumentation.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// 일괄 처리 작업 하나 (target 에 따라 member 또는 product 사용)
+struct BatchOperation {
+    enum class Kind { Create, Update, Delete };
+    enum class Target { Member, Product };
+
+    Kind kind = Kind::Create;
+    Target target = Target::Member;
+    std::string id;
+    MemberRow member;
+    ProductRow product;
+};
+
+// 일괄 처리 결과
+struct BatchOutcome {
+    bool committed = false;
+    size_t failed_index = 0;        // committed 가 false 일 때 실패한 작업 위치
+    std::vector<int> statuses;      // 작업별 상태 코드 (실행되지 않은 작업은 0)
+    std::string error;
+};
+
+// 여러 도메인의 작업을 고정된 연결 하나에서 한 트랜잭션으로 실행한다.
+// 하나라도 실패하면 전부 롤백하고, 메모리 상태(검색 색인, 집계, 스냅샷)는 커밋 후에만 갱신한다.
+class BatchService {
+private:
+    std::shared_ptr<MySQLConnectionPool> connectionPool;
+    std::shared_ptr<QueryInstrumentation> queryInstrumentation;
+    MemberService& memberService;
+    ProductService& productService;
+
+public:
+    BatchService(std::shared_ptr<MySQLConnectionPool> pool, std::shared_ptr<QueryInstrumentation> queries,
+                 MemberService& members, ProductService& products);
+
+    // 작업을 순서대로 실행 (전부 성공하면 커밋, 아니면 롤백)
+    BatchOutcome execute(const std::vector<BatchOperation>& operations);
+
+private:
+    // 트랜잭션 시작 전 작업별 검증 (실패 시 400)
+    bool validate(const std::vector<BatchOperation>& operations, BatchOutcome& outcome);
+};
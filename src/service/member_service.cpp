@@ -1,94 +1,245 @@
 #include "member_service.h"
+#include <iostream>
 
-MemberService::MemberService(MySQLMemberRepository& repository) : memberRepository(repository) {
+MemberService::MemberService(MySQLMemberRepository& repository)
+    : memberRepository(repository),
+      rowLoader([this](const std::vector<std::string>& ids) {
+          std::unordered_map<std::string, MemberRow> rows;
+          if (ids.size() == 1) {
+              // 모인 키가 하나면 기존 단건 쿼리 사용
+              if (auto row = memberRepository.getMemberById(ids.front())) {
+                  rows.emplace(ids.front(), std::move(*row));
+              }
+              return rows;
+          }
+          // 요청한 키별로 묶여 온다 (대소문자만 다른 키도 같은 행을 받는다)
+          return memberRepository.getMembersByIds(ids);
+      }),
+      searchCache({
+          [this] { return memberRepository.getAllMemberRows(); },
+          [this](CacheSnapshot::Watermark& watermark) { return memberRepository.getWatermark(watermark); },
+          [this](int64_t since, std::vector<MemberRow>& rows) { return memberRepository.getMembersUpdatedSince(since, rows); }
+      }) {
     // Repository는 생성자 매개변수로 전달받음
 }
 
-std::vector<crow::json::wvalue> MemberService::getAllMembers() {
-    return memberRepository.getAllMembers();
+std::vector<MemberRow> MemberService::getAllRows() {
+    try {
+        auto rows = allRowLookups.run("", [this] {
+            return memberRepository.getAllMemberRows();
+        });
+        lastAllRows.store("", rows);
+        return rows;
+    } catch (const DatabaseUnavailableError&) {
+        auto hit = lastAllRows.lookup("", std::chrono::seconds(stale_max_age_seconds.load()));
+        if (!hit) {
+            throw;
+        }
+        request_context::markStale(hit->age);
+        return std::move(hit->value);
+    }
 }
 
-crow::json::wvalue MemberService::getMemberById(const std::string& id) {
+std::optional<MemberRow> MemberService::getRowById(const std::string& id) {
     if (!validateId(id)) {
-        return crow::json::wvalue();
+        return std::nullopt;
+    }
+    try {
+        auto row = byIdLookups.run(id, [this, &id] {
+            return rowLoader.load(id);
+        });
+        if (row) {
+            lastRowById.store(id, *row);
+        }
+        return row;
+    } catch (const DatabaseUnavailableError&) {
+        auto hit = lastRowById.lookup(id, std::chrono::seconds(stale_max_age_seconds.load()));
+        if (!hit) {
+            throw;
+        }
+        request_context::markStale(hit->age);
+        return std::move(hit->value);
     }
-    return memberRepository.getMemberById(id);
 }
 
-bool MemberService::memberExists(const std::string& id) {
-    if (!validateId(id)) {
-        return false;
+void MemberService::setStaleMaxAge(std::chrono::seconds max_age) {
+    stale_max_age_seconds = max_age.count();
+}
+
+void MemberService::configureBatching(const BatchLoader<std::string, MemberRow>::Settings& settings) {
+    rowLoader.configure(settings);
+}
+
+size_t MemberService::cachedRows() {
+    return lastRowById.size() + searchCache.size();
+}
+
+std::vector<MemberRow> MemberService::searchMembers(const std::string& query, size_t limit) {
+    std::vector<MemberRow> members;
+    searchCache.search(query, limit, [&](const MemberRow& row) {
+        members.push_back(row);
+    });
+    return members;
+}
+
+crow::json::wvalue MemberService::getMemberStats() {
+    crow::json::wvalue stats;
+    stats["genders"] = crow::json::wvalue::object();
+    int64_t total = 0;
+    for (const auto& entry : genderCounts.snapshot()) {
+        stats["genders"][entry.first] = entry.second;
+        total += entry.second;
     }
-    return memberRepository.memberExists(id);
+    stats["total"] = total;
+    return stats;
 }
 
-bool MemberService::addMember(const std::string& id, const crow::json::wvalue& member) {
+bool MemberService::reseedStats() {
+    // 집계를 읽는 동안 쓰기가 있었다면 결과가 어긋나므로 몇 번 다시 시도
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        uint64_t version = genderCounts.currentVersion();
+        std::map<std::string, int64_t> seeded;
+        if (!memberRepository.getCountsByGender(seeded)) {
+            return false;
+        }
+        if (genderCounts.reset(seeded, version)) {
+            return true;
+        }
+    }
+    std::cerr << "Member stats reseed skipped: concurrent writes" << std::endl;
+    return false;
+}
+
+bool MemberService::exportMembers(std::ostream& out, export_format::Format format) {
+    if (format == export_format::Format::Csv) {
+        out << "id,name,gender\n";
+    }
+    
+    std::string line;
+    bool completed = memberRepository.streamAllMembers([&](const MemberRow& row) {
+        line.clear();
+        if (format == export_format::Format::Csv) {
+            export_format::appendCsvField(line, row.id);
+            line.push_back(',');
+            export_format::appendCsvField(line, row.name);
+            line.push_back(',');
+            export_format::appendCsvField(line, row.gender);
+            line.push_back('\n');
+        } else {
+            entity::appendJson<MemberEntity>(line, row);
+            line.push_back('\n');
+        }
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    });
+    return completed && out.good();
+}
+
+ImportResult MemberService::importMembers(const std::string& body, export_format::Format format, bool replace) {
+    auto source = LocalInfileSource::forEntity<MemberEntity>(body, format);
+    ImportResult result = memberRepository.importMembers(source, replace);
+    if (result.success) {
+        // 서비스를 거치지 않은 대량 변경이므로 메모리 상태를 DB 기준으로 다시 구성
+        lastAllRows.erase("");
+        searchCache.reset();
+        reseedStats();
+        changeFeed.publish("reset", "{\"reason\":\"import\"}");
+    }
+    return result;
+}
+
+bool MemberService::addRow(const MemberRow& member) {
     // 입력 검증
-    if (!validateId(id) || !validateMember(member)) {
+    if (!validateMember(member)) {
         return false;
     }
     
-    // 중복 ID 체크
-    if (memberRepository.memberExists(id)) {
+    // 멤버 추가 (중복 ID 는 기본 키 제약으로 실패)
+    if (!memberRepository.addMember(member)) {
         return false;
     }
-    
-    // 멤버 추가
-    memberRepository.addMember(id, member);
+    recordAdded(member);
     return true;
 }
 
-bool MemberService::updateMember(const std::string& id, const crow::json::wvalue& member) {
+bool MemberService::updateRow(const MemberRow& member) {
     // 입력 검증
-    if (!validateId(id) || !validateMember(member)) {
+    if (!validateMember(member)) {
         return false;
     }
     
-    // 멤버 존재 체크
-    if (!memberRepository.memberExists(id)) {
+    // 멤버 업데이트 (변경 전 값 조회와 함께 한 번의 왕복, 없는 ID 면 실패)
+    std::optional<MemberRow> previous;
+    if (!memberRepository.updateMember(member, previous) || !previous) {
         return false;
     }
-    
-    // 멤버 업데이트
-    memberRepository.updateMember(id, member);
+    recordUpdated(*previous, member);
     return true;
 }
 
-bool MemberService::deleteMember(const std::string& id) {
+bool MemberService::deleteRow(const std::string& id) {
     // 입력 검증
     if (!validateId(id)) {
         return false;
     }
     
-    // 멤버 존재 체크
-    if (!memberRepository.memberExists(id)) {
+    // 멤버 삭제 (삭제 전 값 조회와 함께 한 번의 왕복, 없는 ID 면 실패)
+    std::optional<MemberRow> previous;
+    if (!memberRepository.deleteMember(id, previous) || !previous) {
         return false;
     }
-    
-    // 멤버 삭제
-    memberRepository.deleteMember(id);
+    recordDeleted(*previous);
     return true;
 }
 
-bool MemberService::validateMember(const crow::json::wvalue& member) {
-    // 필수 필드 존재 여부 검증
-    if (member["name"].dump().empty() || member["gender"].dump().empty()) {
-        return false;
-    }
-    
-    // 이름 검증
-    std::string name = member["name"].dump();
-    if (name.length() <= 2) { // "name" 형태이므로 최소 3글자
-        return false;
+void MemberService::recordAdded(const MemberRow& member) {
+    lastAllRows.erase("");
+    searchCache.upsert(member);
+    genderCounts.add(member.gender);
+    std::string data;
+    entity::appendJson<MemberEntity>(data, member);
+    changeFeed.publish("created", data);
+}
+
+void MemberService::recordUpdated(const MemberRow& previous, const MemberRow& member) {
+    lastRowById.erase(member.id);
+    lastAllRows.erase("");
+    searchCache.upsert(member);
+    if (member.gender != previous.gender) {
+        genderCounts.add(member.gender);
+        genderCounts.remove(previous.gender);
     }
-    name = name.substr(1, name.length() - 2); // 따옴표 제거
-    
-    // 이름이 비어있거나 너무 긴 경우
-    if (name.empty() || name.length() > 100) {
+    std::string data;
+    entity::appendJson<MemberEntity>(data, member);
+    changeFeed.publish("updated", data);
+}
+
+void MemberService::recordDeleted(const MemberRow& previous) {
+    lastRowById.erase(previous.id);
+    lastAllRows.erase("");
+    searchCache.remove(previous.id);
+    genderCounts.remove(previous.gender);
+    std::string data = "{\"id\":";
+    export_format::appendJsonString(data, previous.id);
+    data.push_back('}');
+    changeFeed.publish("deleted", data);
+}
+
+bool MemberService::restoreSnapshot(const std::string& path) {
+    return searchCache.restore(path);
+}
+
+bool MemberService::saveSnapshot(const std::string& path) {
+    return searchCache.save(path);
+}
+
+bool MemberService::validateMember(const MemberRow& member) {
+    // 필수 필드, 길이, 키 형식, 성별 값 검증 (필드 기술자 기준)
+    if (!entity::checkRow<MemberEntity>(member)) {
         return false;
     }
     
     // 이름에 허용되지 않는 문자 검증 (영문, 한글, 공백, 하이픈, 언더스코어만 허용)
+    const std::string& name = member.name;
     for (unsigned char c : name) {
         if (!std::isalnum(c) && c != ' ' && c != '-' && c != '_') {
             // 한글 범위 검증 (UTF-8 바이트 시퀀스 고려)
@@ -106,33 +257,10 @@ bool MemberService::validateMember(const crow::json::wvalue& member) {
         }
     }
     
-    // 성별 검증
-    std::string gender = member["gender"].dump();
-    if (gender.length() <= 2) { // "gender" 형태이므로 최소 3글자
-        return false;
-    }
-    gender = gender.substr(1, gender.length() - 2); // 따옴표 제거
-    
-    // 성별이 허용된 값인지 검증
-    if (gender != "male" && gender != "female") {
-        return false;
-    }
-    
     return true;
 }
 
 bool MemberService::validateId(const std::string& id) {
-    // ID 길이 검증
-    if (id.empty() || id.length() > 50) {
-        return false;
-    }
-    
-    // ID 형식 검증 (영문자, 숫자, 하이픈, 언더스코어만 허용)
-    for (char c : id) {
-        if (!std::isalnum(c) && c != '-' && c != '_') {
-            return false;
-        }
-    }
-    
-    return true;
+    // 길이 및 형식 검증 (영문자, 숫자, 하이픈, 언더스코어만 허용)
+    return static_cast<bool>(entity::checkKey<MemberEntity>(id));
 }
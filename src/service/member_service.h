@@ -2,38 +2,110 @@
 
 #include "crow.h"
 #include "../repository/mysql_member_repository.h"
+#include "../utils/aggregates.h"
+#include "../utils/batch_loader.h"
+#include "../utils/change_feed.h"
+#include "../utils/export_format.h"
+#include "../utils/last_known_good.h"
+#include "../utils/singleflight.h"
+#include "search_cache.h"
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class MemberService {
 private:
     MySQLMemberRepository& memberRepository;
+    
+    // 동일 키 동시 조회 병합
+    SingleFlight<std::string, std::vector<MemberRow>> allRowLookups;
+    SingleFlight<std::string, std::optional<MemberRow>> byIdLookups;
+    
+    // 서로 다른 ID 의 동시 단건 조회를 모아 IN 쿼리 한 번으로 처리
+    BatchLoader<std::string, MemberRow> rowLoader;
+    
+    // DB 장애 중 응답할 마지막 정상 조회 결과 (목록은 1초에 한 번만 복사, 쓰기가 있으면 버림)
+    LastKnownGood<std::string, std::vector<MemberRow>> lastAllRows{1, std::chrono::seconds(1)};
+    LastKnownGood<std::string, MemberRow> lastRowById{10000};
+    std::atomic<int64_t> stale_max_age_seconds{300};
+    
+    // 이름 검색용 행 캐시 (첫 검색 때 구성, 스냅샷 파일로 저장/복원)
+    SearchCache<MemberEntity> searchCache;
+    
+    // 성별 멤버 수 (쓰기 경로에서 증분 갱신, 주기적으로 DB 와 재동기화)
+    GroupedCounts genderCounts;
+    
+    // 커밋된 변경 이벤트 (/members/stream)
+    ChangeFeed changeFeed;
 
 public:
     MemberService(MySQLMemberRepository& repository);
     
-    // 모든 멤버 조회
-    std::vector<crow::json::wvalue> getAllMembers();
+    // getAllRows, getRowById, addRow, updateRow, deleteRow 는 CrudRouter 가 사용하는 공통 CRUD 연산
     
-    // ID로 멤버 조회
-    crow::json::wvalue getMemberById(const std::string& id);
+    // 모든 멤버 조회 (행 구조체)
+    std::vector<MemberRow> getAllRows();
     
-    // 멤버 존재 여부 확인
-    bool memberExists(const std::string& id);
+    // 목록/단건 조회는 DB 장애(DatabaseUnavailableError) 시 마지막 정상값으로 응답하고 요청에 stale 표시
     
-    // 멤버 추가
-    bool addMember(const std::string& id, const crow::json::wvalue& member);
+    // ID로 멤버 조회 (없으면 nullopt)
+    std::optional<MemberRow> getRowById(const std::string& id);
     
-    // 멤버 업데이트
-    bool updateMember(const std::string& id, const crow::json::wvalue& member);
+    // 이름으로 멤버 검색 (부분 일치, 초성 검색 지원)
+    std::vector<MemberRow> searchMembers(const std::string& query, size_t limit);
     
-    // 멤버 삭제
-    bool deleteMember(const std::string& id);
+    // 성별 멤버 수 (DB 조회 없음)
+    crow::json::wvalue getMemberStats();
+    
+    // DB 장애 중 마지막 정상값으로 응답할 수 있는 최대 나이 (넘으면 503)
+    void setStaleMaxAge(std::chrono::seconds max_age);
+    
+    // 단건 조회 배치 설정 (시간 창, 최대 키 수)
+    void configureBatching(const BatchLoader<std::string, MemberRow>::Settings& settings);
 
-private:
-    // 멤버 데이터 검증
-    bool validateMember(const crow::json::wvalue& member);
+    // 캐시에 보관 중인 행 수 (마지막 정상값 + 검색용 행, 힙 게이지)
+    size_t cachedRows();
+    
+    // 검색용 행을 스냅샷 파일에서 복원 (시작 시 리스너를 열기 전). DB 와의 대조는 첫 검색 때 한다
+    bool restoreSnapshot(const std::string& path);
+    
+    // 검색용 행을 스냅샷 파일로 저장 (DB 에서 구성하거나 복원한 적이 없으면 건너뜀)
+    bool saveSnapshot(const std::string& path);
     
+    // 변경 이벤트 피드 (created/updated/deleted, 대량 적재 후 reset)
+    ChangeFeed& changes() { return changeFeed; }
+    
+    // GROUP BY 한 번으로 집계를 다시 구성 (시작 시 및 주기적 재동기화)
+    bool reseedStats();
+    
+    // 모든 멤버를 NDJSON/CSV 로 out 에 기록 (행 단위 스트리밍)
+    bool exportMembers(std::ostream& out, export_format::Format format);
+    
+    // NDJSON/CSV 본문을 LOAD DATA LOCAL INFILE 로 대량 적재 (replace 이면 같은 ID 를 교체)
+    ImportResult importMembers(const std::string& body, export_format::Format format, bool replace);
+    
+    // 멤버 추가 (검증 실패 또는 중복 ID 면 false)
+    bool addRow(const MemberRow& member);
+    
+    // 멤버 업데이트 (검증 실패 또는 없는 ID 면 false)
+    bool updateRow(const MemberRow& member);
+    
+    // 멤버 삭제 (없는 ID 면 false)
+    bool deleteRow(const std::string& id);
+    
+    // 커밋된 변경을 검색 색인과 집계에 반영 (트랜잭션 일괄 처리 등 외부 쓰기 경로용)
+    void recordAdded(const MemberRow& member);
+    void recordUpdated(const MemberRow& previous, const MemberRow& member);
+    void recordDeleted(const MemberRow& previous);
+    
+    // 멤버 데이터 검증
+    bool validateMember(const MemberRow& member);
+
+private:
     // ID 검증
     bool validateId(const std::string& id);
 };
@@ -1,117 +1,386 @@
 #include "product_service.h"
+#include <iostream>
 
-ProductService::ProductService(MySQLProductRepository& repository) : productRepository(repository) {
+ProductService::ProductService(MySQLProductRepository& repository)
+    : productRepository(repository),
+      rowLoader([this](const std::vector<std::string>& ids) {
+          std::unordered_map<std::string, ProductRow> rows;
+          if (ids.size() == 1) {
+              // 모인 키가 하나면 기존 단건 쿼리 사용
+              if (auto row = productRepository.getProductById(ids.front())) {
+                  rows.emplace(ids.front(), std::move(*row));
+              }
+              return rows;
+          }
+          // 요청한 키별로 묶여 온다 (대소문자만 다른 키도 같은 행을 받는다)
+          return productRepository.getProductsByIds(ids);
+      }),
+      searchCache({
+          [this] { return productRepository.getAllProductRows(); },
+          [this](CacheSnapshot::Watermark& watermark) { return productRepository.getWatermark(watermark); },
+          [this](int64_t since, std::vector<ProductRow>& rows) { return productRepository.getProductsUpdatedSince(since, rows); }
+      }) {
     // Repository는 생성자 매개변수로 전달받음
 }
 
-std::vector<crow::json::wvalue> ProductService::getAllProducts() {
-    return productRepository.getAllProducts();
+std::vector<ProductRow> ProductService::getAllRows() {
+    try {
+        auto rows = allRowLookups.run("", [this] {
+            return productRepository.getAllProductRows();
+        });
+        lastAllRows.store("", rows);
+        return rows;
+    } catch (const DatabaseUnavailableError&) {
+        auto hit = lastAllRows.lookup("", std::chrono::seconds(stale_max_age_seconds.load()));
+        if (!hit) {
+            throw;
+        }
+        request_context::markStale(hit->age);
+        return std::move(hit->value);
+    }
 }
 
-crow::json::wvalue ProductService::getProductById(const std::string& id) {
+std::optional<ProductRow> ProductService::getRowById(const std::string& id) {
     if (!validateId(id)) {
-        return crow::json::wvalue();
+        return std::nullopt;
+    }
+    try {
+        auto row = byIdLookups.run(id, [this, &id] {
+            return rowLoader.load(id);
+        });
+        if (row) {
+            lastRowById.store(id, *row);
+        }
+        return row;
+    } catch (const DatabaseUnavailableError&) {
+        auto hit = lastRowById.lookup(id, std::chrono::seconds(stale_max_age_seconds.load()));
+        if (!hit) {
+            throw;
+        }
+        request_context::markStale(hit->age);
+        return std::move(hit->value);
     }
-    return productRepository.getProductById(id);
 }
 
-bool ProductService::productExists(const std::string& id) {
-    if (!validateId(id)) {
-        return false;
+void ProductService::setStaleMaxAge(std::chrono::seconds max_age) {
+    stale_max_age_seconds = max_age.count();
+}
+
+void ProductService::configureBatching(const BatchLoader<std::string, ProductRow>::Settings& settings) {
+    rowLoader.configure(settings);
+}
+
+size_t ProductService::cachedRows() {
+    return lastRowById.size() + searchCache.size();
+}
+
+size_t ProductService::snapshotBytes() {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    return snapshot ? snapshot->memoryBytes() : 0;
+}
+
+std::vector<ProductRow> ProductService::filterProductRows(const ProductFilter& filter) {
+    SnapshotView view = currentSnapshot();
+    std::vector<uint32_t> rows = view.snapshot->filter(filter);
+    const SnapshotOverlay& overlay = *view.overlay;
+    
+    std::vector<ProductRow> products;
+    products.reserve(rows.size());
+    for (uint32_t row : rows) {
+        std::string id(view.snapshot->id(row));
+        if (!overlay.empty() && overlay.count(id) != 0) {
+            continue;   // 스냅샷 이후 수정/삭제됨
+        }
+        products.push_back(ProductRow{std::move(id), std::string(view.snapshot->name(row)),
+                                      view.snapshot->price(row), view.snapshot->category(row)});
     }
-    return productRepository.productExists(id);
+    for (const auto& entry : overlay) {
+        if (entry.second.row && filter.matches(*entry.second.row)) {
+            products.push_back(*entry.second.row);
+        }
+    }
+    return products;
 }
 
-bool ProductService::addProduct(const std::string& id, const crow::json::wvalue& product) {
-    // 입력 검증
-    if (!validateId(id) || !validateProduct(product)) {
-        return false;
+std::vector<ProductRow> ProductService::searchProducts(const std::string& query, size_t limit) {
+    std::vector<ProductRow> products;
+    searchCache.search(query, limit, [&](const ProductRow& row) {
+        products.push_back(row);
+    });
+    return products;
+}
+
+crow::json::wvalue ProductService::getProductStats() {
+    crow::json::wvalue stats;
+    stats["categories"] = crow::json::wvalue::object();
+    int64_t total = 0;
+    for (const auto& entry : priceStats.snapshot()) {
+        crow::json::wvalue& category = stats["categories"][entry.first];
+        category["count"] = entry.second.count;
+        category["sum"] = entry.second.sum;
+        category["min"] = entry.second.min;
+        category["max"] = entry.second.max;
+        category["avg"] = entry.second.average();
+        if (entry.second.stale) {
+            category["stale"] = true;   // min/max 재계산 대기 중
+        }
+        total += entry.second.count;
+    }
+    stats["total"] = total;
+    return stats;
+}
+
+bool ProductService::reseedStats() {
+    // 집계를 읽는 동안 쓰기가 있었다면 결과가 어긋나므로 몇 번 다시 시도
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        uint64_t version = priceStats.currentVersion();
+        std::map<std::string, PriceStats> seeded;
+        if (!productRepository.getPriceStatsByCategory(seeded)) {
+            return false;
+        }
+        if (priceStats.reset(seeded, version)) {
+            return true;
+        }
+    }
+    std::cerr << "Product stats reseed skipped: concurrent writes" << std::endl;
+    return false;
+}
+
+ProductService::SnapshotView ProductService::currentSnapshot() {
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        if (snapshot && snapshotReloadVersion == reload_version.load() && snapshotOverlay->size() <= kMaxOverlayRows &&
+            std::chrono::steady_clock::now() - snapshotLoaded < kSnapshotMaxAge) {
+            return SnapshotView{snapshot, snapshotOverlay};
+        }
     }
     
-    // 중복 ID 체크
-    if (productRepository.productExists(id)) {
-        return false;
+    // 동시에 들어온 재구성 요청은 한 번으로 합친다
+    try {
+        snapshotBuilds.run("", [this] {
+            rebuildSnapshot();
+            return true;
+        });
+    } catch (const DatabaseUnavailableError&) {
+        // DB 장애 중에는 마지막으로 구성한 스냅샷으로 응답
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - snapshotLoaded);
+        if (!snapshot || age.count() > stale_max_age_seconds.load()) {
+            throw;
+        }
+        request_context::markStale(age);
+        return SnapshotView{snapshot, snapshotOverlay};
     }
     
-    // 제품 추가
-    productRepository.addProduct(id, product);
-    return true;
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    return SnapshotView{snapshot, snapshotOverlay};
 }
 
-bool ProductService::updateProduct(const std::string& id, const crow::json::wvalue& product) {
-    // 입력 검증
-    if (!validateId(id) || !validateProduct(product)) {
-        return false;
+void ProductService::rebuildSnapshot() {
+    std::shared_ptr<const ProductSnapshot> base;
+    std::shared_ptr<const SnapshotOverlay> overlay;
+    uint64_t started_sequence;
+    uint64_t started_reload = reload_version.load();
+    auto started = std::chrono::steady_clock::now();
+    bool from_db;
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        base = snapshot;
+        overlay = snapshotOverlay;
+        started_sequence = snapshotSequence;
+        from_db = !snapshot || snapshotReloadVersion != started_reload || started - snapshotLoaded >= kSnapshotMaxAge;
     }
     
-    // 제품 존재 체크
-    if (!productRepository.productExists(id)) {
-        return false;
+    std::shared_ptr<const ProductSnapshot> rebuilt;
+    if (from_db) {
+        rebuilt = std::make_shared<const ProductSnapshot>(productRepository.getAllProductRows());
+    } else {
+        // 이 서비스를 통한 쓰기만 쌓였으면 DB 를 읽지 않고 메모리에서 합친다
+        std::vector<ProductRow> rows;
+        rows.reserve(base->size() + overlay->size());
+        for (uint32_t row = 0; row < base->size(); ++row) {
+            std::string id(base->id(row));
+            if (overlay->count(id) == 0) {
+                rows.push_back(ProductRow{std::move(id), std::string(base->name(row)), base->price(row), base->category(row)});
+            }
+        }
+        for (const auto& entry : *overlay) {
+            if (entry.second.row) {
+                rows.push_back(*entry.second.row);
+            }
+        }
+        rebuilt = std::make_shared<const ProductSnapshot>(rows);
     }
     
-    // 제품 업데이트
-    productRepository.updateProduct(id, product);
-    return true;
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshot = rebuilt;
+    snapshotReloadVersion = started_reload;
+    if (from_db) {
+        snapshotLoaded = started;
+    }
+    // 구성을 시작한 뒤의 쓰기는 결과에 없을 수 있으므로 overlay 에 남긴다
+    auto remaining = std::make_shared<SnapshotOverlay>();
+    for (const auto& entry : *snapshotOverlay) {
+        if (entry.second.sequence > started_sequence) {
+            remaining->insert(entry);
+        }
+    }
+    snapshotOverlay = std::move(remaining);
+}
+
+void ProductService::applySnapshotDelta(const std::string& id, std::optional<ProductRow> row) {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    // 조회 중인 요청이 가진 overlay 는 그대로 두고 복사본을 바꾼다 (overlay 는 kMaxOverlayRows 안팎으로 작다)
+    auto next = std::make_shared<SnapshotOverlay>(*snapshotOverlay);
+    (*next)[id] = SnapshotDelta{std::move(row), ++snapshotSequence};
+    snapshotOverlay = std::move(next);
+}
+
+void ProductService::invalidateSnapshot() {
+    reload_version++;
+}
+
+bool ProductService::exportProducts(std::ostream& out, export_format::Format format) {
+    if (format == export_format::Format::Csv) {
+        out << "id,name,price,category\n";
+    }
+    
+    std::string line;
+    bool completed = productRepository.streamAllProducts([&](const ProductRow& row) {
+        line.clear();
+        if (format == export_format::Format::Csv) {
+            export_format::appendCsvField(line, row.id);
+            line.push_back(',');
+            export_format::appendCsvField(line, row.name);
+            line += "," + std::to_string(row.price) + ",";
+            export_format::appendCsvField(line, row.category);
+            line.push_back('\n');
+        } else {
+            entity::appendJson<ProductEntity>(line, row);
+            line.push_back('\n');
+        }
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    });
+    return completed && out.good();
 }
 
-bool ProductService::deleteProduct(const std::string& id) {
+ImportResult ProductService::importProducts(const std::string& body, export_format::Format format, bool replace) {
+    auto source = LocalInfileSource::forEntity<ProductEntity>(body, format);
+    ImportResult result = productRepository.importProducts(source, replace);
+    if (result.success) {
+        // 서비스를 거치지 않은 대량 변경이므로 메모리 상태를 DB 기준으로 다시 구성
+        lastAllRows.erase("");
+        invalidateSnapshot();
+        searchCache.reset();
+        reseedStats();
+        changeFeed.publish("reset", "{\"reason\":\"import\"}");
+    }
+    return result;
+}
+
+bool ProductService::addRow(const ProductRow& product) {
     // 입력 검증
-    if (!validateId(id)) {
+    if (!validateProduct(product)) {
         return false;
     }
     
-    // 제품 존재 체크
-    if (!productRepository.productExists(id)) {
+    // 제품 추가 (중복 ID 는 기본 키 제약으로 실패)
+    if (!productRepository.addProduct(product)) {
         return false;
     }
-    
-    // 제품 삭제
-    productRepository.deleteProduct(id);
+    recordAdded(product);
     return true;
 }
 
-bool ProductService::validateProduct(const crow::json::wvalue& product) {
-    // 필수 필드 검증
-    if (product["name"].dump().empty() || product["category"].dump().empty()) {
+bool ProductService::updateRow(const ProductRow& product) {
+    // 입력 검증
+    if (!validateProduct(product)) {
         return false;
     }
     
-    // 이름 길이 검증
-    std::string name = product["name"].dump();
-    name = name.substr(1, name.length() - 2); // 따옴표 제거
-    if (name.length() < 1 || name.length() > 100) {
+    // 제품 업데이트 (변경 전 값 조회와 함께 한 번의 왕복, 없는 ID 면 실패)
+    std::optional<ProductRow> previous;
+    if (!productRepository.updateProduct(product, previous) || !previous) {
         return false;
     }
-    
-    // 가격 검증
-    std::string price_str = product["price"].dump();
-    int price = std::stoi(price_str);
-    if (price < 0 || price > 100000000) { // 0원 이상 1억원 이하
+    recordUpdated(*previous, product);
+    return true;
+}
+
+bool ProductService::deleteRow(const std::string& id) {
+    // 입력 검증
+    if (!validateId(id)) {
         return false;
     }
     
-    // 카테고리 검증
-    std::string category = product["category"].dump();
-    category = category.substr(1, category.length() - 2); // 따옴표 제거
-    if (category.length() < 1 || category.length() > 50) {
+    // 제품 삭제 (삭제 전 값 조회와 함께 한 번의 왕복, 없는 ID 면 실패)
+    std::optional<ProductRow> previous;
+    if (!productRepository.deleteProduct(id, previous) || !previous) {
         return false;
     }
-    
+    recordDeleted(*previous);
     return true;
 }
 
-bool ProductService::validateId(const std::string& id) {
-    // ID 길이 검증
-    if (id.empty() || id.length() > 50) {
-        return false;
-    }
-    
-    // ID 형식 검증 (영문자, 숫자, 하이픈, 언더스코어만 허용)
-    for (char c : id) {
-        if (!std::isalnum(c) && c != '-' && c != '_') {
-            return false;
+void ProductService::recordAdded(const ProductRow& product) {
+    lastAllRows.erase("");
+    applySnapshotDelta(product.id, product);
+    searchCache.upsert(product);
+    priceStats.add(product.category, product.price);
+    std::string data;
+    entity::appendJson<ProductEntity>(data, product);
+    changeFeed.publish("created", data);
+}
+
+void ProductService::recordUpdated(const ProductRow& previous, const ProductRow& product) {
+    lastRowById.erase(product.id);
+    lastAllRows.erase("");
+    applySnapshotDelta(product.id, product);
+    searchCache.upsert(product);
+    priceStats.add(product.category, product.price);
+    priceStats.remove(previous.category, previous.price);
+    std::string data;
+    entity::appendJson<ProductEntity>(data, product);
+    changeFeed.publish("updated", data);
+}
+
+void ProductService::recordDeleted(const ProductRow& previous) {
+    lastRowById.erase(previous.id);
+    lastAllRows.erase("");
+    applySnapshotDelta(previous.id, std::nullopt);
+    searchCache.remove(previous.id);
+    priceStats.remove(previous.category, previous.price);
+    std::string data = "{\"id\":";
+    export_format::appendJsonString(data, previous.id);
+    data.push_back('}');
+    changeFeed.publish("deleted", data);
+}
+
+bool ProductService::restoreSnapshot(const std::string& path) {
+    return searchCache.restore(path);
+}
+
+bool ProductService::saveSnapshot(const std::string& path) {
+    return searchCache.save(path);
+}
+
+void ProductService::refreshStaleStats() {
+    for (const auto& entry : priceStats.dirtyGroups()) {
+        std::map<std::string, PriceStats> recomputed;
+        if (!productRepository.getPriceStatsByCategory(recomputed, entry.first)) {
+            return;
         }
+        // 계산하는 동안 같은 카테고리에 쓰기가 있었으면 다음 주기에 다시 계산
+        priceStats.replaceGroup(entry.first, recomputed[entry.first], entry.second);
     }
-    
-    return true;
+}
+
+bool ProductService::validateProduct(const ProductRow& product) {
+    // 필수 필드, 이름/카테고리 길이, 가격 범위(0원 이상 1억원 이하), 키 형식 검증 (필드 기술자 기준)
+    return static_cast<bool>(entity::checkRow<ProductEntity>(product));
+}
+
+bool ProductService::validateId(const std::string& id) {
+    // 길이 및 형식 검증 (영문자, 숫자, 하이픈, 언더스코어만 허용)
+    return static_cast<bool>(entity::checkKey<ProductEntity>(id));
 }
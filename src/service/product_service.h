@@ -2,37 +2,160 @@
 
 #include "crow.h"
 #include "../repository/mysql_product_repository.h"
+#include "../repository/product_snapshot.h"
+#include "../utils/aggregates.h"
+#include "../utils/batch_loader.h"
+#include "../utils/change_feed.h"
+#include "../utils/export_format.h"
+#include "../utils/last_known_good.h"
+#include "../utils/singleflight.h"
+#include "search_cache.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class ProductService {
 private:
     MySQLProductRepository& productRepository;
+    
+    // 동일 키 동시 조회 병합
+    SingleFlight<std::string, std::vector<ProductRow>> allRowLookups;
+    SingleFlight<std::string, std::optional<ProductRow>> byIdLookups;
+    
+    // 서로 다른 ID 의 동시 단건 조회를 모아 IN 쿼리 한 번으로 처리
+    BatchLoader<std::string, ProductRow> rowLoader;
+    
+    // DB 장애 중 응답할 마지막 정상 조회 결과 (목록은 1초에 한 번만 복사, 쓰기가 있으면 버림)
+    LastKnownGood<std::string, std::vector<ProductRow>> lastAllRows{1, std::chrono::seconds(1)};
+    LastKnownGood<std::string, ProductRow> lastRowById{10000};
+    std::atomic<int64_t> stale_max_age_seconds{300};
+    
+    // 필터 조회용 컬럼형 스냅샷. 이 서비스를 통한 쓰기는 DB 를 다시 읽지 않고 overlay(id 별 최종 행, 삭제면 nullopt)에
+    // 쌓아 조회 때 스냅샷 위에 적용하며, overlay 가 커지면 메모리에서 합쳐 새 스냅샷을 만든다.
+    // 오래되었거나(외부 변경 반영) 대량 적재 뒤에만 DB 에서 다시 구성한다.
+    struct SnapshotDelta {
+        std::optional<ProductRow> row;
+        uint64_t sequence = 0;                              // 기록 순서 (구성 시작 전 변경은 구성 결과에 포함됨)
+    };
+    using SnapshotOverlay = std::unordered_map<std::string, SnapshotDelta>;
+    struct SnapshotView {
+        std::shared_ptr<const ProductSnapshot> snapshot;
+        std::shared_ptr<const SnapshotOverlay> overlay;
+    };
+    std::mutex snapshot_mutex;                              // 아래 snapshot* 필드 보호
+    std::shared_ptr<const ProductSnapshot> snapshot;
+    std::shared_ptr<const SnapshotOverlay> snapshotOverlay = std::make_shared<const SnapshotOverlay>();
+    std::chrono::steady_clock::time_point snapshotLoaded;   // DB 에서 마지막으로 읽은 시각
+    uint64_t snapshotReloadVersion = 0;
+    uint64_t snapshotSequence = 0;
+    std::atomic<uint64_t> reload_version{1};                // 대량 적재마다 증가 (DB 에서 다시 구성)
+    SingleFlight<std::string, bool> snapshotBuilds;
+    
+    // 외부에서 변경된 데이터를 반영하기 위한 스냅샷 최대 수명
+    static constexpr std::chrono::seconds kSnapshotMaxAge{30};
+    // overlay 가 이보다 커지면 스냅샷에 합친다
+    static constexpr size_t kMaxOverlayRows = 1024;
+    
+    // 이름 검색용 행 캐시 (첫 검색 때 구성, 스냅샷 파일로 저장/복원)
+    SearchCache<ProductEntity> searchCache;
+    
+    // 카테고리별 가격 집계 (쓰기 경로에서 증분 갱신, 주기적으로 DB 와 재동기화)
+    GroupedPriceStats priceStats;
+    
+    // 커밋된 변경 이벤트 (/products/stream)
+    ChangeFeed changeFeed;
 
 public:
     ProductService(MySQLProductRepository& repository);
     
-    // 모든 제품 조회
-    std::vector<crow::json::wvalue> getAllProducts();
+    // getAllRows, getRowById, addRow, updateRow, deleteRow 는 CrudRouter 가 사용하는 공통 CRUD 연산
     
-    // ID로 제품 조회
-    crow::json::wvalue getProductById(const std::string& id);
+    // 모든 제품 조회 (행 구조체)
+    std::vector<ProductRow> getAllRows();
     
-    // 제품 존재 여부 확인
-    bool productExists(const std::string& id);
+    // 목록/단건 조회는 DB 장애(DatabaseUnavailableError) 시 마지막 정상값으로 응답하고 요청에 stale 표시
     
-    // 제품 추가
-    bool addProduct(const std::string& id, const crow::json::wvalue& product);
+    // ID로 제품 조회 (없으면 nullopt)
+    std::optional<ProductRow> getRowById(const std::string& id);
     
-    // 제품 업데이트
-    bool updateProduct(const std::string& id, const crow::json::wvalue& product);
+    // 카테고리/가격 범위로 제품 필터링
+    std::vector<ProductRow> filterProductRows(const ProductFilter& filter);
     
-    // 제품 삭제
-    bool deleteProduct(const std::string& id);
+    // 이름으로 제품 검색 (부분 일치, 초성 검색 지원)
+    std::vector<ProductRow> searchProducts(const std::string& query, size_t limit);
+    
+    // 카테고리별 개수/최소/최대/합계/평균 가격 (DB 조회 없음)
+    crow::json::wvalue getProductStats();
+    
+    // DB 장애 중 마지막 정상값으로 응답할 수 있는 최대 나이 (넘으면 503)
+    void setStaleMaxAge(std::chrono::seconds max_age);
+    
+    // 단건 조회 배치 설정 (시간 창, 최대 키 수)
+    void configureBatching(const BatchLoader<std::string, ProductRow>::Settings& settings);
 
-private:
+    // 캐시에 보관 중인 행 수 (마지막 정상값 + 검색용 행, 힙 게이지)
+    size_t cachedRows();
+
+    // 검색용 행을 스냅샷 파일에서 복원 (시작 시 리스너를 열기 전). DB 와의 대조는 첫 검색 때 한다
+    bool restoreSnapshot(const std::string& path);
+    
+    // 검색용 행을 스냅샷 파일로 저장 (DB 에서 구성하거나 복원한 적이 없으면 건너뜀)
+    bool saveSnapshot(const std::string& path);
+    
+    // 변경 이벤트 피드 (created/updated/deleted, 대량 적재 후 reset)
+    ChangeFeed& changes() { return changeFeed; }
+
+    // 필터 스냅샷이 차지하는 바이트 (힙 게이지)
+    size_t snapshotBytes();
+    
+    // GROUP BY 한 번으로 집계를 다시 구성 (시작 시 및 주기적 재동기화)
+    bool reseedStats();
+    
+    // 삭제/수정으로 최소/최대값이 빠진 카테고리만 DB 에서 다시 계산 (백그라운드 주기 작업에서 호출)
+    void refreshStaleStats();
+    
+    // 모든 제품을 NDJSON/CSV 로 out 에 기록 (행 단위 스트리밍)
+    bool exportProducts(std::ostream& out, export_format::Format format);
+    
+    // NDJSON/CSV 본문을 LOAD DATA LOCAL INFILE 로 대량 적재 (replace 이면 같은 ID 를 교체)
+    ImportResult importProducts(const std::string& body, export_format::Format format, bool replace);
+    
+    
+    // 제품 추가 (검증 실패 또는 중복 ID 면 false)
+    bool addRow(const ProductRow& product);
+    
+    // 제품 업데이트 (검증 실패 또는 없는 ID 면 false)
+    bool updateRow(const ProductRow& product);
+    
+    // 제품 삭제 (없는 ID 면 false)
+    bool deleteRow(const std::string& id);
+    
+    // 커밋된 변경을 스냅샷, 검색 색인, 집계에 반영 (트랜잭션 일괄 처리 등 외부 쓰기 경로용)
+    void recordAdded(const ProductRow& product);
+    void recordUpdated(const ProductRow& previous, const ProductRow& product);
+    void recordDeleted(const ProductRow& previous);
+    
     // 제품 데이터 검증
-    bool validateProduct(const crow::json::wvalue& product);
+    bool validateProduct(const ProductRow& product);
+
+private:
+    // 필터 조회에 사용하는 스냅샷과 그 뒤의 쓰기 누적분
+    SnapshotView currentSnapshot();
+    
+    // DB 에서 (또는 overlay 를 합쳐 메모리에서) 스냅샷을 다시 구성
+    void rebuildSnapshot();
+    
+    // 커밋된 쓰기를 overlay 에 반영 (삭제면 row 가 nullopt)
+    void applySnapshotDelta(const std::string& id, std::optional<ProductRow> row);
+    
+    // 대량 적재 후 스냅샷 폐기 (다음 필터 조회 때 DB 에서 다시 구성)
+    void invalidateSnapshot();
     
     // ID 검증
     bool validateId(const std::string& id);
@@ -0,0 +1,301 @@
+#pragma once
+
+#include "../repository/mysql_connection_pool.h"
+#include "../utils/cache_snapshot.h"
+#include "../utils/entity_fields.h"
+#include "../utils/entity_snapshot.h"
+#include "../utils/ngram_index.h"
+#include "../utils/request_context.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 이름 검색용 행 캐시와 n-gram 색인 (MemberService, ProductService 가 소유).
+// 첫 검색 때 DB 에서 구성하고 이후에는 쓰기 경로에서 upsert/remove 로 함께 갱신한다.
+// 구성은 잠금 밖에서 지역 변수에 한 뒤 잠금 안에서 교체하며, 그동안의 쓰기는 journal 에 남겼다가 교체 전에 다시 적용한다.
+// 구성할 때의 테이블 워터마크와 함께 스냅샷 파일로 저장/복원하며,
+// 복원한 행은 첫 검색 때 워터마크 이후 변경분으로 DB 와 대조한다 (삭제가 있었으면 전체를 다시 읽음).
+// 행은 name 필드로 색인한다.
+template<typename Entity>
+class SearchCache {
+public:
+    using Row = typename Entity::Row;
+
+    // 캐시를 채우는 저장소 조회
+    struct Source {
+        std::function<std::vector<Row>()> loadAll;
+        std::function<bool(CacheSnapshot::Watermark&)> watermark;              // 실패 시 false
+        std::function<bool(int64_t, std::vector<Row>&)> updatedSince;          // since(unix 초) 이후 변경 행
+    };
+
+private:
+    Source source;
+    std::mutex buildMutex;                          // 동시에 하나의 구성/대조만
+    mutable std::shared_mutex mutex;                // nameIndex, rows, loaded 등 아래 상태 보호
+    std::unique_ptr<NgramIndex> nameIndex = std::make_unique<NgramIndex>();
+    std::unordered_map<std::string, Row> rows;
+    bool loaded = false;
+    uint64_t generation = 0;                        // reset() 마다 증가 (그 전에 시작한 구성은 버림)
+
+    // 구성/대조 중의 쓰기 (id, 삭제면 nullopt)
+    bool journaling = false;
+    std::vector<std::pair<std::string, std::optional<Row>>> journal;
+
+    // 행을 DB 에서 읽기 직전의 테이블 워터마크 (모르면 nullopt).
+    // 스냅샷에서 복원한 행은 DB 와 대조하기 전까지 validated 가 false
+    std::optional<CacheSnapshot::Watermark> watermark;
+    bool validated = true;
+    int64_t restoredSavedAt = 0;
+
+public:
+    explicit SearchCache(Source source) : source(std::move(source)) {}
+
+    SearchCache(const SearchCache&) = delete;
+    SearchCache& operator=(const SearchCache&) = delete;
+
+    // 이름으로 검색해 일치한 행마다 fn(const Row&) 호출 (캐시가 없으면 먼저 구성)
+    template<typename Fn>
+    void search(const std::string& query, size_t limit, Fn&& fn) {
+        ensureLoaded();
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        for (const std::string& id : nameIndex->search(query, limit)) {
+            auto it = rows.find(id);
+            if (it != rows.end()) {
+                fn(it->second);
+            }
+        }
+    }
+
+    // 쓰기 후 갱신 (캐시가 아직 없으면 무시)
+    void upsert(const Row& row) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (journaling) {
+            journal.emplace_back(row.id, row);
+        }
+        if (loaded) {
+            nameIndex->upsert(row.id, row.name);
+            rows[row.id] = row;
+        }
+    }
+
+    void remove(const std::string& id) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (journaling) {
+            journal.emplace_back(id, std::nullopt);
+        }
+        if (loaded) {
+            nameIndex->remove(id);
+            rows.erase(id);
+        }
+    }
+
+    // 서비스를 거치지 않은 대량 변경 후 폐기 (다음 검색 때 다시 구성)
+    void reset() {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        loaded = false;
+        validated = true;
+        watermark.reset();
+        rows.clear();
+        generation++;
+    }
+
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return rows.size();
+    }
+
+    // 스냅샷 파일에서 복원 (시작 시 리스너를 열기 전). DB 와의 대조는 첫 검색 때 한다
+    bool restore(const std::string& path) {
+        CacheSnapshot snapshot;
+        CacheSnapshot::Status status = snapshot.open(path, entity_snapshot::schema<Entity>(),
+                                                     static_cast<uint32_t>(entity::fieldCount<Entity>()));
+        if (status != CacheSnapshot::Status::Ok) {
+            if (status != CacheSnapshot::Status::Missing) {
+                std::cerr << "Ignoring cache snapshot " << path << ": " << CacheSnapshot::statusName(status) << std::endl;
+            }
+            return false;
+        }
+
+        std::unordered_map<std::string, Row> restored;
+        restored.reserve(snapshot.rowCount());
+        std::vector<std::pair<std::string, std::string>> entries;
+        entries.reserve(snapshot.rowCount());
+        bool valid = true;
+        snapshot.forEachRow([&](const std::string_view* fields) {
+            Row row;
+            if (!entity_snapshot::decodeRow<Entity>(fields, row)) {
+                valid = false;
+                return;
+            }
+            entries.emplace_back(row.id, row.name);
+            std::string id = row.id;
+            restored.emplace(std::move(id), std::move(row));
+        });
+        if (!valid) {
+            std::cerr << "Ignoring cache snapshot " << path << ": invalid row" << std::endl;
+            return false;
+        }
+
+        auto index = std::make_unique<NgramIndex>();
+        index->rebuild(entries);
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (loaded) {
+            return false;
+        }
+        rows = std::move(restored);
+        nameIndex = std::move(index);
+        loaded = true;
+        validated = false;
+        watermark = snapshot.watermark();
+        restoredSavedAt = snapshot.savedAt();
+        return true;
+    }
+
+    // 스냅샷 파일로 저장 (DB 에서 구성하거나 복원한 적이 없으면 건너뜀)
+    bool save(const std::string& path) const {
+        CacheSnapshot::Writer writer(static_cast<uint32_t>(entity::fieldCount<Entity>()));
+        CacheSnapshot::Watermark mark;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (!loaded || !watermark) {
+                return false;
+            }
+            for (const auto& entry : rows) {
+                entity_snapshot::appendRow<Entity>(writer, entry.second);
+            }
+            mark = *watermark;
+        }
+        // 파일 쓰기는 잠금 밖에서
+        return writer.save(path, entity_snapshot::schema<Entity>(), mark);
+    }
+
+private:
+    void ensureLoaded() {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (loaded && validated) {
+                return;
+            }
+        }
+
+        // 동시에 들어온 검색은 먼저 시작한 구성을 기다렸다가 그 결과를 쓴다
+        std::lock_guard<std::mutex> build(buildMutex);
+        bool restored;
+        uint64_t started;
+        std::optional<CacheSnapshot::Watermark> baseline;
+        int64_t savedAt;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            if (loaded && validated) {
+                return;
+            }
+            restored = loaded;
+            started = generation;
+            baseline = watermark;
+            savedAt = restoredSavedAt;
+            journal.clear();
+            journaling = true;
+        }
+        // 예외로 끝나도 journal 은 멈춘다 (캐시는 이전 상태 그대로)
+        std::unique_ptr<SearchCache, void (*)(SearchCache*)> stopJournal(this, [](SearchCache* cache) {
+            std::unique_lock<std::shared_mutex> lock(cache->mutex);
+            cache->journaling = false;
+            cache->journal.clear();
+        });
+
+        if (restored) {
+            try {
+                if (refreshRestored(baseline, started)) {
+                    return;
+                }
+            } catch (const DatabaseUnavailableError&) {
+                // DB 장애 중에는 복원한 행으로 응답하고 다음 검색 때 다시 대조
+                int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                request_context::markStale(std::chrono::seconds(std::max<int64_t>(0, now - savedAt)));
+                return;
+            }
+        }
+
+        // 워터마크를 먼저 읽으므로, 전체 조회와 겹친 변경은 다음 대조 때 변경분으로 다시 읽힌다
+        CacheSnapshot::Watermark mark;
+        bool marked = source.watermark(mark);
+        std::unordered_map<std::string, Row> fresh;
+        std::vector<std::pair<std::string, std::string>> entries;
+        for (auto& row : source.loadAll()) {
+            entries.emplace_back(row.id, row.name);
+            std::string id = row.id;
+            fresh[std::move(id)] = std::move(row);
+        }
+        auto index = std::make_unique<NgramIndex>();
+        index->rebuild(entries);
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (generation != started) {
+            return;     // 조회 중에 reset() 됨
+        }
+        replayJournal(fresh, *index);
+        rows.swap(fresh);
+        nameIndex = std::move(index);
+        loaded = true;
+        validated = true;
+        watermark = marked ? std::optional<CacheSnapshot::Watermark>(mark) : std::nullopt;
+    }
+
+    // 복원한 행을 워터마크 이후 변경분으로 갱신 (삭제가 있었으면 false). DB 조회는 잠금 밖에서 한다
+    bool refreshRestored(const std::optional<CacheSnapshot::Watermark>& baseline, uint64_t started) {
+        CacheSnapshot::Watermark current;
+        if (!baseline || !source.watermark(current)) {
+            return false;
+        }
+        // updated_at 은 초 단위이므로 같은 초의 변경까지 포함해 다시 읽는다
+        std::vector<Row> changed;
+        if (current != *baseline && !source.updatedSince(baseline->max_updated, changed)) {
+            return false;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        if (generation != started || !loaded) {
+            return false;
+        }
+        for (auto& row : changed) {
+            nameIndex->upsert(row.id, row.name);
+            std::string id = row.id;
+            rows[std::move(id)] = std::move(row);
+        }
+        // 삭제된 행은 변경분에 나오지 않으므로 행 수가 다르면 전체를 다시 읽는다
+        bool complete = rows.size() == current.rows;
+        // 조회 중에 이 서비스를 거친 쓰기는 DB 에서 읽은 값보다 새롭다
+        replayJournal(rows, *nameIndex);
+        if (!complete) {
+            return false;
+        }
+        validated = true;
+        watermark = current;
+        return true;
+    }
+
+    // journal 의 쓰기를 순서대로 적용 (mutex 잡은 채 호출)
+    void replayJournal(std::unordered_map<std::string, Row>& target, NgramIndex& index) {
+        for (auto& entry : journal) {
+            if (entry.second) {
+                index.upsert(entry.first, entry.second->name);
+                target[entry.first] = std::move(*entry.second);
+            } else {
+                index.remove(entry.first);
+                target.erase(entry.first);
+            }
+        }
+        journal.clear();
+    }
+};
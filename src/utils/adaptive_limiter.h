@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+// 관측된 지연시간으로 동시 처리 한도를 조절하는 limiter (gradient 방식).
+// 장기 평균 지연(long_rtt) 대비 단기 지연(short_rtt)이 커지면 한도를 줄이고,
+// 지연이 안정적이면 sqrt(limit) 만큼의 여유를 더해 한도를 천천히 키운다.
+class AdaptiveLimiter {
+public:
+    struct Settings {
+        int initial_limit = 20;
+        int min_limit = 1;
+        int max_limit = 200;
+        double tolerance = 2.0;   // long_rtt 대비 허용하는 단기 지연 배수
+        double smoothing = 0.2;   // 한도 변경 반영 비율
+    };
+
+private:
+    Settings settings;
+    std::atomic<int> inflight{0};
+    std::atomic<double> limit;
+
+    std::mutex update_mutex;
+    double short_rtt = 0.0;
+    double long_rtt = 0.0;
+
+public:
+    explicit AdaptiveLimiter(const Settings& s)
+        : settings(s), limit(static_cast<double>(std::max(s.min_limit, std::min(s.initial_limit, s.max_limit)))) {
+    }
+
+    // 한도 안이면 슬롯을 점유하고 true, 초과면 false (즉시 반환)
+    bool tryAcquire() {
+        int current = inflight.load(std::memory_order_relaxed);
+        while (current < static_cast<int>(limit.load(std::memory_order_relaxed))) {
+            if (inflight.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 슬롯 반환 및 한도 갱신
+    // rtt_us: 요청 처리 시간, overloaded: 풀 대기 등 하위 자원의 과부하 신호
+    void release(int64_t rtt_us, bool overloaded) {
+        int inflight_before = inflight.fetch_sub(1, std::memory_order_acq_rel);
+        double rtt = static_cast<double>(std::max<int64_t>(rtt_us, 1));
+
+        std::lock_guard<std::mutex> lock(update_mutex);
+        if (long_rtt == 0.0) {
+            short_rtt = rtt;
+            long_rtt = rtt;
+            return;
+        }
+        short_rtt = short_rtt * 0.9 + rtt * 0.1;
+        long_rtt = long_rtt * 0.99 + rtt * 0.01;
+
+        // 지연이 회복된 뒤에는 기준값이 과거 과부하에 묶이지 않도록 빠르게 따라 내려간다
+        if (long_rtt > short_rtt * 2.0) {
+            long_rtt *= 0.95;
+        }
+
+        double current_limit = limit.load(std::memory_order_relaxed);
+
+        // 한도를 다 쓰지 않는 상태에서는 지연이 좋아도 한도를 키우지 않는다
+        if (!overloaded && inflight_before < current_limit / 2.0) {
+            return;
+        }
+
+        double gradient = std::max(0.5, std::min(1.0, settings.tolerance * long_rtt / short_rtt));
+        if (overloaded) {
+            gradient = std::min(gradient, 0.9);
+        }
+
+        double queue_headroom = overloaded ? 0.0 : std::sqrt(current_limit);
+        double new_limit = current_limit * gradient + queue_headroom;
+        new_limit = current_limit * (1.0 - settings.smoothing) + new_limit * settings.smoothing;
+        new_limit = std::max<double>(settings.min_limit, std::min<double>(settings.max_limit, new_limit));
+        limit.store(new_limit, std::memory_order_relaxed);
+    }
+
+    int currentLimit() const { return static_cast<int>(limit.load(std::memory_order_relaxed)); }
+    int inFlight() const { return inflight.load(std::memory_order_relaxed); }
+};
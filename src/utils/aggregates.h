@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// 그룹별 가격 집계 (개수, 합계, 최소, 최대)
+struct PriceStats {
+    int64_t count = 0;
+    int64_t sum = 0;
+    int32_t min = 0;
+    int32_t max = 0;
+    bool stale = false;     // 최소/최대값이 빠져 재계산 대기 중 (min/max 는 빠지기 전 값)
+
+    double average() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+};
+
+// 쓰기 경로에서 증분 갱신되는 그룹별 가격 집계.
+// 삭제로 최소/최대값이 빠지면 정확한 값을 알 수 없으므로 그룹을 stale 로 표시해 두고,
+// 백그라운드 작업이 dirtyGroups() 로 가져가 DB 에서 다시 계산한 값으로 replaceGroup() 한다.
+class GroupedPriceStats {
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, PriceStats> groups;
+    std::unordered_map<std::string, uint64_t> group_versions;   // 그룹별 증분 갱신 횟수
+    std::atomic<uint64_t> version{0};   // 증분 갱신마다 증가 (재동기화 중 변경 감지용)
+
+public:
+    void add(const std::string& group, int32_t price) {
+        std::lock_guard<std::mutex> lock(mutex);
+        PriceStats& stats = groups[group];
+        if (stats.count == 0) {
+            stats.min = price;
+            stats.max = price;
+        } else {
+            if (price < stats.min) stats.min = price;
+            if (price > stats.max) stats.max = price;
+        }
+        stats.count++;
+        stats.sum += price;
+        version++;
+        group_versions[group]++;
+    }
+
+    // 최소/최대값이 빠져 그룹을 다시 계산해야 하면(stale 로 표시하면) true
+    bool remove(const std::string& group, int32_t price) {
+        std::lock_guard<std::mutex> lock(mutex);
+        version++;
+        group_versions[group]++;
+        auto it = groups.find(group);
+        if (it == groups.end()) {
+            return false;
+        }
+        PriceStats& stats = it->second;
+        if (--stats.count <= 0) {
+            groups.erase(it);
+            return false;
+        }
+        stats.sum -= price;
+        if (price == stats.min || price == stats.max) {
+            stats.stale = true;
+        }
+        return stats.stale;
+    }
+
+    // 재계산이 필요한 그룹과 그 그룹의 현재 갱신 횟수
+    std::map<std::string, uint64_t> dirtyGroups() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::map<std::string, uint64_t> dirty;
+        for (const auto& entry : groups) {
+            if (entry.second.stale) {
+                auto it = group_versions.find(entry.first);
+                dirty.emplace(entry.first, it != group_versions.end() ? it->second : 0);
+            }
+        }
+        return dirty;
+    }
+
+    // 그룹 하나를 DB 에서 다시 계산한 값으로 교체 (count 0 이면 제거).
+    // 계산하는 동안 그 그룹에 증분 갱신이 있었다면(expected_version 불일치) 적용하지 않고 false
+    bool replaceGroup(const std::string& group, const PriceStats& stats, uint64_t expected_version) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = group_versions.find(group);
+        if ((it != group_versions.end() ? it->second : 0) != expected_version) {
+            return false;
+        }
+        if (stats.count > 0) {
+            groups[group] = stats;
+            groups[group].stale = false;
+        } else {
+            groups.erase(group);
+        }
+        return true;
+    }
+
+    // 전체 재동기화. 집계를 읽은 뒤 증분 갱신이 있었다면(expected_version 불일치) 적용하지 않는다.
+    bool reset(const std::map<std::string, PriceStats>& seeded, uint64_t expected_version) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (version.load() != expected_version) {
+            return false;
+        }
+        groups = seeded;
+        return true;
+    }
+
+    uint64_t currentVersion() const { return version.load(); }
+
+    std::map<std::string, PriceStats> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return groups;
+    }
+};
+
+// 쓰기 경로에서 증분 갱신되는 그룹별 개수
+class GroupedCounts {
+private:
+    mutable std::mutex mutex;
+    std::map<std::string, int64_t> counts;
+    std::atomic<uint64_t> version{0};
+
+public:
+    void add(const std::string& group) {
+        std::lock_guard<std::mutex> lock(mutex);
+        counts[group]++;
+        version++;
+    }
+
+    void remove(const std::string& group) {
+        std::lock_guard<std::mutex> lock(mutex);
+        version++;
+        auto it = counts.find(group);
+        if (it != counts.end() && --it->second <= 0) {
+            counts.erase(it);
+        }
+    }
+
+    bool reset(const std::map<std::string, int64_t>& seeded, uint64_t expected_version) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (version.load() != expected_version) {
+            return false;
+        }
+        counts = seeded;
+        return true;
+    }
+
+    uint64_t currentVersion() const { return version.load(); }
+
+    std::map<std::string, int64_t> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return counts;
+    }
+};
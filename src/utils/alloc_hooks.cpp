@@ -0,0 +1,94 @@
+// 전역 operator new/delete 교체 (계측 빌드 전용, CMake 옵션 ENABLE_ALLOC_TRACKING).
+// 할당마다 스레드 로컬 카운터만 증가시키고, 요청 귀속은 request_context::bind 시점에 한다.
+// 이 파일은 일반 실행 파일에는 링크되지 않는다.
+#include "alloc_stats.h"
+#include "request_context.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+inline void count(std::size_t size) {
+    AllocationCounters& counters = request_context::threadAllocations();
+    counters.count++;
+    counters.bytes += size;
+}
+
+inline void* allocate(std::size_t size) {
+    count(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+inline void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    count(size);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc 은 크기가 정렬 단위의 배수여야 한다
+    std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded);
+}
+
+// 정적 초기화 시 계측이 켜졌음을 표시
+const bool registered = [] {
+    alloc_stats::markEnabled();
+    return true;
+}();
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* p = allocateAligned(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* p = allocateAligned(size, alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,189 @@
+#include "alloc_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+// 라우트 수 상한 (경로 정규화가 놓친 가변 조각으로 집계가 무한히 커지지 않도록)
+constexpr size_t kMaxRoutes = 128;
+
+// 가변 조각이 아닌 두 번째 경로 조각
+constexpr const char* kLiteralSegments[] = {
+    "export", "import", "stats", "search", "stream", "queries", "executor", "allocations", "profile", "reload"
+};
+
+std::atomic<bool> hooks_linked{false};
+
+struct RouteTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, alloc_stats::RouteStats> routes;
+};
+
+RouteTable& routeTable() {
+    static RouteTable table;
+    return table;
+}
+
+struct GaugeTable {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::function<int64_t()>>> gauges;
+};
+
+GaugeTable& gaugeTable() {
+    static GaugeTable table;
+    return table;
+}
+
+} // namespace
+
+namespace alloc_stats {
+
+bool isLiteralSegment(std::string_view segment) {
+    return std::any_of(std::begin(kLiteralSegments), std::end(kLiteralSegments),
+                       [&](const char* literal) { return segment == literal; });
+}
+
+uint64_t RouteStats::percentileAllocations(double percentile) const {
+    if (requests == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(requests * percentile);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > target) {
+            return std::min<uint64_t>(uint64_t(1) << i, max_allocations);
+        }
+    }
+    return max_allocations;
+}
+
+bool enabled() {
+    return hooks_linked.load(std::memory_order_relaxed);
+}
+
+void markEnabled() {
+    hooks_linked.store(true, std::memory_order_relaxed);
+}
+
+std::string routeKey(const std::string& method, const std::string& url) {
+    std::string key = method;
+    key += ' ';
+
+    size_t depth = 0;
+    size_t start = 0;
+    while (start < url.size()) {
+        size_t end = url.find('/', start + 1);
+        if (end == std::string::npos) {
+            end = url.size();
+        }
+        std::string segment = url.substr(start + 1, end - start - 1);
+        if (!segment.empty()) {
+            key += '/';
+            key += (depth == 0 || isLiteralSegment(segment)) ? segment : "{id}";
+            depth++;
+        }
+        start = end;
+    }
+    if (depth == 0) {
+        key += '/';
+    }
+    return key;
+}
+
+void recordRequest(const std::string& route, uint64_t allocations, uint64_t bytes) {
+    RouteTable& table = routeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.routes.find(route);
+    if (it == table.routes.end()) {
+        if (table.routes.size() >= kMaxRoutes) {
+            return;
+        }
+        it = table.routes.emplace(route, RouteStats{}).first;
+        it->second.route = route;
+    }
+
+    RouteStats& stats = it->second;
+    stats.requests++;
+    stats.allocations += allocations;
+    stats.bytes += bytes;
+    stats.max_allocations = std::max(stats.max_allocations, allocations);
+
+    size_t bucket = 0;
+    while (bucket + 1 < stats.buckets.size() && (uint64_t(1) << bucket) < allocations) {
+        ++bucket;
+    }
+    stats.buckets[bucket]++;
+}
+
+std::vector<RouteStats> routes() {
+    std::vector<RouteStats> result;
+    {
+        RouteTable& table = routeTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+        for (const auto& entry : table.routes) {
+            result.push_back(entry.second);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const RouteStats& a, const RouteStats& b) {
+        return a.averageAllocations() > b.averageAllocations();
+    });
+    return result;
+}
+
+void reset() {
+    RouteTable& table = routeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.routes.clear();
+}
+
+void registerGauge(const std::string& name, std::function<int64_t()> read) {
+    GaugeTable& table = gaugeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.gauges.emplace_back(name, std::move(read));
+}
+
+std::vector<std::pair<std::string, int64_t>> gauges() {
+    GaugeTable& table = gaugeTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    std::vector<std::pair<std::string, int64_t>> values;
+    values.reserve(table.gauges.size());
+    for (const auto& gauge : table.gauges) {
+        values.emplace_back(gauge.first, gauge.second());
+    }
+    return values;
+}
+
+ProcessHeap processHeap() {
+    ProcessHeap heap;
+
+    // statm: 전체 페이지 수, 상주 페이지 수, ...
+    std::ifstream statm("/proc/self/statm");
+    int64_t total_pages = 0;
+    int64_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        heap.rss_bytes = resident_pages * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    }
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    heap.heap_in_use_bytes = static_cast<int64_t>(info.uordblks);
+    heap.heap_free_bytes = static_cast<int64_t>(info.fordblks);
+    heap.mmap_bytes = static_cast<int64_t>(info.hblkhd);
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    heap.heap_in_use_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.uordblks));
+    heap.heap_free_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.fordblks));
+    heap.mmap_bytes = static_cast<int64_t>(static_cast<unsigned int>(info.hblkhd));
+#endif
+    return heap;
+}
+
+} // namespace alloc_stats
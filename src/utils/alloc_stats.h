@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// 힙 할당 계측.
+// operator new/delete 를 가로채는 alloc_hooks.cpp 는 계측 빌드(crow_ex2_alloc 타깃)에만 링크되며,
+// 일반 빌드에서는 enabled() 가 false 이고 라우트별 집계도 하지 않는다.
+// 서브시스템 게이지와 프로세스 힙 정보는 빌드 종류와 관계없이 제공한다.
+namespace alloc_stats {
+
+// 라우트(메서드 + 경로 형태)별 요청당 할당 집계
+struct RouteStats {
+    std::string route;          // 예: "GET /members/{id}"
+    uint64_t requests = 0;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t max_allocations = 0;
+    std::array<uint64_t, 24> buckets{};  // log2(요청당 할당 횟수) 히스토그램
+
+    uint64_t averageAllocations() const { return requests > 0 ? allocations / requests : 0; }
+    uint64_t averageBytes() const { return requests > 0 ? bytes / requests : 0; }
+
+    // 히스토그램 버킷 상한으로 근사한 백분위 (요청당 할당 횟수)
+    uint64_t percentileAllocations(double percentile) const;
+};
+
+// 프로세스 힙/RSS (malloc 통계와 /proc/self/statm)
+struct ProcessHeap {
+    int64_t rss_bytes = 0;
+    int64_t heap_in_use_bytes = 0;     // malloc 으로 할당되어 사용 중인 바이트
+    int64_t heap_free_bytes = 0;       // malloc 이 보유한 미사용 바이트
+    int64_t mmap_bytes = 0;            // mmap 으로 직접 할당된 큰 블록
+};
+
+// operator new 계측이 링크되었는지 여부
+bool enabled();
+
+// 계측 훅이 정적 초기화 시 호출
+void markEnabled();
+
+// 두 번째 이후 경로 조각 중 가변 값이 아닌 것 (search, stream 등)
+bool isLiteralSegment(std::string_view segment);
+
+// 메서드와 URL 을 라우트 형태로 변환 (id 같은 가변 경로 조각은 {id})
+std::string routeKey(const std::string& method, const std::string& url);
+
+// 요청 하나의 할당량 기록
+void recordRequest(const std::string& route, uint64_t allocations, uint64_t bytes);
+
+// 요청당 평균 할당 횟수 상위 순 라우트 집계
+std::vector<RouteStats> routes();
+
+// 라우트 집계 초기화
+void reset();
+
+// 서브시스템 게이지 등록 (이름은 단위를 포함, 예: "pool.connections", "products.snapshot_bytes")
+void registerGauge(const std::string& name, std::function<int64_t()> read);
+
+// 등록 순서대로 현재 게이지 값
+std::vector<std::pair<std::string, int64_t>> gauges();
+
+ProcessHeap processHeap();
+
+} // namespace alloc_stats
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// 서로 다른 키의 동시 단건 조회를 짧은 시간 창 동안 모아 한 번에 조회한다 (DataLoader 방식).
+// 창을 연 첫 호출자(리더)가 window 동안 또는 max_batch 개가 찰 때까지 기다린 뒤 모인 키를 한 번에 조회하고,
+// 나머지 호출자는 그 결과에서 자기 키의 행을 받는다. 조회 중 예외는 배치의 모든 호출자에게 전달된다.
+// 한가할 때는 조회마다 최대 window 만큼 지연이 늘어나는 대신, 몰릴 때는 연결 하나로 여러 조회를 처리한다.
+template<typename Key, typename Value>
+class BatchLoader {
+public:
+    struct Settings {
+        bool enabled = true;
+        int window_us = 200;            // 리더가 다른 키를 기다리는 시간
+        size_t max_batch = 64;          // 한 번에 조회할 최대 키 수
+    };
+
+    // 키 목록을 조회해 찾은 행을 반환 (없는 키는 빠진다)
+    using Fetch = std::function<std::unordered_map<Key, Value>(const std::vector<Key>&)>;
+
+private:
+    struct Batch {
+        std::vector<Key> keys;
+        std::unordered_map<Key, Value> rows;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    Fetch fetch;
+    std::mutex mutex;                   // pending 및 배치 상태 보호
+    std::condition_variable condition;  // 배치가 닫히거나(가득 참) 완료됨
+    std::shared_ptr<Batch> pending;     // 키를 모으는 중인 배치
+
+    std::atomic<bool> enabled{true};
+    std::atomic<int> window_us{200};
+    std::atomic<size_t> max_batch{64};
+    std::atomic<uint64_t> batches{0};
+    std::atomic<uint64_t> loads{0};
+
+public:
+    explicit BatchLoader(Fetch fetch) : fetch(std::move(fetch)) {}
+
+    BatchLoader(const BatchLoader&) = delete;
+    BatchLoader& operator=(const BatchLoader&) = delete;
+
+    void configure(const Settings& s) {
+        enabled = s.enabled;
+        window_us = std::max(0, s.window_us);
+        max_batch = std::max<size_t>(1, s.max_batch);
+    }
+
+    std::optional<Value> load(const Key& key) {
+        loads++;
+        if (!enabled.load(std::memory_order_relaxed)) {
+            batches++;
+            return find(fetch({key}), key);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        std::shared_ptr<Batch> batch = pending;
+        bool leader = false;
+        if (!batch) {
+            batch = std::make_shared<Batch>();
+            pending = batch;
+            leader = true;
+        }
+        if (std::find(batch->keys.begin(), batch->keys.end(), key) == batch->keys.end()) {
+            batch->keys.push_back(key);
+        }
+        if (batch->keys.size() >= max_batch.load(std::memory_order_relaxed)) {
+            // 가득 찼으므로 닫고 리더를 깨운다. 다음 호출자는 새 배치를 연다
+            pending.reset();
+            condition.notify_all();
+        }
+
+        if (leader) {
+            condition.wait_for(lock, std::chrono::microseconds(window_us.load(std::memory_order_relaxed)),
+                               [&] { return pending != batch; });
+            if (pending == batch) {
+                pending.reset();
+            }
+            lock.unlock();
+
+            // 조회는 잠금 밖에서 (그동안 다음 배치가 모인다)
+            std::unordered_map<Key, Value> rows;
+            std::exception_ptr error;
+            try {
+                rows = fetch(batch->keys);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            batches++;
+
+            lock.lock();
+            batch->rows = std::move(rows);
+            batch->error = error;
+            batch->done = true;
+            condition.notify_all();
+        } else {
+            condition.wait(lock, [&] { return batch->done; });
+        }
+
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+        return find(batch->rows, key);
+    }
+
+    // 조회 요청 수 / 실제 조회 횟수 (loads / batches 가 평균 배치 크기)
+    uint64_t loadCount() const { return loads.load(); }
+    uint64_t batchCount() const { return batches.load(); }
+
+private:
+    static std::optional<Value> find(const std::unordered_map<Key, Value>& rows, const Key& key) {
+        auto it = rows.find(key);
+        if (it == rows.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+};
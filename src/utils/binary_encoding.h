@@ -0,0 +1,258 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+// 내부 호출자용 바이너리 응답 인코딩 (MessagePack, CBOR).
+// 행 구조체에서 바로 바이트를 쓰므로 wvalue 트리를 만들지 않는다.
+namespace binary_encoding {
+
+enum class Encoding { Json, MsgPack, Cbor };
+
+inline const char* contentType(Encoding encoding) {
+    switch (encoding) {
+        case Encoding::MsgPack: return "application/msgpack";
+        case Encoding::Cbor: return "application/cbor";
+        default: return "application/json";
+    }
+}
+
+namespace detail {
+
+inline std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+inline bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? a[i] - 'A' + 'a' : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? b[i] - 'A' + 'a' : b[i];
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 미디어 범위에 대응하는 인코딩 (지원하지 않으면 false)
+inline bool match(std::string_view type, Encoding& encoding) {
+    if (equalsIgnoreCase(type, "application/msgpack") || equalsIgnoreCase(type, "application/x-msgpack")) {
+        encoding = Encoding::MsgPack;
+        return true;
+    }
+    if (equalsIgnoreCase(type, "application/cbor")) {
+        encoding = Encoding::Cbor;
+        return true;
+    }
+    if (equalsIgnoreCase(type, "application/json") || type == "application/*" || type == "*/*") {
+        encoding = Encoding::Json;
+        return true;
+    }
+    return false;
+}
+
+} // namespace detail
+
+// Accept 헤더에서 q 값이 가장 높은 지원 형식 선택 (같으면 먼저 나온 것, 없으면 JSON)
+inline Encoding negotiate(std::string_view accept) {
+    Encoding best = Encoding::Json;
+    double best_q = 0.0;
+    while (!accept.empty()) {
+        size_t comma = accept.find(',');
+        std::string_view range = accept.substr(0, comma);
+        accept = comma == std::string_view::npos ? std::string_view() : accept.substr(comma + 1);
+
+        size_t semicolon = range.find(';');
+        std::string_view type = detail::trim(range.substr(0, semicolon));
+        double q = 1.0;
+        while (semicolon != std::string_view::npos) {
+            range = range.substr(semicolon + 1);
+            semicolon = range.find(';');
+            std::string_view param = detail::trim(range.substr(0, semicolon));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::strtod(std::string(param.substr(2)).c_str(), nullptr);
+            }
+        }
+
+        Encoding encoding;
+        if (q > best_q && detail::match(type, encoding)) {
+            best = encoding;
+            best_q = q;
+        }
+    }
+    return best;
+}
+
+// MessagePack 인코더 (https://github.com/msgpack/msgpack/blob/master/spec.md)
+class MsgPackWriter {
+private:
+    std::string& out;
+
+public:
+    explicit MsgPackWriter(std::string& out) : out(out) {}
+
+    void beginArray(size_t count) {
+        if (count < 16) {
+            out.push_back(static_cast<char>(0x90 | count));
+        } else if (count <= 0xFFFF) {
+            out.push_back(static_cast<char>(0xDC));
+            bigEndian(count, 2);
+        } else {
+            out.push_back(static_cast<char>(0xDD));
+            bigEndian(count, 4);
+        }
+    }
+
+    void beginMap(size_t count) {
+        if (count < 16) {
+            out.push_back(static_cast<char>(0x80 | count));
+        } else if (count <= 0xFFFF) {
+            out.push_back(static_cast<char>(0xDE));
+            bigEndian(count, 2);
+        } else {
+            out.push_back(static_cast<char>(0xDF));
+            bigEndian(count, 4);
+        }
+    }
+
+    void string(std::string_view value) {
+        size_t size = value.size();
+        if (size < 32) {
+            out.push_back(static_cast<char>(0xA0 | size));
+        } else if (size <= 0xFF) {
+            out.push_back(static_cast<char>(0xD9));
+            bigEndian(size, 1);
+        } else if (size <= 0xFFFF) {
+            out.push_back(static_cast<char>(0xDA));
+            bigEndian(size, 2);
+        } else {
+            out.push_back(static_cast<char>(0xDB));
+            bigEndian(size, 4);
+        }
+        out.append(value.data(), size);
+    }
+
+    void integer(int64_t value) {
+        if (value >= 0) {
+            uint64_t v = static_cast<uint64_t>(value);
+            if (v < 128) {
+                out.push_back(static_cast<char>(v));
+            } else if (v <= 0xFF) {
+                out.push_back(static_cast<char>(0xCC));
+                bigEndian(v, 1);
+            } else if (v <= 0xFFFF) {
+                out.push_back(static_cast<char>(0xCD));
+                bigEndian(v, 2);
+            } else if (v <= 0xFFFFFFFFULL) {
+                out.push_back(static_cast<char>(0xCE));
+                bigEndian(v, 4);
+            } else {
+                out.push_back(static_cast<char>(0xCF));
+                bigEndian(v, 8);
+            }
+        } else if (value >= -32) {
+            out.push_back(static_cast<char>(value));
+        } else if (value >= INT8_MIN) {
+            out.push_back(static_cast<char>(0xD0));
+            bigEndian(static_cast<uint64_t>(value), 1);
+        } else if (value >= INT16_MIN) {
+            out.push_back(static_cast<char>(0xD1));
+            bigEndian(static_cast<uint64_t>(value), 2);
+        } else if (value >= INT32_MIN) {
+            out.push_back(static_cast<char>(0xD2));
+            bigEndian(static_cast<uint64_t>(value), 4);
+        } else {
+            out.push_back(static_cast<char>(0xD3));
+            bigEndian(static_cast<uint64_t>(value), 8);
+        }
+    }
+
+    void boolean(bool value) {
+        out.push_back(static_cast<char>(value ? 0xC3 : 0xC2));
+    }
+
+    void nil() {
+        out.push_back(static_cast<char>(0xC0));
+    }
+
+private:
+    void bigEndian(uint64_t value, int bytes) {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+    }
+};
+
+// CBOR 인코더 (RFC 8949, 길이를 아는 배열/맵만 사용)
+class CborWriter {
+private:
+    std::string& out;
+
+public:
+    explicit CborWriter(std::string& out) : out(out) {}
+
+    void beginArray(size_t count) { head(4, count); }
+
+    void beginMap(size_t count) { head(5, count); }
+
+    void string(std::string_view value) {
+        head(3, value.size());
+        out.append(value.data(), value.size());
+    }
+
+    void integer(int64_t value) {
+        if (value >= 0) {
+            head(0, static_cast<uint64_t>(value));
+        } else {
+            // 음수 n 은 -1 - n 으로 인코딩
+            head(1, ~static_cast<uint64_t>(value));
+        }
+    }
+
+    void boolean(bool value) {
+        out.push_back(static_cast<char>(value ? 0xF5 : 0xF4));
+    }
+
+    void nil() {
+        out.push_back(static_cast<char>(0xF6));
+    }
+
+private:
+    void head(uint8_t major, uint64_t value) {
+        uint8_t type = static_cast<uint8_t>(major << 5);
+        if (value < 24) {
+            out.push_back(static_cast<char>(type | value));
+            return;
+        }
+        int bytes;
+        if (value <= 0xFF) {
+            out.push_back(static_cast<char>(type | 24));
+            bytes = 1;
+        } else if (value <= 0xFFFF) {
+            out.push_back(static_cast<char>(type | 25));
+            bytes = 2;
+        } else if (value <= 0xFFFFFFFFULL) {
+            out.push_back(static_cast<char>(type | 26));
+            bytes = 4;
+        } else {
+            out.push_back(static_cast<char>(type | 27));
+            bytes = 8;
+        }
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            out.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+    }
+};
+
+} // namespace binary_encoding
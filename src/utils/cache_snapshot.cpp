@@ -0,0 +1,192 @@
+#include "cache_snapshot.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'A', 'C', 'H', 'E', 'S', 'N', 'P'};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t field_count;
+    uint64_t schema;
+    uint64_t rows;
+    uint64_t watermark_rows;
+    int64_t watermark_max_updated;
+    int64_t saved_at;
+    uint64_t payload_bytes;
+    uint64_t checksum;
+};
+static_assert(sizeof(FileHeader) == 72, "snapshot header layout");
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+void CacheSnapshot::Writer::add(std::string_view field) {
+    uint32_t length = static_cast<uint32_t>(field.size());
+    payload.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    payload.append(field.data(), field.size());
+    fields++;
+}
+
+bool CacheSnapshot::Writer::save(const std::string& path, uint64_t schema, const Watermark& watermark) const {
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format_version = kFormatVersion;
+    header.field_count = field_count;
+    header.schema = schema;
+    header.rows = rowCount();
+    header.watermark_rows = watermark.rows;
+    header.watermark_max_updated = watermark.max_updated;
+    header.saved_at = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    header.payload_bytes = payload.size();
+    header.checksum = checksum(payload);
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+
+    // 쓰다가 중단되어도 기존 파일이 남도록 임시 파일에 쓴 뒤 교체
+    std::string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "Cache snapshot: cannot create " << temp << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    bool ok = writeAll(fd, reinterpret_cast<const char*>(&header), sizeof(header)) &&
+              writeAll(fd, payload.data(), payload.size()) && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::cerr << "Cache snapshot: cannot write " << path << ": " << std::strerror(errno) << std::endl;
+        ::unlink(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+CacheSnapshot::~CacheSnapshot() {
+    close();
+}
+
+void CacheSnapshot::close() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapped_bytes);
+    }
+    mapping = nullptr;
+    mapped_bytes = 0;
+    payload = nullptr;
+    payload_bytes = 0;
+    rows = 0;
+}
+
+CacheSnapshot::Status CacheSnapshot::open(const std::string& path, uint64_t schema, uint32_t expected_fields) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT ? Status::Missing : Status::Invalid;
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        return Status::Invalid;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return Status::Invalid;
+    }
+    // 체크섬 계산과 행 복원 모두 앞에서부터 한 번씩 읽는다
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+    mapping = mapped;
+    mapped_bytes = size;
+
+    FileHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.format_version != kFormatVersion ||
+        header.schema != schema || header.field_count != expected_fields || expected_fields == 0 ||
+        header.payload_bytes != size - sizeof(FileHeader)) {
+        close();
+        return Status::Invalid;
+    }
+    payload = static_cast<const char*>(mapped) + sizeof(FileHeader);
+    payload_bytes = header.payload_bytes;
+    if (checksum(std::string_view(payload, payload_bytes)) != header.checksum) {
+        close();
+        return Status::Invalid;
+    }
+
+    // forEachRow() 가 경계를 다시 확인하지 않도록 필드 길이를 미리 검증
+    size_t pos = 0;
+    for (uint64_t row = 0; row < header.rows; ++row) {
+        for (uint32_t i = 0; i < expected_fields; ++i) {
+            if (payload_bytes - pos < sizeof(uint32_t) ||
+                payload_bytes - pos - sizeof(uint32_t) < readLength(pos)) {
+                close();
+                return Status::Invalid;
+            }
+            pos += sizeof(uint32_t) + readLength(pos);
+        }
+    }
+    if (pos != payload_bytes) {
+        close();
+        return Status::Invalid;
+    }
+
+    field_count = expected_fields;
+    rows = header.rows;
+    saved_at = header.saved_at;
+    mark.rows = header.watermark_rows;
+    mark.max_updated = header.watermark_max_updated;
+    return Status::Ok;
+}
+
+uint32_t CacheSnapshot::readLength(size_t pos) const {
+    uint32_t length;
+    std::memcpy(&length, payload + pos, sizeof(length));
+    return length;
+}
+
+uint64_t CacheSnapshot::checksum(std::string_view data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const char* CacheSnapshot::statusName(Status status) {
+    switch (status) {
+        case Status::Ok:      return "ok";
+        case Status::Missing: return "missing";
+        case Status::Invalid: return "invalid";
+    }
+    return "unknown";
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 프로세스 내 캐시를 재시작 후에도 이어 쓰기 위한 스냅샷 파일.
+// [헤더 72바이트][페이로드] 형식이며, 페이로드는 행마다 field_count 개의 (uint32 길이 + 바이트) 필드를 잇는다.
+// 헤더에는 형식/스키마 버전, 행 수, 저장 시각, 캐시를 구성할 때의 테이블 워터마크, 페이로드 FNV-1a 가 들어간다.
+// 정수는 호스트 바이트 순서로 기록하므로 같은 아키텍처에서만 읽는다.
+// 저장은 임시 파일에 쓰고 fsync 한 뒤 rename 으로 교체하므로, 읽는 쪽은 완전한 파일만 본다.
+// 읽기는 파일을 mmap 으로 매핑하고 체크섬과 구조를 확인한 뒤 필드를 매핑 위의 string_view 로 넘긴다.
+class CacheSnapshot {
+public:
+    static constexpr uint32_t kFormatVersion = 1;
+
+    // 테이블 상태 요약 (복원한 캐시를 DB 와 대조할 때 사용)
+    struct Watermark {
+        uint64_t rows = 0;
+        int64_t max_updated = 0;        // UNIX_TIMESTAMP(MAX(updated_at))
+
+        bool operator==(const Watermark& other) const {
+            return rows == other.rows && max_updated == other.max_updated;
+        }
+        bool operator!=(const Watermark& other) const { return !(*this == other); }
+    };
+
+    // 행 단위로 필드를 모으는 쓰기 버퍼
+    class Writer {
+    private:
+        std::string payload;
+        uint32_t field_count;
+        size_t fields = 0;
+
+    public:
+        explicit Writer(uint32_t field_count) : field_count(field_count) {}
+
+        // 필드 하나 추가 (field_count 개마다 한 행)
+        void add(std::string_view field);
+
+        size_t rowCount() const { return fields / field_count; }
+
+        // path 에 원자적으로 저장 (상위 디렉터리가 없으면 만든다)
+        bool save(const std::string& path, uint64_t schema, const Watermark& watermark) const;
+    };
+
+    enum class Status { Ok, Missing, Invalid };
+
+private:
+    void* mapping = nullptr;
+    size_t mapped_bytes = 0;
+    const char* payload = nullptr;
+    size_t payload_bytes = 0;
+    uint32_t field_count = 0;
+    uint64_t rows = 0;
+    int64_t saved_at = 0;
+    Watermark mark;
+
+public:
+    CacheSnapshot() = default;
+    ~CacheSnapshot();
+
+    CacheSnapshot(const CacheSnapshot&) = delete;
+    CacheSnapshot& operator=(const CacheSnapshot&) = delete;
+
+    // 파일을 매핑하고 검증. 형식/스키마 버전, 필드 수, 체크섬, 필드 경계가 맞지 않으면 Invalid
+    Status open(const std::string& path, uint64_t schema, uint32_t expected_fields);
+
+    uint64_t rowCount() const { return rows; }
+    const Watermark& watermark() const { return mark; }
+
+    // 저장 시각 (unix 초)
+    int64_t savedAt() const { return saved_at; }
+
+    // 행마다 fn(const std::string_view* fields) 호출. 필드는 이 객체가 살아 있는 동안만 유효
+    template<typename Fn>
+    void forEachRow(Fn&& fn) const {
+        std::vector<std::string_view> fields(field_count);
+        size_t pos = 0;
+        for (uint64_t row = 0; row < rows; ++row) {
+            for (uint32_t i = 0; i < field_count; ++i) {
+                uint32_t length = readLength(pos);
+                fields[i] = std::string_view(payload + pos + sizeof(uint32_t), length);
+                pos += sizeof(uint32_t) + length;
+            }
+            fn(fields.data());
+        }
+    }
+
+    static uint64_t checksum(std::string_view data);
+    static const char* statusName(Status status);
+
+private:
+    uint32_t readLength(size_t pos) const;
+    void close();
+};
@@ -0,0 +1,205 @@
+#include "change_feed.h"
+#include <algorithm>
+
+namespace {
+
+// 재시작 전에 받은 id 로 재개하는 클라이언트가 새 이벤트를 건너뛰지 않도록 시각 기반으로 시작한다.
+// (µs 단위 시각은 JavaScript Number 로도 정확히 표현된다)
+uint64_t initialId() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+ChangeFeed::ChangeFeed() : ring(settings.backlog), first_id(initialId()), last_id(first_id - 1) {
+}
+
+ChangeFeed::~ChangeFeed() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    if (dispatcher.joinable()) {
+        dispatcher.join();
+    }
+}
+
+void ChangeFeed::configure(const Settings& s) {
+    std::lock_guard<std::mutex> lock(mutex);
+    settings = s;
+    settings.backlog = std::max<size_t>(1, s.backlog);
+    settings.max_batch = std::max<size_t>(1, s.max_batch);
+    if (ring.size() != settings.backlog) {
+        ring.assign(settings.backlog, Event());
+        first_id = last_id + 1;
+    }
+    condition.notify_all();
+}
+
+uint64_t ChangeFeed::publish(std::string_view type, std::string_view data) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = ++last_id;
+        Event& slot = ring[id % ring.size()];
+        slot.id = id;
+        slot.frame = frame(id, type, data);
+        published++;
+    }
+    condition.notify_all();
+    return id;
+}
+
+uint64_t ChangeFeed::lastId() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return last_id;
+}
+
+bool ChangeFeed::subscribe(uint64_t after_id, Callback callback) {
+    Batch batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            batch.status = Status::Closed;
+            batch.last_id = after_id;
+        } else {
+            batch = readLocked(after_id);
+        }
+        if (batch.status == Status::Timeout) {
+            // 읽을 것이 없으면 대기열에 넣고 디스패처가 완료한다
+            if (waiters.size() >= settings.max_subscribers) {
+                return false;
+            }
+            waiters.push_back({after_id,
+                               std::chrono::steady_clock::now() + std::chrono::milliseconds(settings.max_wait_ms),
+                               std::move(callback)});
+            if (!dispatcher.joinable()) {
+                dispatcher = std::thread([this] { dispatchLoop(); });
+            }
+            condition.notify_all();
+            return true;
+        }
+    }
+    callback(std::move(batch));
+    return true;
+}
+
+ChangeFeed::Batch ChangeFeed::read(uint64_t after_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return readLocked(after_id);
+}
+
+size_t ChangeFeed::subscriberCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiters.size();
+}
+
+std::string ChangeFeed::frame(uint64_t id, std::string_view type, std::string_view data) {
+    std::string out = "id: " + std::to_string(id) + "\nevent: ";
+    out += type;
+    out += '\n';
+    size_t start = 0;
+    while (true) {
+        size_t end = data.find('\n', start);
+        out += "data: ";
+        out += data.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+        out += '\n';
+        if (end == std::string_view::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    out += '\n';
+    return out;
+}
+
+ChangeFeed::Batch ChangeFeed::readLocked(uint64_t after_id) {
+    Batch batch;
+    batch.body = "retry: " + std::to_string(settings.retry_ms) + "\n\n";
+
+    // 링에 남아 있는 가장 오래된 id
+    uint64_t oldest = std::max(first_id, last_id + 1 > ring.size() ? last_id + 1 - ring.size() : 0);
+    if (after_id + 1 < oldest || after_id > last_id) {
+        // 링에서 밀려난 위치이거나 재시작 전 피드의 id: 처음부터 다시 조회하도록 알린다
+        batch.status = Status::Reset;
+        batch.last_id = last_id;
+        batch.body += "id: " + std::to_string(last_id) + "\nevent: reset\ndata: {\"last_event_id\":" +
+                      std::to_string(last_id) + "}\n\n";
+        return batch;
+    }
+    if (after_id == last_id) {
+        // 새 이벤트 없음. 빈 id 필드로 재연결 위치만 알려 준다 (이벤트는 발생하지 않는다)
+        batch.status = Status::Timeout;
+        batch.last_id = after_id;
+        batch.body += "id: " + std::to_string(after_id) + "\n\n";
+        return batch;
+    }
+
+    uint64_t end = std::min(last_id, after_id + settings.max_batch);
+    for (uint64_t id = after_id + 1; id <= end; ++id) {
+        batch.body += ring[id % ring.size()].frame;
+    }
+    batch.status = Status::Events;
+    batch.last_id = end;
+    batch.events = static_cast<size_t>(end - after_id);
+    return batch;
+}
+
+void ChangeFeed::dispatchLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t seen = published;
+    while (!stopping) {
+        if (waiters.empty()) {
+            condition.wait(lock, [this] { return stopping || !waiters.empty(); });
+            continue;
+        }
+        auto earliest = std::min_element(waiters.begin(), waiters.end(), [](const Waiter& a, const Waiter& b) {
+            return a.deadline < b.deadline;
+        })->deadline;
+        size_t waiting = waiters.size();
+        condition.wait_until(lock, earliest, [&] {
+            return stopping || published != seen || waiters.size() != waiting;
+        });
+        if (stopping) {
+            break;
+        }
+        if (published != seen && settings.linger_ms > 0) {
+            // 연속된 변경을 한 응답에 모은다
+            condition.wait_for(lock, std::chrono::milliseconds(settings.linger_ms), [this] { return stopping; });
+        }
+        seen = published;
+
+        auto now = std::chrono::steady_clock::now();
+        std::vector<std::pair<Callback, Batch>> ready;
+        for (auto it = waiters.begin(); it != waiters.end();) {
+            if (it->after_id != last_id || it->deadline <= now) {
+                ready.emplace_back(std::move(it->callback), readLocked(it->after_id));
+                it = waiters.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (ready.empty()) {
+            continue;
+        }
+        // 응답 완료는 잠금 밖에서
+        lock.unlock();
+        for (auto& entry : ready) {
+            entry.first(std::move(entry.second));
+        }
+        lock.lock();
+    }
+
+    std::list<Waiter> remaining;
+    remaining.swap(waiters);
+    lock.unlock();
+    for (auto& waiter : remaining) {
+        Batch batch;
+        batch.status = Status::Closed;
+        batch.last_id = waiter.after_id;
+        batch.body = "id: " + std::to_string(waiter.after_id) + "\n\n";
+        waiter.callback(std::move(batch));
+    }
+}
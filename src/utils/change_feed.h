@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// 서비스 쓰기 경로가 발행하는 변경 이벤트의 fan-out 링 버퍼 (Server-Sent Events 용).
+// 이벤트는 발행할 때 SSE 프레임("id/event/data")으로 한 번만 직렬화해 두고, 모든 구독자가 같은 프레임을 읽는다.
+// 링에는 최근 backlog 개만 남으며, 그보다 뒤처진 구독자(Last-Event-ID 가 링 밖)는 reset 이벤트를 받고 끊긴다.
+//
+// 구독은 응답 하나 단위다: 읽을 이벤트가 있으면 곧바로, 없으면 새 이벤트가 오거나 max_wait 가 지날 때
+// 콜백으로 배치를 넘긴다. 클라이언트(EventSource)는 응답이 끝나면 retry 간격 뒤 Last-Event-ID 로 다시 연결한다.
+class ChangeFeed {
+public:
+    struct Settings {
+        size_t backlog = 4096;          // 링에 보관할 최근 이벤트 수
+        size_t max_batch = 256;         // 응답 하나에 담을 최대 이벤트 수
+        int max_wait_ms = 25000;        // 이벤트가 없을 때 응답을 붙잡아 두는 시간
+        int linger_ms = 20;             // 새 이벤트 후 연속 변경을 모으는 시간
+        int retry_ms = 100;             // 클라이언트 재연결 간격 (SSE retry 필드)
+        size_t max_subscribers = 1024;  // 동시에 대기할 수 있는 구독 수
+    };
+
+    enum class Status {
+        Events,         // 이벤트 전달
+        Timeout,        // 새 이벤트 없음 (커서만 전달)
+        Reset,          // 요청한 위치가 링 밖. 전체를 다시 조회해야 한다
+        Closed          // 서버 종료
+    };
+
+    struct Batch {
+        Status status = Status::Timeout;
+        std::string body;               // text/event-stream 본문
+        uint64_t last_id = 0;           // 본문을 받은 뒤 클라이언트의 Last-Event-ID
+        size_t events = 0;
+    };
+
+    using Callback = std::function<void(Batch&&)>;
+
+private:
+    struct Event {
+        uint64_t id = 0;
+        std::string frame;
+    };
+
+    struct Waiter {
+        uint64_t after_id;
+        std::chrono::steady_clock::time_point deadline;
+        Callback callback;
+    };
+
+    std::mutex mutex;                   // 아래 필드 보호
+    std::condition_variable condition;
+    Settings settings;
+    std::vector<Event> ring;            // id % ring.size() 위치
+    uint64_t first_id;                  // 이 피드에서 발행할 첫 id
+    uint64_t last_id;                   // 마지막으로 발행한 id (없으면 first_id - 1)
+    uint64_t published = 0;             // 발행 횟수 (디스패처가 새 이벤트를 알아채는 용도)
+    std::list<Waiter> waiters;
+    bool stopping = false;
+    std::thread dispatcher;
+
+public:
+    ChangeFeed();
+    ~ChangeFeed();
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    // backlog 이 바뀌면 링을 비운다 (이전 위치로 재개하는 구독자는 reset 을 받는다)
+    void configure(const Settings& s);
+
+    // 이벤트 발행. data 는 한 줄 JSON. 발행한 id 를 반환
+    uint64_t publish(std::string_view type, std::string_view data);
+
+    // 마지막 발행 id (새 구독자의 시작 위치)
+    uint64_t lastId();
+
+    // after_id 다음 이벤트부터 구독. 콜백은 호출 스레드 또는 디스패처 스레드에서 한 번 불린다.
+    // 대기 중인 구독이 max_subscribers 에 이르면 false
+    bool subscribe(uint64_t after_id, Callback callback);
+
+    // 대기 없이 after_id 다음 이벤트를 읽는다 (없으면 Timeout)
+    Batch read(uint64_t after_id);
+
+    size_t subscriberCount();
+
+    // SSE 프레임 하나 (data 에 개행이 있으면 줄마다 data: 로 나눈다)
+    static std::string frame(uint64_t id, std::string_view type, std::string_view data);
+
+private:
+    Batch readLocked(uint64_t after_id);
+    void dispatchLoop();
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// 하위 자원(DB) 호출 실패율로 열리고 닫히는 circuit breaker.
+//   Closed   : 호출 허용. 집계 창 안의 실패 비율이 임계값을 넘으면 Open
+//   Open     : 호출 거부 (즉시 실패). open_duration 이 지나면 probe 대상
+//   HalfOpen : 백그라운드 probe 진행 중. 요청은 계속 거부하고 probe 결과로 Closed/Open 결정
+// 요청 스레드가 probe 를 대신하지 않으므로 장애 중에도 요청 지연이 늘지 않는다.
+// 창 집계는 원자 카운터라 성공 기록은 잠금을 잡지 않는다 (실패 기록과 상태 전이, 창 넘김만 mutex).
+class CircuitBreaker {
+public:
+    enum class State { Closed, Open, HalfOpen };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        bool enabled = true;
+        double failure_ratio = 0.5;                     // 창 안 실패 비율이 이 이상이면 Open
+        int min_requests = 10;                          // 비율 판단에 필요한 최소 호출 수
+        std::chrono::milliseconds window{10000};        // 실패율 집계 창
+        std::chrono::milliseconds open_duration{5000};  // Open 후 첫 probe 까지 대기
+    };
+
+private:
+    std::mutex mutex;                       // settings, open_until 보호. 상태 전이와 창 넘김은 잡은 채로
+    Settings settings;
+    std::atomic<State> state{State::Closed};
+    std::atomic<bool> enabled{true};
+    std::atomic<Clock::rep> window_length;  // settings.window (Clock 단위)
+    std::atomic<Clock::rep> window_start;   // Clock 의 time_since_epoch
+    std::atomic<int64_t> successes{0};
+    std::atomic<int64_t> failures{0};
+    Clock::time_point open_until;
+    std::atomic<uint64_t> trips{0};
+
+public:
+    CircuitBreaker()
+        : window_length(std::chrono::duration_cast<Clock::duration>(settings.window).count()),
+          window_start(Clock::now().time_since_epoch().count()) {}
+
+    explicit CircuitBreaker(const Settings& s) : CircuitBreaker() {
+        configure(s);
+    }
+
+    void configure(const Settings& s) {
+        std::lock_guard<std::mutex> lock(mutex);
+        settings = s;
+        window_length.store(std::chrono::duration_cast<Clock::duration>(s.window).count(), std::memory_order_relaxed);
+        enabled = s.enabled;
+        if (!s.enabled) {
+            state = State::Closed;
+        }
+    }
+
+    // 호출 허용 여부 (Closed 일 때만 true)
+    bool allow() const {
+        return !enabled.load(std::memory_order_relaxed) || state.load(std::memory_order_acquire) == State::Closed;
+    }
+
+    void recordSuccess(Clock::time_point now = Clock::now()) {
+        if (!enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+        // 창이 지났을 때만 잠금을 잡고 넘긴다
+        if (windowExpired(now)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            rollWindow(now);
+        }
+        successes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 실패 기록. 이 호출로 Open 이 되었으면 true
+    bool recordFailure(Clock::time_point now = Clock::now()) {
+        if (!enabled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state != State::Closed) {
+            return false;
+        }
+        rollWindow(now);
+        int64_t failed = failures.fetch_add(1, std::memory_order_relaxed) + 1;
+        int64_t total = successes.load(std::memory_order_relaxed) + failed;
+        if (total >= settings.min_requests &&
+            static_cast<double>(failed) >= settings.failure_ratio * static_cast<double>(total)) {
+            open_until = now + settings.open_duration;
+            state.store(State::Open, std::memory_order_release);
+            trips++;
+            return true;
+        }
+        return false;
+    }
+
+    // probe 할 차례면 HalfOpen 으로 바꾸고 true (백그라운드 probe 스레드에서 호출)
+    bool beginProbe(Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state == State::Open && now >= open_until) {
+            state = State::HalfOpen;
+            return true;
+        }
+        return false;
+    }
+
+    // probe 결과 반영
+    void endProbe(bool healthy, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (state != State::HalfOpen) {
+            return;
+        }
+        if (healthy) {
+            resetWindow(now);
+            state.store(State::Closed, std::memory_order_release);
+        } else {
+            open_until = now + settings.open_duration;
+            state = State::Open;
+        }
+    }
+
+    State currentState() const { return state.load(std::memory_order_acquire); }
+
+    // Closed 에서 Open 으로 바뀐 횟수
+    uint64_t tripCount() const { return trips.load(std::memory_order_relaxed); }
+
+    static const char* stateName(State s) {
+        switch (s) {
+            case State::Closed:   return "closed";
+            case State::Open:     return "open";
+            case State::HalfOpen: return "half_open";
+        }
+        return "unknown";
+    }
+
+private:
+    bool windowExpired(Clock::time_point now) const {
+        return now.time_since_epoch().count() - window_start.load(std::memory_order_acquire) >=
+               window_length.load(std::memory_order_relaxed);
+    }
+
+    // 아래는 mutex 를 잡은 상태에서 호출
+    void rollWindow(Clock::time_point now) {
+        if (windowExpired(now)) {
+            resetWindow(now);
+        }
+    }
+
+    // 잠금 없이 더해지는 성공 기록이 넘기는 순간과 겹치면 이전 창에 들어갈 수 있다 (비율 판단에는 무시할 만한 오차)
+    void resetWindow(Clock::time_point now) {
+        successes.store(0, std::memory_order_relaxed);
+        failures.store(0, std::memory_order_relaxed);
+        window_start.store(now.time_since_epoch().count(), std::memory_order_release);
+    }
+};
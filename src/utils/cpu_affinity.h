@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace cpu_affinity {
+
+inline unsigned coreCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+// 현재 스레드를 지정한 코어에 고정 (리눅스 외 플랫폼에서는 false)
+inline bool pinCurrentThread(unsigned core) {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core % coreCount(), &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+
+namespace detail {
+inline int& shardSlot() {
+    thread_local int shard = -1;
+    return shard;
+}
+}
+
+// 현재 스레드가 사용할 샤드 번호 지정 (코어 고정 워커는 코어 번호를 사용)
+inline void setCurrentShard(int shard) {
+    detail::shardSlot() = shard;
+}
+
+// 현재 스레드의 샤드 번호. 지정되지 않은 스레드는 처음 호출 시 라운드 로빈으로 배정된다.
+inline size_t currentShard() {
+    int& shard = detail::shardSlot();
+    if (shard < 0) {
+        static std::atomic<int> next_shard{0};
+        shard = next_shard.fetch_add(1);
+    }
+    return static_cast<size_t>(shard);
+}
+
+} // namespace cpu_affinity
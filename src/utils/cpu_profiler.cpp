@@ -0,0 +1,287 @@
+#include "cpu_profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <cstdint>
+#include <dlfcn.h>
+#include <sys/time.h>
+#include <thread>
+#include <ucontext.h>
+#include <unordered_map>
+
+namespace {
+
+// 신호 핸들러와 공유하는 수집 상태 (수집 중에는 run() 만 버퍼를 바꾸지 않는다)
+std::atomic<bool> busy{false};
+bool handler_installed = false;         // busy 를 잡은 run() 만 읽고 쓴다
+std::atomic<bool> collecting{false};
+std::atomic<int> in_handler{0};
+std::atomic<size_t> next_slot{0};
+std::atomic<uint64_t> dropped_samples{0};
+void** sample_frames = nullptr;         // slot_capacity * frame_stride
+int* sample_depths = nullptr;
+size_t slot_capacity = 0;
+int frame_stride = 0;
+
+// 프레임 포인터를 따라갈 수 있는 최대 범위 (신호 시점의 sp 부터, 기본 스레드 스택 크기)
+constexpr uintptr_t kMaxStackBytes = 8 * 1024 * 1024;
+
+// 신호가 끊은 지점의 pc, 프레임 포인터, 스택 포인터
+bool interruptedState(void* context, uintptr_t& pc, uintptr_t& fp, uintptr_t& sp) {
+    const mcontext_t& machine = static_cast<ucontext_t*>(context)->uc_mcontext;
+#if defined(__x86_64__)
+    pc = static_cast<uintptr_t>(machine.gregs[REG_RIP]);
+    fp = static_cast<uintptr_t>(machine.gregs[REG_RBP]);
+    sp = static_cast<uintptr_t>(machine.gregs[REG_RSP]);
+    return true;
+#elif defined(__aarch64__)
+    pc = static_cast<uintptr_t>(machine.pc);
+    fp = static_cast<uintptr_t>(machine.regs[29]);
+    sp = static_cast<uintptr_t>(machine.sp);
+    return true;
+#else
+    (void)machine;
+    return false;
+#endif
+}
+
+// 프레임 포인터 체인으로 반환 주소 수집 (안쪽 함수부터). backtrace() 와 달리 unwinder 나
+// 로더 잠금을 쓰지 않아 신호 핸들러에서 안전하다. 프레임 포인터가 없는 함수(-fomit-frame-pointer 로
+// 빌드된 라이브러리 등)를 만나면 스택 범위, 정렬, 증가 방향 검사에 걸려 거기서 멈춘다.
+int walkFrames(void* context, void** frames, int capacity) {
+    uintptr_t pc = 0;
+    uintptr_t fp = 0;
+    uintptr_t sp = 0;
+    if (capacity <= 0 || !interruptedState(context, pc, fp, sp)) {
+        return 0;
+    }
+    int depth = 0;
+    frames[depth++] = reinterpret_cast<void*>(pc);
+    uintptr_t limit = sp + kMaxStackBytes;
+    while (depth < capacity) {
+        if (fp < sp || fp > limit - 2 * sizeof(uintptr_t) || fp % sizeof(uintptr_t) != 0) {
+            break;
+        }
+        // [fp] = 호출자의 프레임 포인터, [fp + 8] = 반환 주소
+        const uintptr_t* frame = reinterpret_cast<const uintptr_t*>(fp);
+        uintptr_t caller_fp = frame[0];
+        uintptr_t return_address = frame[1];
+        if (return_address == 0) {
+            break;
+        }
+        frames[depth++] = reinterpret_cast<void*>(return_address);
+        // 호출자 프레임은 더 높은 주소에 있다 (스레드 시작 프레임의 fp 는 0)
+        if (caller_fp <= fp) {
+            break;
+        }
+        fp = caller_fp;
+    }
+    return depth;
+}
+
+void handleSignal(int /*signal*/, siginfo_t* /*info*/, void* context) {
+    int saved_errno = errno;
+    in_handler.fetch_add(1);
+    if (collecting.load()) {
+        size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        if (slot < slot_capacity) {
+            sample_depths[slot] = walkFrames(context, sample_frames + slot * frame_stride, frame_stride);
+        } else {
+            dropped_samples.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    in_handler.fetch_sub(1);
+    errno = saved_errno;
+}
+
+std::string demangle(const char* name) {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    if (status != 0 || demangled == nullptr) {
+        return name;
+    }
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+}
+
+// 반환 주소를 "함수명" 또는 "모듈+0x오프셋" 으로 변환
+std::string symbolize(void* pc) {
+    char buffer[32];
+    Dl_info info;
+    if (dladdr(pc, &info) != 0) {
+        if (info.dli_sname != nullptr) {
+            return demangle(info.dli_sname);
+        }
+        if (info.dli_fname != nullptr) {
+            std::string module(info.dli_fname);
+            size_t slash = module.rfind('/');
+            if (slash != std::string::npos) {
+                module = module.substr(slash + 1);
+            }
+            std::snprintf(buffer, sizeof(buffer), "+0x%zx",
+                          static_cast<size_t>(static_cast<char*>(pc) - static_cast<char*>(info.dli_fbase)));
+            return module + buffer;
+        }
+    }
+    std::snprintf(buffer, sizeof(buffer), "%p", pc);
+    return buffer;
+}
+
+} // namespace
+
+void FoldedStacks::add(const std::vector<std::string>& frames, uint64_t samples) {
+    if (frames.empty()) {
+        return;
+    }
+    std::string key;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        key += (i > 0 ? ";" : "");
+        // ';' 는 프레임 구분자이므로 이름 안에서는 바꿔 쓴다
+        for (char c : frames[i]) {
+            key += (c == ';' ? ':' : c);
+        }
+    }
+    counts[key] += samples;
+}
+
+std::string FoldedStacks::str() const {
+    std::vector<std::pair<std::string, uint64_t>> stacks(counts.begin(), counts.end());
+    std::stable_sort(stacks.begin(), stacks.end(), [](const auto& a, const auto& b) {
+        return a.second > b.second;
+    });
+    std::string out;
+    for (const auto& stack : stacks) {
+        out += stack.first;
+        out += ' ';
+        out += std::to_string(stack.second);
+        out += '\n';
+    }
+    return out;
+}
+
+CpuProfiler& CpuProfiler::instance() {
+    static CpuProfiler profiler;
+    return profiler;
+}
+
+void CpuProfiler::configure(const Settings& s) {
+    std::lock_guard<std::mutex> lock(mutex);
+    settings = s;
+}
+
+CpuProfiler::Settings CpuProfiler::currentSettings() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return settings;
+}
+
+CpuProfiler::Status CpuProfiler::run(std::chrono::milliseconds duration, Profile& profile) {
+    Settings s = currentSettings();
+    if (!s.enabled) {
+        return Status::Disabled;
+    }
+    if (busy.exchange(true)) {
+        return Status::Busy;
+    }
+
+    duration = std::max(std::chrono::milliseconds(1),
+                        std::min<std::chrono::milliseconds>(duration, std::chrono::seconds(s.max_seconds)));
+    int frequency = std::max(1, std::min(s.frequency_hz, 1000));
+
+    // 핸들러가 쓰는 버퍼는 수집 시작 전에 모두 할당
+    std::vector<void*> frames(static_cast<size_t>(s.max_samples) * s.max_depth);
+    std::vector<int> depths(static_cast<size_t>(s.max_samples), 0);
+    sample_frames = frames.data();
+    sample_depths = depths.data();
+    slot_capacity = depths.size();
+    frame_stride = s.max_depth;
+    next_slot = 0;
+    dropped_samples = 0;
+
+    // 핸들러는 한 번 설치하면 프로세스가 끝날 때까지 둔다. 타이머를 멈춘 뒤에도 대기 중이던 SIGPROF 가
+    // 도착할 수 있는데, 기본 동작(SIG_DFL)으로 되돌리면 그 신호가 프로세스를 종료시킨다.
+    // 수집 중이 아닐 때 핸들러는 아무것도 하지 않는다.
+    if (!handler_installed) {
+        struct sigaction action {};
+        action.sa_sigaction = &handleSignal;
+        action.sa_flags = SA_RESTART | SA_SIGINFO;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            busy = false;
+            return Status::Failed;
+        }
+        handler_installed = true;
+    }
+
+    struct itimerval timer {};
+    long interval_us = 1000000L / frequency;
+    timer.it_interval.tv_sec = interval_us / 1000000L;
+    timer.it_interval.tv_usec = interval_us % 1000000L;
+    timer.it_value = timer.it_interval;
+    collecting.store(true);
+    auto started = std::chrono::steady_clock::now();
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        collecting = false;
+        busy = false;
+        return Status::Failed;
+    }
+
+    std::this_thread::sleep_for(duration);
+
+    struct itimerval stop {};
+    setitimer(ITIMER_PROF, &stop, nullptr);
+    collecting.store(false);
+    // 진행 중인 핸들러가 끝날 때까지 대기한 뒤 버퍼를 읽는다
+    while (in_handler.load() > 0) {
+        std::this_thread::yield();
+    }
+    profile.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+
+    size_t collected = std::min(next_slot.load(), slot_capacity);
+    std::unordered_map<void*, std::string> symbols;
+    FoldedStacks folded;
+    std::vector<std::string> stack;
+    for (size_t slot = 0; slot < collected; ++slot) {
+        int depth = depths[slot];
+        if (depth <= 0) {
+            continue;
+        }
+        stack.clear();
+        // 버퍼는 안쪽 함수부터 기록되어 있으므로 바깥부터 거꾸로 읽는다
+        for (int i = depth - 1; i >= 0; --i) {
+            void* pc = frames[slot * frame_stride + i];
+            auto it = symbols.find(pc);
+            if (it == symbols.end()) {
+                // 첫 프레임은 끊긴 지점의 pc 이고, 나머지는 반환 주소(호출 다음 명령)이므로 한 바이트 당겨 찾는다
+                void* lookup = i > 0 ? static_cast<char*>(pc) - 1 : pc;
+                it = symbols.emplace(pc, symbolize(lookup)).first;
+            }
+            stack.push_back(it->second);
+        }
+        folded.add(stack);
+        profile.samples++;
+    }
+    profile.dropped = dropped_samples.load();
+    profile.frequency_hz = frequency;
+    profile.folded = folded.str();
+
+    sample_frames = nullptr;
+    sample_depths = nullptr;
+    slot_capacity = 0;
+    busy = false;
+    return Status::Ok;
+}
+
+const char* CpuProfiler::statusName(Status status) {
+    switch (status) {
+        case Status::Ok:       return "ok";
+        case Status::Disabled: return "disabled";
+        case Status::Busy:     return "busy";
+        case Status::Failed:   return "failed";
+    }
+    return "unknown";
+}
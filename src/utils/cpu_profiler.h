@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 스택별 샘플 수를 flamegraph 용 folded 형식("root;caller;callee count")으로 모은다
+class FoldedStacks {
+private:
+    std::map<std::string, uint64_t> counts;
+
+public:
+    // frames 는 호출 순서 (바깥 함수부터)
+    void add(const std::vector<std::string>& frames, uint64_t samples = 1);
+
+    size_t size() const { return counts.size(); }
+
+    // 샘플 수 내림차순, 한 줄에 스택 하나
+    std::string str() const;
+};
+
+// SIGPROF(ITIMER_PROF) 기반 샘플링 CPU 프로파일러.
+// 프로세스 CPU 시간 기준 타이머이므로 신호는 CPU 를 쓰고 있는 스레드(Crow I/O, executor 워커 등)에 전달되고,
+// 핸들러는 프레임 포인터 체인을 따라 얻은 반환 주소만 미리 할당한 버퍼에 기록한다 (신호 안전).
+// 서버는 -fno-omit-frame-pointer 로 빌드한다. 심볼 변환은 수집이 끝난 뒤 한다.
+// 한 번에 하나의 수집만 진행할 수 있다.
+class CpuProfiler {
+public:
+    struct Settings {
+        bool enabled = false;
+        int frequency_hz = 99;          // 초당 샘플 수 (CPU 시간 기준)
+        int max_seconds = 30;           // 한 번에 수집할 수 있는 최대 시간
+        int max_samples = 20000;        // 버퍼 크기. 넘는 샘플은 버리고 dropped 로 센다
+        int max_depth = 48;             // 샘플당 최대 스택 깊이
+    };
+
+    struct Profile {
+        std::string folded;
+        uint64_t samples = 0;
+        uint64_t dropped = 0;
+        int frequency_hz = 0;
+        std::chrono::milliseconds duration{0};
+    };
+
+    enum class Status { Ok, Disabled, Busy, Failed };
+
+private:
+    std::mutex mutex;                   // settings 보호
+    Settings settings;
+
+    CpuProfiler() = default;
+
+public:
+    static CpuProfiler& instance();
+
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+    void configure(const Settings& s);
+    Settings currentSettings();
+
+    // duration 동안 수집 (max_seconds 로 제한). 호출 스레드는 수집이 끝날 때까지 대기한다
+    Status run(std::chrono::milliseconds duration, Profile& profile);
+
+    static const char* statusName(Status status);
+};
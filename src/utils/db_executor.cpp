@@ -0,0 +1,161 @@
+#include "db_executor.h"
+#include "cpu_affinity.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+// 현재 스레드가 executor 워커라면 소속 executor 와 워커 인덱스
+thread_local long current_worker_index = -1;
+thread_local const DbExecutor* current_executor = nullptr;
+}
+
+DbExecutor::DbExecutor(size_t threads, size_t queue_capacity, bool pin_to_cores)
+    : capacity(std::max<size_t>(queue_capacity, 1)), pin_to_cores(pin_to_cores) {
+    size_t count = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+}
+
+DbExecutor::~DbExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        stopping = true;
+    }
+    idle_condition.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+bool DbExecutor::submit(std::function<void()> task) {
+    // 용량 예약
+    size_t current = queued.load();
+    do {
+        if (current >= capacity) {
+            rejected++;
+            return false;
+        }
+    } while (!queued.compare_exchange_weak(current, current + 1));
+
+    // 워커 스레드에서 제출하면 자기 큐에, 그 외에는 라운드 로빈으로 분배
+    size_t index = (current_executor == this && current_worker_index >= 0)
+        ? static_cast<size_t>(current_worker_index)
+        : next_worker.fetch_add(1) % workers.size();
+
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(Task{std::move(task), std::chrono::high_resolution_clock::now(),
+                                             request_context::current()});
+    }
+    submitted++;
+
+    {
+        // 워커가 대기 조건을 검사하는 사이에 알림이 유실되지 않도록 잠금 후 통지
+        std::lock_guard<std::mutex> lock(idle_mutex);
+    }
+    idle_condition.notify_one();
+    return true;
+}
+
+DbExecutor::Stats DbExecutor::stats() {
+    Stats result;
+    result.threads = workers.size();
+    result.capacity = capacity;
+    result.queued = queued.load();
+    for (auto& worker : workers) {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        result.worker_depths.push_back(worker->tasks.size());
+    }
+    result.active = active.load();
+    result.submitted = submitted.load();
+    result.rejected = rejected.load();
+    result.completed = completed.load();
+    result.stolen = stolen.load();
+    result.avg_wait_us = wait_ewma_us.load();
+    result.max_wait_us = max_wait_us.load();
+    return result;
+}
+
+void DbExecutor::workerLoop(size_t index) {
+    current_worker_index = static_cast<long>(index);
+    current_executor = this;
+
+    if (pin_to_cores) {
+        if (!cpu_affinity::pinCurrentThread(static_cast<unsigned>(index))) {
+            std::cerr << "Failed to pin executor worker " << index << " to a core" << std::endl;
+        }
+        cpu_affinity::setCurrentShard(static_cast<int>(index));
+    }
+
+    while (true) {
+        Task task;
+        if (popTask(index, task)) {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_condition.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool DbExecutor::popTask(size_t index, Task& task) {
+    // 자기 큐의 앞쪽에서 꺼내기
+    {
+        Worker& own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+
+    // 다른 워커 큐의 뒤쪽에서 훔치기
+    for (size_t offset = 1; offset < workers.size(); ++offset) {
+        Worker& victim = *workers[(index + offset) % workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || victim.tasks.empty()) {
+            continue;
+        }
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        queued--;
+        stolen++;
+        return true;
+    }
+    return false;
+}
+
+void DbExecutor::runTask(Task& task) {
+    int64_t wait_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - task.enqueued).count();
+    wait_ewma_us = (wait_ewma_us.load() * 15 + wait_us) / 16;
+    int64_t previous_max = max_wait_us.load();
+    while (wait_us > previous_max && !max_wait_us.compare_exchange_weak(previous_max, wait_us)) {
+    }
+
+    active++;
+    {
+        request_context::Binding binding(task.request);
+        try {
+            task.fn();
+        } catch (const std::exception& e) {
+            std::cerr << "Unhandled exception in executor task: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Unhandled exception in executor task" << std::endl;
+        }
+    }
+    active--;
+    completed++;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "request_context.h"
+
+// 서비스/리포지토리 작업 전용 executor.
+// 워커마다 자체 작업 큐(deque)를 두고, 자기 큐가 비면 다른 워커 큐의 뒤쪽에서 작업을 훔쳐온다.
+// 전체 대기 작업 수는 capacity 로 제한되며, 가득 차면 submit 이 즉시 false 를 반환한다.
+class DbExecutor {
+public:
+    struct Stats {
+        size_t threads = 0;
+        size_t capacity = 0;
+        size_t queued = 0;                  // 현재 대기 중인 작업 수
+        std::vector<size_t> worker_depths;  // 워커별 큐 길이
+        int active = 0;                     // 실행 중인 작업 수
+        uint64_t submitted = 0;
+        uint64_t rejected = 0;
+        uint64_t completed = 0;
+        uint64_t stolen = 0;
+        int64_t avg_wait_us = 0;            // 큐 대기시간 이동평균
+        int64_t max_wait_us = 0;            // 큐 대기시간 최대값
+    };
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        std::chrono::high_resolution_clock::time_point enqueued;
+        RequestContext* request = nullptr;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    size_t capacity;
+    bool pin_to_cores;
+
+    std::mutex idle_mutex;
+    std::condition_variable idle_condition;
+    bool stopping = false;
+
+    std::atomic<size_t> queued{0};
+    std::atomic<size_t> next_worker{0};
+    std::atomic<int> active{0};
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> rejected{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<int64_t> wait_ewma_us{0};
+    std::atomic<int64_t> max_wait_us{0};
+
+public:
+    // pin_to_cores 이면 워커 i 를 코어 i 에 고정하고 샤드 번호도 i 로 지정한다
+    DbExecutor(size_t threads, size_t queue_capacity, bool pin_to_cores = false);
+    ~DbExecutor();
+
+    DbExecutor(const DbExecutor&) = delete;
+    DbExecutor& operator=(const DbExecutor&) = delete;
+
+    // 작업 제출. 현재 스레드에 바인딩된 요청 컨텍스트가 작업과 함께 전달된다.
+    // 대기열이 가득 차 있으면 false.
+    bool submit(std::function<void()> task);
+
+    Stats stats();
+
+private:
+    void workerLoop(size_t index);
+    bool popTask(size_t index, Task& task);
+    void runTask(Task& task);
+};
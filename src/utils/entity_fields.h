@@ -0,0 +1,320 @@
+#pragma once
+
+#include "export_format.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// 엔티티 필드 기술자.
+// 엔티티는 Row 타입, 테이블, 이름과 함께 constexpr 필드 튜플을 선언하고,
+// 검증/JSON 쓰기/바이너리 인코딩/SQL 바인딩은 이 튜플을 컴파일 타임에 펼쳐 생성한다.
+//
+//   struct MemberEntity {
+//       using Row = MemberRow;
+//       static constexpr std::string_view singular = "Member";
+//       static constexpr std::string_view table = "members";
+//       static constexpr auto fields = std::make_tuple(
+//           keyField("id", "id", 50, &MemberRow::id), ...);
+//   };
+//
+// 첫 번째 필드는 키(keyField)여야 한다.
+namespace entity {
+
+enum class FieldKind { Key, String, Int };
+
+// 문자열 필드 (choices 가 있으면 그 값만 허용)
+template<typename Row>
+struct StringField {
+    FieldKind kind;
+    std::string_view name;          // JSON 필드 이름
+    std::string_view column;        // SQL 컬럼
+    size_t max_length;
+    std::string Row::* member;
+    const std::string_view* choices;
+    size_t choice_count;
+};
+
+// 정수 필드 ([min, max] 범위)
+template<typename Row>
+struct IntField {
+    FieldKind kind;
+    std::string_view name;
+    std::string_view column;
+    int64_t min;
+    int64_t max;
+    int32_t Row::* member;
+};
+
+// 키 필드 (영문자, 숫자, '-', '_' 만 허용)
+template<typename Row>
+constexpr StringField<Row> keyField(std::string_view name, std::string_view column, size_t max_length,
+                                    std::string Row::* member) {
+    return StringField<Row>{FieldKind::Key, name, column, max_length, member, nullptr, 0};
+}
+
+template<typename Row>
+constexpr StringField<Row> stringField(std::string_view name, std::string_view column, size_t max_length,
+                                       std::string Row::* member) {
+    return StringField<Row>{FieldKind::String, name, column, max_length, member, nullptr, 0};
+}
+
+template<typename Row, size_t N>
+constexpr StringField<Row> enumField(std::string_view name, std::string_view column, size_t max_length,
+                                     std::string Row::* member, const std::string_view (&choices)[N]) {
+    return StringField<Row>{FieldKind::String, name, column, max_length, member, choices, N};
+}
+
+template<typename Row>
+constexpr IntField<Row> intField(std::string_view name, std::string_view column, int64_t min, int64_t max,
+                                 int32_t Row::* member) {
+    return IntField<Row>{FieldKind::Int, name, column, min, max, member};
+}
+
+template<typename Entity>
+constexpr size_t fieldCount() {
+    return std::tuple_size<std::remove_const_t<decltype(Entity::fields)>>::value;
+}
+
+namespace detail {
+
+template<typename Entity, typename Fn, size_t... I>
+void forEach(Fn& fn, std::index_sequence<I...>) {
+    (fn(std::get<I>(Entity::fields), I), ...);
+}
+
+template<typename Entity, typename Fn, size_t... I>
+bool all(Fn& fn, std::index_sequence<I...>) {
+    return (fn(std::get<I>(Entity::fields), I) && ...);
+}
+
+} // namespace detail
+
+// 모든 필드에 fn(field, index) 호출
+template<typename Entity, typename Fn>
+void forEachField(Fn&& fn) {
+    detail::forEach<Entity>(fn, std::make_index_sequence<fieldCount<Entity>()>{});
+}
+
+// fn(field, index) 가 false 를 반환하면 중단하고 false
+template<typename Entity, typename Fn>
+bool allFields(Fn&& fn) {
+    return detail::all<Entity>(fn, std::make_index_sequence<fieldCount<Entity>()>{});
+}
+
+// 검증 실패 종류
+enum class Violation { None, Missing, WrongType, Empty, TooLong, InvalidKey, NotAllowed, OutOfRange };
+constexpr size_t kViolationCount = 8;
+
+struct FieldCheck {
+    Violation violation = Violation::None;
+    size_t field = 0;
+
+    explicit operator bool() const { return violation == Violation::None; }
+};
+
+template<typename Row>
+Violation checkValue(const StringField<Row>& field, const std::string& value) {
+    if (value.empty()) {
+        return Violation::Empty;
+    }
+    if (value.size() > field.max_length) {
+        return Violation::TooLong;
+    }
+    if (field.kind == FieldKind::Key) {
+        for (char c : value) {
+            bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                           c == '-' || c == '_';
+            if (!allowed) {
+                return Violation::InvalidKey;
+            }
+        }
+    }
+    if (field.choice_count > 0) {
+        for (size_t i = 0; i < field.choice_count; ++i) {
+            if (value == field.choices[i]) {
+                return Violation::None;
+            }
+        }
+        return Violation::NotAllowed;
+    }
+    return Violation::None;
+}
+
+template<typename Row>
+Violation checkValue(const IntField<Row>& field, int64_t value) {
+    return value < field.min || value > field.max ? Violation::OutOfRange : Violation::None;
+}
+
+// 키 값 검증 (URL 경로의 ID 등)
+template<typename Entity>
+FieldCheck checkKey(const std::string& id) {
+    static_assert(std::get<0>(Entity::fields).kind == FieldKind::Key, "first field must be the key");
+    return FieldCheck{checkValue(std::get<0>(Entity::fields), id), 0};
+}
+
+// 행 전체 검증 (첫 번째 위반 반환)
+template<typename Entity>
+FieldCheck checkRow(const typename Entity::Row& row) {
+    FieldCheck check;
+    allFields<Entity>([&](const auto& field, size_t index) {
+        check = FieldCheck{checkValue(field, row.*(field.member)), index};
+        return check.violation == Violation::None;
+    });
+    return check;
+}
+
+// {"error": message} 본문
+inline std::string jsonErrorBody(const std::string& message) {
+    std::string body = "{\"error\":";
+    export_format::appendJsonString(body, message);
+    body += "}";
+    return body;
+}
+
+namespace detail {
+
+template<typename Row>
+std::string describe(const StringField<Row>& field, Violation violation) {
+    std::string name(field.name);
+    switch (violation) {
+        case Violation::Missing: return "Missing required field: " + name;
+        case Violation::WrongType: return "Field " + name + " must be a string";
+        case Violation::Empty: return "Field " + name + " cannot be empty";
+        case Violation::TooLong: return "Field " + name + " must be at most " + std::to_string(field.max_length) + " bytes";
+        case Violation::InvalidKey: return "Field " + name + " may only contain letters, digits, '-' and '_'";
+        case Violation::NotAllowed: {
+            std::string message = "Field " + name + " must be one of: ";
+            for (size_t i = 0; i < field.choice_count; ++i) {
+                message += (i > 0 ? ", " : "") + std::string(field.choices[i]);
+            }
+            return message;
+        }
+        default: return "Invalid field: " + name;
+    }
+}
+
+template<typename Row>
+std::string describe(const IntField<Row>& field, Violation violation) {
+    std::string name(field.name);
+    switch (violation) {
+        case Violation::Missing: return "Missing required field: " + name;
+        case Violation::WrongType: return "Field " + name + " must be an integer";
+        case Violation::OutOfRange:
+            return "Field " + name + " must be between " + std::to_string(field.min) + " and " + std::to_string(field.max);
+        default: return "Invalid field: " + name;
+    }
+}
+
+// 필드별, 위반 종류별 오류 응답 본문 (처음 사용할 때 한 번 직렬화)
+template<typename Entity>
+const std::array<std::array<std::string, kViolationCount>, fieldCount<Entity>()>& errorBodies() {
+    static const auto bodies = [] {
+        std::array<std::array<std::string, kViolationCount>, fieldCount<Entity>()> table;
+        forEachField<Entity>([&](const auto& field, size_t index) {
+            for (size_t v = 1; v < kViolationCount; ++v) {
+                table[index][v] = jsonErrorBody(describe(field, static_cast<Violation>(v)));
+            }
+        });
+        return table;
+    }();
+    return bodies;
+}
+
+// "{\"id\":" / ",\"name\":" 같은 필드 앞부분
+template<typename Entity>
+const std::array<std::string, fieldCount<Entity>()>& jsonPrefixes() {
+    static const auto prefixes = [] {
+        std::array<std::string, fieldCount<Entity>()> table;
+        forEachField<Entity>([&](const auto& field, size_t index) {
+            table[index] = index == 0 ? "{" : ",";
+            export_format::appendJsonString(table[index], field.name);
+            table[index] += ":";
+        });
+        return table;
+    }();
+    return prefixes;
+}
+
+inline void appendJsonValue(std::string& out, const std::string& value) {
+    export_format::appendJsonString(out, value);
+}
+
+inline void appendJsonValue(std::string& out, int32_t value) {
+    out += std::to_string(value);
+}
+
+template<typename Writer>
+void encodeValue(Writer& writer, const std::string& value) {
+    writer.string(value);
+}
+
+template<typename Writer>
+void encodeValue(Writer& writer, int32_t value) {
+    writer.integer(value);
+}
+
+} // namespace detail
+
+// 검증 실패에 대한 미리 직렬화된 {"error": ...} 본문
+template<typename Entity>
+const std::string& errorBody(const FieldCheck& check) {
+    return detail::errorBodies<Entity>()[check.field][static_cast<size_t>(check.violation)];
+}
+
+// 검증 실패 메시지 (다른 응답 본문에 넣을 때 사용)
+template<typename Entity>
+std::string errorMessage(const FieldCheck& check) {
+    std::string message;
+    forEachField<Entity>([&](const auto& field, size_t index) {
+        if (index == check.field) {
+            message = detail::describe(field, check.violation);
+        }
+    });
+    return message;
+}
+
+// 행을 JSON 객체로 추가
+template<typename Entity>
+void appendJson(std::string& out, const typename Entity::Row& row) {
+    const auto& prefixes = detail::jsonPrefixes<Entity>();
+    forEachField<Entity>([&](const auto& field, size_t index) {
+        out += prefixes[index];
+        detail::appendJsonValue(out, row.*(field.member));
+    });
+    out.push_back('}');
+}
+
+// 행 목록을 JSON 배열로 추가
+template<typename Entity, typename Rows>
+void appendJsonArray(std::string& out, const Rows& rows) {
+    out.push_back('[');
+    bool first = true;
+    for (const auto& row : rows) {
+        if (!first) {
+            out.push_back(',');
+        }
+        first = false;
+        appendJson<Entity>(out, row);
+    }
+    out.push_back(']');
+}
+
+// 행 목록을 필드 이름을 키로 하는 맵의 배열로 인코딩 (MessagePack/CBOR writer)
+template<typename Entity, typename Writer, typename Rows>
+void encodeRows(Writer& writer, const Rows& rows) {
+    writer.beginArray(rows.size());
+    for (const auto& row : rows) {
+        writer.beginMap(fieldCount<Entity>());
+        forEachField<Entity>([&](const auto& field, size_t) {
+            writer.string(field.name);
+            detail::encodeValue(writer, row.*(field.member));
+        });
+    }
+}
+
+} // namespace entity
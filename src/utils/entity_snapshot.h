@@ -0,0 +1,67 @@
+#pragma once
+
+#include "cache_snapshot.h"
+#include "entity_fields.h"
+#include <charconv>
+#include <string>
+#include <string_view>
+
+// 필드 기술자로 행을 캐시 스냅샷 필드로 쓰고 읽는다 (필드 선언 순서, 정수는 10진 문자열).
+namespace entity_snapshot {
+
+namespace detail {
+
+inline void appendValue(CacheSnapshot::Writer& writer, const std::string& value) {
+    writer.add(value);
+}
+
+inline void appendValue(CacheSnapshot::Writer& writer, int32_t value) {
+    char digits[16];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    writer.add(std::string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+inline bool decodeValue(std::string_view field, std::string& value) {
+    value.assign(field.data(), field.size());
+    return true;
+}
+
+inline bool decodeValue(std::string_view field, int32_t& value) {
+    auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+} // namespace detail
+
+// 테이블, 컬럼 이름과 종류로 만든 스키마 식별자. 필드가 바뀌면 이전 스냅샷은 읽지 않는다
+template<typename Entity>
+uint64_t schema() {
+    static const uint64_t id = [] {
+        std::string shape(Entity::table);
+        entity::forEachField<Entity>([&](const auto& field, size_t) {
+            shape += '|';
+            shape += field.column;
+            shape += ':';
+            shape += std::to_string(static_cast<int>(field.kind));
+        });
+        return CacheSnapshot::checksum(shape);
+    }();
+    return id;
+}
+
+template<typename Entity>
+void appendRow(CacheSnapshot::Writer& writer, const typename Entity::Row& row) {
+    entity::forEachField<Entity>([&](const auto& field, size_t) {
+        detail::appendValue(writer, row.*(field.member));
+    });
+}
+
+// 값이 필드 형식에 맞지 않으면 false
+template<typename Entity>
+bool decodeRow(const std::string_view* fields, typename Entity::Row& row) {
+    return entity::allFields<Entity>([&](const auto& field, size_t index) {
+        return detail::decodeValue(fields[index], row.*(field.member));
+    });
+}
+
+} // namespace entity_snapshot
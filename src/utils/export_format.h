@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// 대량 내보내기 행 직렬화 도우미 (NDJSON, CSV)
+namespace export_format {
+
+enum class Format { Ndjson, Csv };
+
+// "ndjson" 또는 "csv" (그 외는 false)
+inline bool parse(const std::string& name, Format& format) {
+    if (name.empty() || name == "ndjson") {
+        format = Format::Ndjson;
+        return true;
+    }
+    if (name == "csv") {
+        format = Format::Csv;
+        return true;
+    }
+    return false;
+}
+
+inline const char* contentType(Format format) {
+    return format == Format::Csv ? "text/csv; charset=utf-8" : "application/x-ndjson";
+}
+
+inline const char* extension(Format format) {
+    return format == Format::Csv ? "csv" : "ndjson";
+}
+
+// JSON 문자열 리터럴로 추가 (따옴표 포함)
+inline void appendJsonString(std::string& out, std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+    out.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out.push_back(hex[(c >> 4) & 0xF]);
+                    out.push_back(hex[c & 0xF]);
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+// CSV 필드로 추가 (RFC 4180: 구분자/따옴표/개행이 있으면 따옴표로 감싸고 " 는 "" 로)
+inline void appendCsvField(std::string& out, std::string_view value) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.append(value.data(), value.size());
+        return;
+    }
+    out.push_back('"');
+    for (char c : value) {
+        if (c == '"') {
+            out.push_back('"');
+        }
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+} // namespace export_format
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unistd.h>
+
+// 대량 내보내기 결과를 임시 파일로 내려받게 하기 위한 스풀 디렉터리.
+// 행을 하나씩 파일에 쓰고 Crow 의 정적 파일 전송(고정 크기 청크)으로 보내므로 메모리 사용이 일정하다.
+// 전송은 연결의 I/O 스레드에서 하며 (endOnIoThread), 파일은 전송이 끝나면(또는 실패하면) 바로 discard() 로 지우고,
+// 프로세스가 전송 중에 멈춰 남은 파일은 max_age 가 지난 뒤 다음 생성 시 정리한다.
+class ExportSpool {
+private:
+    std::filesystem::path directory;
+    std::chrono::seconds max_age;
+    std::mutex mutex;
+    std::atomic<uint64_t> sequence{0};
+
+public:
+    ExportSpool(const std::string& name, std::chrono::seconds max_age = std::chrono::minutes(10))
+        : directory(std::filesystem::temp_directory_path() / ("crow_ex2_" + name + "_" + std::to_string(getpid()))),
+          max_age(max_age) {
+    }
+
+    ~ExportSpool() {
+        std::error_code error;
+        std::filesystem::remove_all(directory, error);
+    }
+
+    ExportSpool(const ExportSpool&) = delete;
+    ExportSpool& operator=(const ExportSpool&) = delete;
+
+    // 새 스풀 파일을 열고 경로 반환 (실패 시 빈 문자열)
+    std::string create(const std::string& extension, std::ofstream& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        removeExpired();
+
+        std::filesystem::path path = directory / ("export-" + std::to_string(++sequence) + "." + extension);
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to create export spool file: " << path << std::endl;
+            return "";
+        }
+        return path.string();
+    }
+
+    // 전송이 끝났거나 전송 전에 실패한 스풀 파일 삭제
+    void discard(const std::string& path) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+
+private:
+    void removeExpired() {
+        std::error_code error;
+        auto now = std::filesystem::file_time_type::clock::now();
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            std::error_code entry_error;
+            auto modified = entry.last_write_time(entry_error);
+            if (!entry_error && now - modified > max_age) {
+                std::filesystem::remove(entry.path(), entry_error);
+            }
+        }
+    }
+};
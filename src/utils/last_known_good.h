@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+// 마지막으로 성공한 조회 결과 보관소.
+// DB 장애 중에는 이 값을 응답하고(stale-while-error), 정상일 때는 조회마다 값을 덮어쓴다.
+// capacity 를 넘으면 가장 먼저 들어온 키부터 버리고, refresh_interval 안에 다시 저장하는 값은
+// 복사하지 않는다 (큰 목록을 조회마다 복사하지 않도록).
+template<typename Key, typename Value>
+class LastKnownGood {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Hit {
+        Value value;
+        std::chrono::seconds age;
+    };
+
+private:
+    struct Entry {
+        Value value;
+        Clock::time_point stored;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<Key, Entry> entries;
+    std::deque<Key> order;      // 삽입 순서 (제거 대상 선택용)
+    size_t capacity;
+    std::chrono::milliseconds refresh_interval;
+
+public:
+    explicit LastKnownGood(size_t capacity, std::chrono::milliseconds refresh_interval = std::chrono::milliseconds(0))
+        : capacity(capacity), refresh_interval(refresh_interval) {}
+
+    void store(const Key& key, const Value& value, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            if (now - it->second.stored >= refresh_interval) {
+                it->second = Entry{value, now};
+            }
+            return;
+        }
+        while (!order.empty() && entries.size() >= capacity) {
+            entries.erase(order.front());
+            order.pop_front();
+        }
+        if (capacity == 0) {
+            return;
+        }
+        entries.emplace(key, Entry{value, now});
+        order.push_back(key);
+    }
+
+    // 쓰기로 값이 바뀌었을 때 제거 (삭제된 행을 장애 중에 다시 내보내지 않도록)
+    void erase(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.erase(key) > 0) {
+            for (auto it = order.begin(); it != order.end(); ++it) {
+                if (*it == key) {
+                    order.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+
+    // max_age 보다 오래되지 않은 값 (없으면 nullopt)
+    std::optional<Hit> lookup(const Key& key, std::chrono::seconds max_age, Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            return std::nullopt;
+        }
+        auto age = std::chrono::duration_cast<std::chrono::seconds>(now - it->second.stored);
+        if (age > max_age) {
+            return std::nullopt;
+        }
+        return Hit{it->second.value, age};
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+};
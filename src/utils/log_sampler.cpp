@@ -0,0 +1,83 @@
+#include "log_sampler.h"
+#include <random>
+
+void LogSampler::configure(const Settings& s) {
+    auto next = std::make_shared<const Settings>(s);
+    std::atomic_store(&settings, next);
+}
+
+std::shared_ptr<const LogSampler::Settings> LogSampler::current() const {
+    return std::atomic_load(&settings);
+}
+
+bool LogSampler::enabled() const {
+    return current()->enabled;
+}
+
+bool LogSampler::hasRouteThresholds() const {
+    return !current()->route_slow_us.empty();
+}
+
+LogSampler::Decision LogSampler::decide(const std::string& route, int status, int64_t duration_us, int64_t now_second) {
+    auto s = current();
+    Decision decision;
+    if (!s->enabled) {
+        return decision;
+    }
+
+    if (status >= 500) {
+        decision.reason = Reason::Error;
+        return decision;
+    }
+
+    int64_t slow_us = s->slow_us;
+    if (!s->route_slow_us.empty()) {
+        auto it = s->route_slow_us.find(route);
+        if (it != s->route_slow_us.end()) {
+            slow_us = it->second;
+        }
+    }
+    if (duration_us >= slow_us) {
+        decision.reason = Reason::Slow;
+        return decision;
+    }
+
+    if (status >= 400 && allowClientError(s->client_errors_per_second, now_second)) {
+        decision.reason = Reason::ClientError;
+        return decision;
+    }
+
+    // 빠른 정상 요청과 한도를 넘은 4xx 는 표본으로만 기록
+    decision.reason = Reason::Sampled;
+    decision.sample = s->sample_one_in;
+    decision.log = sampleOne(s->sample_one_in);
+    return decision;
+}
+
+bool LogSampler::allowClientError(uint32_t limit, int64_t now_second) {
+    int64_t second = client_error_second.load(std::memory_order_relaxed);
+    if (second != now_second && client_error_second.compare_exchange_strong(second, now_second)) {
+        client_errors.store(0, std::memory_order_relaxed);
+    }
+    return client_errors.fetch_add(1, std::memory_order_relaxed) < limit;
+}
+
+bool LogSampler::sampleOne(uint32_t one_in) {
+    if (one_in <= 1) {
+        return true;
+    }
+    thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_int_distribution<uint32_t> distribution(0, one_in - 1);
+    return distribution(generator) == 0;
+}
+
+const char* LogSampler::reasonName(Reason reason) {
+    switch (reason) {
+        case Reason::All:         return "all";
+        case Reason::Error:       return "error";
+        case Reason::ClientError: return "client_error";
+        case Reason::Slow:        return "slow";
+        case Reason::Sampled:     return "sampled";
+    }
+    return "unknown";
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+// access log 표본 추출 (AccessLogMiddleware 가 사용).
+// 5xx 와 느린 요청은 항상, 4xx 는 초당 client_errors_per_second 개까지 기록하고,
+// 나머지는 1/sample_one_in 확률로 기록한다. 기록한 줄에는 그 줄이 대표하는 요청 수(sample)를 남겨
+// sample 값을 더하면 전체 요청 수를 추정할 수 있다 (항상 기록한 줄은 sample=1).
+class LogSampler {
+public:
+    struct Settings {
+        bool enabled = false;               // false 이면 모든 요청을 기록
+        uint32_t sample_one_in = 100;       // 빠른 정상 요청은 N 개 중 하나만 기록
+        uint32_t client_errors_per_second = 20;     // 이 수까지의 4xx 는 항상 기록
+        int64_t slow_us = 500000;           // 이보다 오래 걸린 요청은 항상 기록
+        std::map<std::string, int64_t> route_slow_us;   // 라우트별 기준 ("GET /members/{id}")
+    };
+
+    enum class Reason { All, Error, ClientError, Slow, Sampled };
+
+    struct Decision {
+        bool log = true;
+        uint32_t sample = 1;                // 이 줄이 대표하는 요청 수
+        Reason reason = Reason::All;
+    };
+
+private:
+    std::shared_ptr<const Settings> settings = std::make_shared<const Settings>();
+
+    // 현재 초와 그 초에 기록한 4xx 수
+    std::atomic<int64_t> client_error_second{0};
+    std::atomic<uint32_t> client_errors{0};
+
+public:
+    void configure(const Settings& s);
+
+    bool enabled() const;
+
+    // 라우트별 기준이 있는지 (없으면 route 를 만들지 않아도 된다)
+    bool hasRouteThresholds() const;
+
+    // now_second 는 4xx 비율 계산용 현재 시각 (초)
+    Decision decide(const std::string& route, int status, int64_t duration_us, int64_t now_second);
+
+    static const char* reasonName(Reason reason);
+
+private:
+    std::shared_ptr<const Settings> current() const;
+    bool allowClientError(uint32_t limit, int64_t now_second);
+    static bool sampleOne(uint32_t one_in);
+};
@@ -0,0 +1,418 @@
+#include "ngram_index.h"
+#include <algorithm>
+#include <mutex>
+
+namespace {
+
+// n-gram 키 공간 (상위 비트로 구분)
+constexpr uint64_t kJamoSpace = 0;
+constexpr uint64_t kInitialsSpace = 1ULL << 63;
+constexpr uint64_t kBigramFlag = 1ULL << 62;
+
+// 한글 음절 분해 상수
+constexpr char32_t kSyllableBase = 0xAC00;
+constexpr char32_t kSyllableLast = 0xD7A3;
+constexpr int kVowelCount = 21;
+constexpr int kFinalCount = 28;
+
+// 초성 인덱스 → 호환 자모
+constexpr char32_t kInitialJamo[19] = {
+    0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+
+// 종성 인덱스(1부터) → 호환 자모
+constexpr char32_t kFinalJamo[kFinalCount] = {
+    0, 0x3131, 0x3132, 0x3133, 0x3134, 0x3135, 0x3136, 0x3137, 0x3139, 0x313A,
+    0x313B, 0x313C, 0x313D, 0x313E, 0x313F, 0x3140, 0x3141, 0x3142, 0x3144, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+
+// 첫 호환 모음 (ㅏ)
+constexpr char32_t kFirstVowel = 0x314F;
+
+// 복합 자모를 구성 자모로 분리 (입력 중인 질의와 맞추기 위함)
+bool splitCompound(char32_t jamo, char32_t& first, char32_t& second) {
+    switch (jamo) {
+        case 0x3133: first = 0x3131; second = 0x3145; return true; // ㄳ
+        case 0x3135: first = 0x3134; second = 0x3148; return true; // ㄵ
+        case 0x3136: first = 0x3134; second = 0x314E; return true; // ㄶ
+        case 0x313A: first = 0x3139; second = 0x3131; return true; // ㄺ
+        case 0x313B: first = 0x3139; second = 0x3141; return true; // ㄻ
+        case 0x313C: first = 0x3139; second = 0x3142; return true; // ㄼ
+        case 0x313D: first = 0x3139; second = 0x3145; return true; // ㄽ
+        case 0x313E: first = 0x3139; second = 0x314C; return true; // ㄾ
+        case 0x313F: first = 0x3139; second = 0x314D; return true; // ㄿ
+        case 0x3140: first = 0x3139; second = 0x314E; return true; // ㅀ
+        case 0x3144: first = 0x3142; second = 0x3145; return true; // ㅄ
+        case 0x3158: first = 0x3157; second = 0x314F; return true; // ㅘ
+        case 0x3159: first = 0x3157; second = 0x3150; return true; // ㅙ
+        case 0x315A: first = 0x3157; second = 0x3163; return true; // ㅚ
+        case 0x315D: first = 0x315C; second = 0x3153; return true; // ㅝ
+        case 0x315E: first = 0x315C; second = 0x3154; return true; // ㅞ
+        case 0x315F: first = 0x315C; second = 0x3163; return true; // ㅟ
+        case 0x3162: first = 0x3161; second = 0x3163; return true; // ㅢ
+        default: return false;
+    }
+}
+
+void appendJamo(std::u32string& out, char32_t jamo) {
+    char32_t first, second;
+    if (splitCompound(jamo, first, second)) {
+        out.push_back(first);
+        out.push_back(second);
+    } else {
+        out.push_back(jamo);
+    }
+}
+
+bool isSyllable(char32_t c) {
+    return c >= kSyllableBase && c <= kSyllableLast;
+}
+
+bool isCompatibilityConsonant(char32_t c) {
+    return c >= 0x3131 && c <= 0x314E;
+}
+
+bool isSpace(char32_t c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+char32_t foldCase(char32_t c) {
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// UTF-8 디코딩 (잘못된 바이트는 건너뜀)
+std::u32string decodeUtf8(const std::string& text) {
+    std::u32string out;
+    out.reserve(text.size());
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        int extra = lead < 0x80 ? 0 : (lead >> 5) == 0x6 ? 1 : (lead >> 4) == 0xE ? 2 : (lead >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0 || i + extra >= text.size()) {
+            ++i;
+            continue;
+        }
+        char32_t cp = extra == 0 ? lead : lead & (0x3F >> extra);
+        bool valid = true;
+        for (int k = 1; k <= extra; ++k) {
+            unsigned char next = static_cast<unsigned char>(text[i + k]);
+            if ((next & 0xC0) != 0x80) {
+                valid = false;
+                break;
+            }
+            cp = (cp << 6) | (next & 0x3F);
+        }
+        if (valid) {
+            out.push_back(cp);
+            i += extra + 1;
+        } else {
+            ++i;
+        }
+    }
+    return out;
+}
+
+uint64_t packGram(const char32_t* units, size_t n, uint64_t space) {
+    uint64_t key = space | (n == 2 ? kBigramFlag : 0);
+    for (size_t i = 0; i < n; ++i) {
+        key |= static_cast<uint64_t>(units[i] & 0x1FFFFF) << (21 * (n - 1 - i));
+    }
+    return key;
+}
+
+} // namespace
+
+void NgramIndex::PostingList::append(uint32_t doc) {
+    uint32_t delta = count == 0 ? doc : doc - last;
+    while (delta >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(delta));
+    last = doc;
+    count++;
+}
+
+std::vector<uint32_t> NgramIndex::PostingList::decode() const {
+    std::vector<uint32_t> docs;
+    docs.reserve(count);
+    uint32_t value = 0;
+    uint32_t delta = 0;
+    int shift = 0;
+    for (uint8_t byte : bytes) {
+        delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (byte & 0x80) {
+            shift += 7;
+            continue;
+        }
+        value = docs.empty() ? delta : value + delta;
+        docs.push_back(value);
+        delta = 0;
+        shift = 0;
+    }
+    return docs;
+}
+
+void NgramIndex::upsert(const std::string& key, const std::string& text) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = document_by_key.find(key);
+    if (it != document_by_key.end()) {
+        removeLocked(it->second);
+    }
+    insertLocked(key, text);
+    compactLocked();
+}
+
+void NgramIndex::remove(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto it = document_by_key.find(key);
+    if (it != document_by_key.end()) {
+        removeLocked(it->second);
+        compactLocked();
+    }
+}
+
+void NgramIndex::rebuild(const std::vector<std::pair<std::string, std::string>>& entries) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    documents.clear();
+    document_by_key.clear();
+    postings.clear();
+    dead_documents = 0;
+    for (const auto& entry : entries) {
+        auto it = document_by_key.find(entry.first);
+        if (it != document_by_key.end()) {
+            removeLocked(it->second);
+        }
+        insertLocked(entry.first, entry.second);
+    }
+    compactLocked();
+}
+
+std::vector<std::string> NgramIndex::search(const std::string& query, size_t limit) const {
+    std::u32string units = normalize(query);
+    while (!units.empty() && units.back() == ' ') {
+        units.pop_back();
+    }
+    if (units.empty() || limit == 0) {
+        return {};
+    }
+
+    // 초성 질의는 초성 시퀀스에서, 그 외에는 자모 시퀀스에서 찾는다
+    const bool by_initials = isInitialsQuery(units);
+    if (by_initials) {
+        units = initials(query);
+    }
+
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<uint32_t> docs = candidates(units, by_initials ? kInitialsSpace : kJamoSpace);
+
+    struct Match {
+        size_t position;
+        size_t length;
+        uint32_t doc;
+    };
+    std::vector<Match> matches;
+    for (uint32_t doc : docs) {
+        const Document& document = documents[doc];
+        if (!document.alive) {
+            continue;
+        }
+        // n-gram 교집합은 후보일 뿐이므로 실제 부분 문자열 일치를 확인
+        const std::u32string& haystack = by_initials ? document.initials : document.units;
+        size_t position = haystack.find(units);
+        if (position != std::u32string::npos) {
+            matches.push_back({position, haystack.size(), doc});
+        }
+    }
+
+    size_t count = std::min(limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), [](const Match& a, const Match& b) {
+        if (a.position != b.position) return a.position < b.position;
+        if (a.length != b.length) return a.length < b.length;
+        return a.doc < b.doc;
+    });
+
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys.push_back(documents[matches[i].doc].key);
+    }
+    return keys;
+}
+
+size_t NgramIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return document_by_key.size();
+}
+
+size_t NgramIndex::postingBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    size_t total = 0;
+    for (const auto& entry : postings) {
+        total += entry.second.bytes.size();
+    }
+    return total;
+}
+
+std::u32string NgramIndex::normalize(const std::string& text) {
+    std::u32string out;
+    bool pending_space = false;
+    for (char32_t c : decodeUtf8(text)) {
+        if (isSpace(c)) {
+            pending_space = !out.empty();
+            continue;
+        }
+        if (pending_space) {
+            out.push_back(' ');
+            pending_space = false;
+        }
+        if (isSyllable(c)) {
+            int index = static_cast<int>(c - kSyllableBase);
+            int initial = index / (kVowelCount * kFinalCount);
+            int vowel = (index % (kVowelCount * kFinalCount)) / kFinalCount;
+            int final = index % kFinalCount;
+            out.push_back(kInitialJamo[initial]);
+            appendJamo(out, kFirstVowel + vowel);
+            if (final != 0) {
+                appendJamo(out, kFinalJamo[final]);
+            }
+        } else if (c >= 0x3131 && c <= 0x3163) {
+            appendJamo(out, c);
+        } else {
+            out.push_back(foldCase(c));
+        }
+    }
+    return out;
+}
+
+std::u32string NgramIndex::initials(const std::string& text) {
+    std::u32string out;
+    for (char32_t c : decodeUtf8(text)) {
+        if (isSpace(c)) {
+            continue;
+        }
+        if (isSyllable(c)) {
+            out.push_back(kInitialJamo[(c - kSyllableBase) / (kVowelCount * kFinalCount)]);
+        } else {
+            out.push_back(foldCase(c));
+        }
+    }
+    return out;
+}
+
+bool NgramIndex::isInitialsQuery(const std::u32string& query) {
+    bool any = false;
+    for (char32_t c : query) {
+        if (c == ' ') {
+            continue;
+        }
+        if (!isCompatibilityConsonant(c)) {
+            return false;
+        }
+        any = true;
+    }
+    return any;
+}
+
+void NgramIndex::insertLocked(const std::string& key, const std::string& text) {
+    uint32_t doc = static_cast<uint32_t>(documents.size());
+    documents.push_back(Document{key, normalize(text), initials(text), true});
+    document_by_key[key] = doc;
+    addGrams(documents[doc].units, kJamoSpace, doc);
+    addGrams(documents[doc].initials, kInitialsSpace, doc);
+}
+
+void NgramIndex::removeLocked(uint32_t doc) {
+    // 포스팅 리스트는 그대로 두고 문서만 죽은 것으로 표시 (검색에서 건너뛰고, compactLocked() 가 재구성할 때 빠진다)
+    Document& document = documents[doc];
+    document_by_key.erase(document.key);
+    document.alive = false;
+    document.units.clear();
+    document.initials.clear();
+    dead_documents++;
+}
+
+void NgramIndex::compactLocked() {
+    // 삭제된 문서 번호가 절반을 넘으면 번호를 다시 매겨 색인을 재구성
+    if (dead_documents == 0 || dead_documents * 2 < documents.size()) {
+        return;
+    }
+    std::vector<Document> alive;
+    alive.reserve(documents.size() - dead_documents);
+    for (auto& document : documents) {
+        if (document.alive) {
+            alive.push_back(std::move(document));
+        }
+    }
+    documents.clear();
+    document_by_key.clear();
+    postings.clear();
+    dead_documents = 0;
+    for (auto& document : alive) {
+        uint32_t doc = static_cast<uint32_t>(documents.size());
+        document_by_key[document.key] = doc;
+        documents.push_back(std::move(document));
+        addGrams(documents[doc].units, kJamoSpace, doc);
+        addGrams(documents[doc].initials, kInitialsSpace, doc);
+    }
+}
+
+void NgramIndex::addGrams(const std::u32string& units, uint64_t space, uint32_t doc) {
+    // 새 문서 번호는 항상 가장 크므로 포스팅 리스트 끝에 덧붙이기만 하면 된다
+    for (uint64_t gram : grams(units, space)) {
+        postings[gram].append(doc);
+    }
+}
+
+std::vector<uint32_t> NgramIndex::candidates(const std::u32string& units, uint64_t space) const {
+    // 한 글자(자모 하나) 질의는 n-gram 이 없으므로 전체 문서가 후보
+    if (units.size() < 2) {
+        std::vector<uint32_t> all;
+        all.reserve(documents.size());
+        for (uint32_t doc = 0; doc < documents.size(); ++doc) {
+            all.push_back(doc);
+        }
+        return all;
+    }
+
+    std::vector<const PostingList*> lists;
+    for (uint64_t gram : grams(units, space, true)) {
+        auto it = postings.find(gram);
+        if (it == postings.end()) {
+            return {};
+        }
+        lists.push_back(&it->second);
+    }
+    // 짧은 리스트부터 교집합
+    std::sort(lists.begin(), lists.end(), [](const PostingList* a, const PostingList* b) {
+        return a->count < b->count;
+    });
+
+    std::vector<uint32_t> result = lists.front()->decode();
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        std::vector<uint32_t> next = lists[i]->decode();
+        std::vector<uint32_t> merged;
+        std::set_intersection(result.begin(), result.end(), next.begin(), next.end(), std::back_inserter(merged));
+        result.swap(merged);
+    }
+    return result;
+}
+
+std::vector<uint64_t> NgramIndex::grams(const std::u32string& units, uint64_t space, bool for_query) {
+    // 색인에는 bigram 과 trigram 을 모두 넣고, 질의는 세 단위 이상이면 trigram 만 사용
+    const bool bigrams = !for_query || units.size() < 3;
+    std::vector<uint64_t> result;
+    for (size_t i = 0; i + 2 <= units.size(); ++i) {
+        if (bigrams) {
+            result.push_back(packGram(units.data() + i, 2, space));
+        }
+        if (i + 3 <= units.size()) {
+            result.push_back(packGram(units.data() + i, 3, space));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
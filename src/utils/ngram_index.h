@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 이름 검색용 메모리 역색인.
+// 한글 음절은 자모 단위로 분해(복합 자모도 분리)한 뒤 자모 bigram/trigram 을 색인하므로
+// "노트ㅂ" 처럼 입력 중인 질의도 "노트북" 과 일치한다.
+// 초성만으로 된 질의("ㅈㅈㅂ")는 별도의 초성 n-gram 으로 검색한다.
+// 포스팅 리스트는 문서 번호의 차분을 varint 로 압축해 저장한다.
+// 삭제/교체된 문서는 표시만 해 두고, 죽은 문서가 절반을 넘으면 번호를 다시 매겨 포스팅 리스트를 재구성한다.
+class NgramIndex {
+private:
+    // 압축 포스팅 리스트 (문서 번호 오름차순)
+    struct PostingList {
+        std::vector<uint8_t> bytes;
+        uint32_t count = 0;
+        uint32_t last = 0;
+
+        void append(uint32_t doc);
+        std::vector<uint32_t> decode() const;
+    };
+
+    struct Document {
+        std::string key;
+        std::u32string units;    // 정규화된 자모 시퀀스
+        std::u32string initials; // 초성 시퀀스
+        bool alive = true;
+    };
+
+    mutable std::shared_mutex mutex;
+    std::vector<Document> documents;
+    std::unordered_map<std::string, uint32_t> document_by_key;
+    std::unordered_map<uint64_t, PostingList> postings;
+    size_t dead_documents = 0;
+
+public:
+    // 키의 텍스트를 색인 (이미 있으면 교체)
+    void upsert(const std::string& key, const std::string& text);
+
+    void remove(const std::string& key);
+
+    // 전체 문서를 새로 색인
+    void rebuild(const std::vector<std::pair<std::string, std::string>>& entries);
+
+    // 질의와 일치하는 키 목록 (앞쪽에서 일치할수록, 짧은 텍스트일수록 먼저)
+    std::vector<std::string> search(const std::string& query, size_t limit) const;
+
+    size_t size() const;
+
+    // 포스팅 리스트 압축 후 크기 (바이트)
+    size_t postingBytes() const;
+
+    // 텍스트를 검색 단위(자모 분해, 소문자, 공백 정리)로 정규화
+    static std::u32string normalize(const std::string& text);
+
+    // 텍스트의 초성 시퀀스 (한글 외 문자는 소문자로 유지, 공백 제외)
+    static std::u32string initials(const std::string& text);
+
+    // 질의가 초성(호환 자음)으로만 이루어졌는지
+    static bool isInitialsQuery(const std::u32string& query);
+
+private:
+    void insertLocked(const std::string& key, const std::string& text);
+    void removeLocked(uint32_t doc);
+    void compactLocked();
+    void addGrams(const std::u32string& units, uint64_t space, uint32_t doc);
+    std::vector<uint32_t> candidates(const std::u32string& units, uint64_t space) const;
+
+    static std::vector<uint64_t> grams(const std::u32string& units, uint64_t space, bool for_query = false);
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// 일정 간격으로 작업을 실행하는 백그라운드 스레드. 소멸 시 대기 중이면 바로 종료한다.
+class PeriodicTask {
+private:
+    std::function<void()> task;
+    std::atomic<int64_t> interval_ms;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+    std::thread thread;
+
+public:
+    PeriodicTask(std::chrono::milliseconds interval, std::function<void()> fn)
+        : task(std::move(fn)), interval_ms(interval.count()) {
+        thread = std::thread([this] { run(); });
+    }
+
+    ~PeriodicTask() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    PeriodicTask(const PeriodicTask&) = delete;
+    PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+    // 실행 간격 변경 (다음 대기부터 적용)
+    void setInterval(std::chrono::milliseconds interval) {
+        interval_ms = interval.count();
+        condition.notify_all();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto next = std::chrono::steady_clock::now() + std::chrono::milliseconds(interval_ms.load());
+        while (!stopping) {
+            condition.wait_until(lock, next);
+            if (stopping) {
+                break;
+            }
+            if (std::chrono::steady_clock::now() >= next) {
+                lock.unlock();
+                try {
+                    task();
+                } catch (const std::exception& e) {
+                    std::cerr << "Periodic task failed: " << e.what() << std::endl;
+                }
+                lock.lock();
+                next = std::chrono::steady_clock::now() + std::chrono::milliseconds(interval_ms.load());
+            } else {
+                // 간격이 바뀌었을 수 있으므로 다음 실행 시각을 다시 계산
+                next = std::min(next, std::chrono::steady_clock::now() + std::chrono::milliseconds(interval_ms.load()));
+            }
+        }
+    }
+};
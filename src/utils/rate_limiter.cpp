@@ -0,0 +1,124 @@
+#include "rate_limiter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 샤드와 set 을 고를 때 하위 비트가 고르게 섞이도록 한 번 더 섞는다 (splitmix64 마무리 단계)
+uint64_t mix(uint64_t key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return key;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+RateLimiter::RateLimiter(const Settings& s)
+    : rate_per_second(s.rate_per_second),
+      burst(std::max(1.0, s.burst)) {
+    // 요청 경로에서 나눗셈 대신 비트 연산으로 샤드와 set 을 고르도록 2의 거듭제곱으로 맞춘다
+    size_t shard_count = roundUpToPowerOfTwo(std::max<size_t>(1, s.shards));
+    size_t sets_per_shard = roundUpToPowerOfTwo(std::max<size_t>(1, (s.capacity / shard_count + kWays - 1) / kWays));
+    shard_mask = shard_count - 1;
+    set_mask = sets_per_shard - 1;
+    shard_bits = 0;
+    while ((size_t(1) << shard_bits) < shard_count) {
+        shard_bits++;
+    }
+    shards = std::make_unique<Shard[]>(shard_count);
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards[i].slots.resize(sets_per_shard * kWays);
+    }
+}
+
+void RateLimiter::setRate(double rate, double burst_size) {
+    rate_per_second.store(rate, std::memory_order_relaxed);
+    burst.store(std::max(1.0, burst_size), std::memory_order_relaxed);
+}
+
+RateLimiter::Decision RateLimiter::acquire(uint64_t key, int64_t now_us) {
+    key = key == 0 ? 1 : key;
+    uint64_t mixed = mix(key);
+    Shard& shard = shards[mixed & shard_mask];
+    Slot* set = shard.slots.data() + ((mixed >> shard_bits) & set_mask) * kWays;
+    double rate = rate_per_second.load(std::memory_order_relaxed);
+    double capacity = burst.load(std::memory_order_relaxed);
+
+    Decision decision;
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Slot* slot = nullptr;
+    Slot* victim = set;
+    for (size_t way = 0; way < kWays; ++way) {
+        if (set[way].key == key) {
+            slot = &set[way];
+            break;
+        }
+        // 빈 슬롯을 우선하고, 없으면 가장 오래 갱신되지 않은 슬롯
+        if (victim->key != 0 && (set[way].key == 0 || set[way].updated_us < victim->updated_us)) {
+            victim = &set[way];
+        }
+    }
+
+    if (slot == nullptr) {
+        if (victim->key == 0) {
+            shard.used++;
+        } else {
+            shard.evictions++;
+        }
+        slot = victim;
+        slot->key = key;
+        slot->tokens = capacity;
+    } else if (now_us > slot->updated_us) {
+        double refill = static_cast<double>(now_us - slot->updated_us) * rate / 1e6;
+        slot->tokens = std::min(capacity, slot->tokens + refill);
+    }
+    slot->updated_us = std::max(slot->updated_us, now_us);
+
+    if (slot->tokens >= 1.0) {
+        slot->tokens -= 1.0;
+        return decision;
+    }
+    decision.allowed = false;
+    decision.retry_after_ms = rate > 0.0
+        ? static_cast<int64_t>(std::ceil((1.0 - slot->tokens) / rate * 1000.0))
+        : 60000;
+    return decision;
+}
+
+size_t RateLimiter::trackedKeys() {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].used;
+    }
+    return total;
+}
+
+uint64_t RateLimiter::evictions() {
+    uint64_t total = 0;
+    for (size_t i = 0; i <= shard_mask; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].evictions;
+    }
+    return total;
+}
+
+uint64_t RateLimiter::hash(std::string_view data, uint64_t seed) {
+    uint64_t hash = seed;
+    for (char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
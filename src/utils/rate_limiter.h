@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+// 키(클라이언트 IP, IP+라우트 등의 64비트 해시)별 token bucket.
+// 버킷은 고정 크기 표에 두며, 표는 샤드로 나뉘고 각 샤드는 8-way set-associative 로 구성된다.
+// 키가 속한 set 이 가득 차면 가장 오래 쓰이지 않은 버킷을 교체한다 (set 단위 근사 LRU).
+// 요청 경로에서 메모리 할당은 없고, 샤드 잠금은 버킷 하나를 갱신하는 동안만 잡는다.
+class RateLimiter {
+public:
+    struct Settings {
+        double rate_per_second = 50.0;  // 초당 채워지는 토큰 수
+        double burst = 100.0;           // 버킷 최대 토큰 수 (순간 허용량)
+        size_t capacity = 65536;        // 추적할 최대 버킷 수 (2의 거듭제곱으로 올림, 생성 후 변경 불가)
+        size_t shards = 64;             // 잠금 단위 (2의 거듭제곱으로 올림, 생성 후 변경 불가)
+    };
+
+    struct Decision {
+        bool allowed = true;
+        int64_t retry_after_ms = 0;     // 거절 시 토큰 하나가 다시 찰 때까지
+    };
+
+    static constexpr size_t kWays = 8;
+
+private:
+    struct Slot {
+        uint64_t key = 0;               // 0 은 빈 슬롯
+        double tokens = 0.0;
+        int64_t updated_us = 0;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<Slot> slots;        // sets * kWays
+        size_t used = 0;
+        uint64_t evictions = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shard_mask;                  // 샤드 수 - 1
+    size_t set_mask;                    // 샤드당 set 수 - 1
+    int shard_bits;
+
+    std::atomic<double> rate_per_second;
+    std::atomic<double> burst;
+
+public:
+    explicit RateLimiter(const Settings& s);
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // 채움 속도와 버킷 크기 변경 (설정 재로드). 기존 버킷은 남은 토큰을 유지한다
+    void setRate(double rate, double burst_size);
+
+    // 토큰 하나를 쓴다. now_us 는 steady_clock 기준 µs
+    Decision acquire(uint64_t key, int64_t now_us);
+
+    // 현재 추적 중인 버킷 수 / 교체된 버킷 수
+    size_t trackedKeys();
+    uint64_t evictions();
+
+    // 버킷 표 크기 (반올림 후)
+    size_t capacity() const { return (shard_mask + 1) * (set_mask + 1) * kWays; }
+
+    // 64비트 FNV-1a (seed 로 이어서 해시할 수 있다)
+    static uint64_t hash(std::string_view data, uint64_t seed = 14695981039346656037ull);
+};
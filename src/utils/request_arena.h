@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+// 요청 하나 동안만 쓰는 임시 메모리 (std::pmr 단조 할당기).
+// 내장 버퍼를 먼저 쓰고, 넘치면 new/delete 에서 큰 덩어리로 받아온다.
+// 개별 해제는 하지 않고 release() 로 한 번에 돌려준다.
+class RequestArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kInlineBytes = 16 * 1024;
+
+private:
+    alignas(std::max_align_t) std::byte buffer[kInlineBytes];
+    std::pmr::monotonic_buffer_resource resource;
+    size_t bytes_allocated = 0;
+    size_t allocation_count = 0;
+
+public:
+    RequestArena() : resource(buffer, sizeof(buffer), std::pmr::new_delete_resource()) {}
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    // 이 요청에서 할당한 메모리를 한 번에 반환 (내장 버퍼부터 다시 사용)
+    void release() {
+        resource.release();
+        bytes_allocated = 0;
+        allocation_count = 0;
+    }
+
+    size_t bytesAllocated() const { return bytes_allocated; }
+    size_t allocationCount() const { return allocation_count; }
+
+    // 다 쓴 아레나를 버리지 않고 재사용하기 위한 보관소.
+    // 요청마다 16KiB 버퍼를 새로 할당하지 않도록 한다.
+    class Pool {
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<RequestArena>> idle;
+        size_t capacity;
+
+    public:
+        explicit Pool(size_t capacity) : capacity(capacity) {}
+
+        std::unique_ptr<RequestArena> acquire() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!idle.empty()) {
+                    auto arena = std::move(idle.back());
+                    idle.pop_back();
+                    return arena;
+                }
+            }
+            return std::make_unique<RequestArena>();
+        }
+
+        // 보관 중인 아레나 수
+        size_t idleCount() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return idle.size();
+        }
+
+        void recycle(std::unique_ptr<RequestArena> arena) {
+            arena->release();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (idle.size() < capacity) {
+                idle.push_back(std::move(arena));
+            }
+        }
+    };
+
+    // 프로세스 전역 보관소 (동시 처리 요청 수 정도면 충분)
+    static Pool& pool() {
+        static Pool instance(256);
+        return instance;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        bytes_allocated += bytes;
+        allocation_count++;
+        return resource.allocate(bytes, alignment);
+    }
+
+    // 단조 할당기이므로 개별 해제는 하지 않음
+    void do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
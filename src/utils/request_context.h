@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include "request_arena.h"
+
+// 요청 처리 단계 (Server-Timing / access log 에 노출되는 순서)
+enum class Stage : size_t {
+    PoolAcquire = 0,  // 연결 풀에서 연결 획득
+    Query,            // mysql_query 실행
+    Fetch,            // 결과 저장 및 행 읽기
+    Serialize,        // JSON 직렬화
+    Body,             // 응답 본문 설정 (소켓 전송은 핸들러가 끝난 뒤라 포함되지 않음)
+    Count
+};
+
+inline const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::PoolAcquire: return "pool";
+        case Stage::Query:       return "query";
+        case Stage::Fetch:       return "fetch";
+        case Stage::Serialize:   return "json";
+        case Stage::Body:        return "body";
+        default:                 return "unknown";
+    }
+}
+
+// 단계별 누적 시간 (마이크로초)
+struct StageTimings {
+    std::array<int64_t, static_cast<size_t>(Stage::Count)> micros{};
+
+    void reset() { micros.fill(0); }
+
+    void add(Stage stage, int64_t us) { micros[static_cast<size_t>(stage)] += us; }
+
+    int64_t get(Stage stage) const { return micros[static_cast<size_t>(stage)]; }
+};
+
+// 스레드별 누적 할당 횟수/바이트 (할당 계측 빌드의 operator new 가 증가시킴)
+struct AllocationCounters {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+// 요청에 귀속된 할당량. 요청이 I/O 스레드와 executor 워커를 오가므로 원자적으로 누적한다
+struct AllocationTally {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+
+    AllocationTally() = default;
+
+    // crow 가 요청마다 context 를 새로 대입하므로 이동 가능해야 한다
+    AllocationTally(AllocationTally&& other) noexcept
+        : count(other.count.load(std::memory_order_relaxed)), bytes(other.bytes.load(std::memory_order_relaxed)) {}
+
+    AllocationTally& operator=(AllocationTally&& other) noexcept {
+        count.store(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
+    void add(uint64_t n, uint64_t size) {
+        count.fetch_add(n, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void reset() {
+        count.store(0, std::memory_order_relaxed);
+        bytes.store(0, std::memory_order_relaxed);
+    }
+};
+
+// 다 쓴 아레나를 전역 보관소로 돌려보내는 deleter
+struct RequestArenaRecycler {
+    void operator()(RequestArena* arena) const {
+        RequestArena::pool().recycle(std::unique_ptr<RequestArena>(arena));
+    }
+};
+
+// 요청 하나에 묶인 상태. AccessLogMiddleware 의 context 가 소유한다.
+struct RequestContext {
+    StageTimings timings;
+    int64_t stale_age_seconds = -1;     // DB 장애로 마지막 정상값을 응답했으면 그 값의 나이 (Warning/Age 헤더)
+    std::unique_ptr<RequestArena, RequestArenaRecycler> arena_storage;  // 처음 사용할 때 보관소에서 가져옴
+    AllocationTally allocations;        // 이 요청을 처리하는 동안의 힙 할당 (계측 빌드에서만 증가)
+
+    void reset() {
+        timings.reset();
+        stale_age_seconds = -1;
+        arena_storage.reset();
+        allocations.reset();
+    }
+
+    // 요청 범위 임시 메모리
+    RequestArena& arena() {
+        if (!arena_storage) {
+            arena_storage.reset(RequestArena::pool().acquire().release());
+        }
+        return *arena_storage;
+    }
+
+    // 응답 완료 시 임시 메모리를 한 번에 반환 (아레나 객체는 context 와 함께 보관소로)
+    void releaseArena() {
+        if (arena_storage) {
+            arena_storage->release();
+        }
+    }
+};
+
+namespace request_context {
+
+// 현재 스레드가 처리 중인 요청 (없으면 nullptr)
+inline RequestContext*& current() {
+    thread_local RequestContext* ctx = nullptr;
+    return ctx;
+}
+
+// 현재 스레드의 누적 할당량. operator new 안에서 호출되므로 할당하지 않는다
+inline AllocationCounters& threadAllocations() {
+    thread_local AllocationCounters counters;
+    return counters;
+}
+
+// 현재 요청에 마지막으로 반영한 시점의 스레드 누적 할당량
+inline AllocationCounters& allocationMark() {
+    thread_local AllocationCounters mark;
+    return mark;
+}
+
+// 마지막 반영 이후 이 스레드의 할당을 현재 요청에 반영
+inline void flushAllocations() {
+    AllocationCounters& counters = threadAllocations();
+    AllocationCounters& mark = allocationMark();
+    if (RequestContext* ctx = current()) {
+        ctx->allocations.add(counters.count - mark.count, counters.bytes - mark.bytes);
+    }
+    mark = counters;
+}
+
+// 현재 스레드의 요청 바인딩 변경 (이전 요청의 할당량을 먼저 반영)
+inline void bind(RequestContext* ctx) {
+    flushAllocations();
+    current() = ctx;
+}
+
+// 현재 요청이 마지막 정상값(age 초 전)으로 응답함을 표시
+inline void markStale(std::chrono::seconds age) {
+    if (RequestContext* ctx = current()) {
+        ctx->stale_age_seconds = std::max<int64_t>(ctx->stale_age_seconds, age.count());
+    }
+}
+
+// 현재 요청의 아레나 (바인딩된 요청이 없으면 기본 new/delete).
+// 아레나에서 할당한 객체는 res.end() 전에 소멸해야 한다 (응답 완료 시 메모리가 반환됨)
+inline std::pmr::memory_resource* arena() {
+    if (RequestContext* ctx = current()) {
+        return &ctx->arena();
+    }
+    return std::pmr::get_default_resource();
+}
+
+// 스코프 동안 현재 스레드에 요청 컨텍스트를 바인딩하고, 끝나면 이전 값으로 복원
+class Binding {
+private:
+    RequestContext* previous;
+
+public:
+    explicit Binding(RequestContext* ctx) : previous(current()) { bind(ctx); }
+    ~Binding() { bind(previous); }
+
+    Binding(const Binding&) = delete;
+    Binding& operator=(const Binding&) = delete;
+};
+
+} // namespace request_context
+
+// 스코프 동안의 경과 시간을 현재 요청의 해당 단계에 누적한다.
+// 바인딩된 요청이 없으면 아무 것도 기록하지 않는다.
+class StageTimer {
+private:
+    Stage stage;
+    std::chrono::high_resolution_clock::time_point start_time;
+    bool stopped = false;
+
+public:
+    explicit StageTimer(Stage s) : stage(s), start_time(std::chrono::high_resolution_clock::now()) {}
+
+    ~StageTimer() { stop(); }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+    // 스코프 종료 전에 측정을 끝낼 때 사용
+    void stop() {
+        if (stopped) {
+            return;
+        }
+        stopped = true;
+        RequestContext* ctx = request_context::current();
+        if (ctx == nullptr) {
+            return;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - start_time);
+        ctx->timings.add(stage, elapsed.count());
+    }
+};
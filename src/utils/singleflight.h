@@ -0,0 +1,57 @@
+#pragma once
+
+#include <exception>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+// 같은 키에 대한 동시 조회를 하나로 합친다.
+// 키에 대한 조회가 진행 중이면 뒤에 온 호출자는 새로 조회하지 않고 그 결과를 기다린다.
+// 조회가 끝나면 키는 바로 제거되므로 결과를 캐시하지는 않는다.
+template<typename Key, typename Value>
+class SingleFlight {
+private:
+    std::mutex mutex;
+    std::unordered_map<Key, std::shared_future<Value>> calls;
+
+public:
+    template<typename Fn>
+    Value run(const Key& key, Fn&& fn) {
+        std::promise<Value> promise;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            auto it = calls.find(key);
+            if (it != calls.end()) {
+                // 진행 중인 조회 결과를 공유
+                std::shared_future<Value> pending = it->second;
+                lock.unlock();
+                return pending.get();
+            }
+            calls.emplace(key, promise.get_future().share());
+        }
+
+        try {
+            Value value = fn();
+            forget(key);
+            promise.set_value(value);
+            return value;
+        } catch (...) {
+            forget(key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    // 현재 진행 중인 조회 수
+    size_t inFlight() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls.size();
+    }
+
+private:
+    void forget(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        calls.erase(key);
+    }
+};
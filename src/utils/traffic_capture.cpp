@@ -0,0 +1,412 @@
+#include "traffic_capture.h"
+#include "export_format.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <strings.h>
+
+namespace {
+
+constexpr char kBase64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int64_t steadyMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// decode() 용 최소 JSON 읽기 (encode() 가 만드는 형식만 다룬다)
+class LineReader {
+private:
+    std::string_view text;
+    size_t pos = 0;
+
+public:
+    explicit LineReader(std::string_view text) : text(text) {}
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return pos == text.size();
+    }
+
+    bool readString(std::string& out) {
+        out.clear();
+        if (!consume('"')) {
+            return false;
+        }
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out.push_back(c);
+                continue;
+            }
+            if (pos >= text.size()) {
+                return false;
+            }
+            char escaped = text[pos++];
+            switch (escaped) {
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'u': {
+                    if (pos + 4 > text.size()) {
+                        return false;
+                    }
+                    std::string digits(text.substr(pos, 4));
+                    char* end = nullptr;
+                    unsigned code = static_cast<unsigned>(std::strtoul(digits.c_str(), &end, 16));
+                    if (end != digits.c_str() + 4) {
+                        return false;
+                    }
+                    pos += 4;
+                    // BMP 범위만 (encode() 는 제어 문자에만 \u 를 쓴다)
+                    if (code < 0x80) {
+                        out.push_back(static_cast<char>(code));
+                    } else if (code < 0x800) {
+                        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                    } else {
+                        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+                    }
+                    break;
+                }
+                default: out.push_back(escaped); break;     // \" \\ \/
+            }
+        }
+        return false;
+    }
+
+    bool readInteger(int64_t& out) {
+        skipSpace();
+        size_t start = pos;
+        if (pos < text.size() && text[pos] == '-') {
+            ++pos;
+        }
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        if (pos == start) {
+            return false;
+        }
+        out = std::strtoll(std::string(text.substr(start, pos - start)).c_str(), nullptr, 10);
+        return pos > start + (text[start] == '-' ? 1 : 0);
+    }
+
+    bool readBool(bool& out) {
+        skipSpace();
+        if (text.substr(pos, 4) == "true") {
+            pos += 4;
+            out = true;
+            return true;
+        }
+        if (text.substr(pos, 5) == "false") {
+            pos += 5;
+            out = false;
+            return true;
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+TrafficCapture::~TrafficCapture() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+}
+
+void TrafficCapture::configure(const Settings& s) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    bool reopen = s.enabled && (!enabled.load() || s.path != settings.path || !file.is_open());
+    settings = s;
+    sample_rate = std::max(0.0, std::min(1.0, s.sample_rate));
+
+    if (!s.enabled) {
+        enabled = false;
+        return;
+    }
+    if (reopen) {
+        if (file.is_open()) {
+            file.close();
+        }
+        file.open(s.path, std::ios::out | std::ios::app | std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open traffic capture file: " << s.path << std::endl;
+            enabled = false;
+            return;
+        }
+        file.seekp(0, std::ios::end);
+        file_bytes = static_cast<size_t>(std::max<std::streamoff>(0, file.tellp()));
+        started_us = steadyMicros();
+    }
+    if (!writer.joinable()) {
+        writer = std::thread([this] { writeLoop(); });
+    }
+    enabled = true;
+}
+
+bool TrafficCapture::sample() {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    double rate = sample_rate.load(std::memory_order_relaxed);
+    if (rate >= 1.0) {
+        return true;
+    }
+    thread_local std::mt19937 generator(std::random_device{}());
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    return distribution(generator) < rate;
+}
+
+int64_t TrafficCapture::offsetMicros() const {
+    return steadyMicros() - started_us.load(std::memory_order_relaxed);
+}
+
+void TrafficCapture::submit(Entry entry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!enabled.load() || pending.size() >= settings.queue_capacity) {
+            dropped++;
+            return;
+        }
+        if (entry.body.size() > settings.max_body_bytes) {
+            entry.body.resize(settings.max_body_bytes);
+            entry.body_truncated = true;
+        }
+        pending.push_back(std::move(entry));
+    }
+    condition.notify_one();
+}
+
+void TrafficCapture::writeLoop() {
+    while (true) {
+        std::deque<Entry> batch;
+        size_t max_file_bytes;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty() && stopping) {
+                break;
+            }
+            batch.swap(pending);
+            max_file_bytes = settings.max_file_bytes;
+        }
+
+        std::string lines;
+        for (const Entry& entry : batch) {
+            lines += encode(entry);
+            lines += '\n';
+        }
+
+        std::lock_guard<std::mutex> lock(fileMutex);
+        if (!file.is_open() || file_bytes + lines.size() > max_file_bytes) {
+            dropped += batch.size();
+            continue;
+        }
+        file.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        file.flush();
+        file_bytes += lines.size();
+        captured += batch.size();
+    }
+}
+
+bool TrafficCapture::isSensitiveHeader(std::string_view name) {
+    for (const char* sensitive : {"authorization", "cookie", "proxy-authorization", "x-api-key"}) {
+        if (name.size() == std::char_traits<char>::length(sensitive) &&
+            strncasecmp(name.data(), sensitive, name.size()) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string TrafficCapture::encode(const Entry& entry) {
+    std::string line = "{\"t\":" + std::to_string(entry.offset_us) + ",\"m\":";
+    export_format::appendJsonString(line, entry.method);
+    line += ",\"u\":";
+    export_format::appendJsonString(line, entry.url);
+    line += ",\"h\":{";
+    for (size_t i = 0; i < entry.headers.size(); ++i) {
+        line += (i > 0 ? "," : "");
+        export_format::appendJsonString(line, entry.headers[i].first);
+        line += ':';
+        export_format::appendJsonString(line, entry.headers[i].second);
+    }
+    line += '}';
+    if (!entry.body.empty()) {
+        if (isValidUtf8(entry.body)) {
+            line += ",\"b\":";
+            export_format::appendJsonString(line, entry.body);
+        } else {
+            line += ",\"b64\":\"" + base64Encode(entry.body) + "\"";
+        }
+    }
+    if (entry.body_truncated) {
+        line += ",\"bt\":true";
+    }
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(entry.response_hash));
+    line += ",\"s\":" + std::to_string(entry.status) +
+            ",\"d\":" + std::to_string(entry.duration_us) +
+            ",\"rl\":" + std::to_string(entry.response_bytes) +
+            ",\"rh\":\"" + hash + "\"}";
+    return line;
+}
+
+bool TrafficCapture::decode(std::string_view line, Entry& entry) {
+    entry = Entry();
+    LineReader reader(line);
+    if (!reader.consume('{')) {
+        return false;
+    }
+    std::string key;
+    std::string value;
+    int64_t number = 0;
+    bool first = true;
+    while (!reader.consume('}')) {
+        if ((!first && !reader.consume(',')) || !reader.readString(key) || !reader.consume(':')) {
+            return false;
+        }
+        first = false;
+        if (key == "h") {
+            if (!reader.consume('{')) {
+                return false;
+            }
+            bool first_header = true;
+            while (!reader.consume('}')) {
+                std::string name;
+                if ((!first_header && !reader.consume(',')) || !reader.readString(name) ||
+                    !reader.consume(':') || !reader.readString(value)) {
+                    return false;
+                }
+                first_header = false;
+                entry.headers.emplace_back(std::move(name), value);
+            }
+        } else if (key == "m" || key == "u" || key == "b" || key == "b64" || key == "rh") {
+            if (!reader.readString(value)) {
+                return false;
+            }
+            if (key == "m") entry.method = value;
+            else if (key == "u") entry.url = value;
+            else if (key == "b") entry.body = value;
+            else if (key == "b64") entry.body = base64Decode(value);
+            else entry.response_hash = std::strtoull(value.c_str(), nullptr, 16);
+        } else if (key == "bt") {
+            if (!reader.readBool(entry.body_truncated)) {
+                return false;
+            }
+        } else {
+            if (!reader.readInteger(number)) {
+                return false;
+            }
+            if (key == "t") entry.offset_us = number;
+            else if (key == "s") entry.status = static_cast<int>(number);
+            else if (key == "d") entry.duration_us = number;
+            else if (key == "rl") entry.response_bytes = static_cast<size_t>(number);
+            // 모르는 숫자 필드는 무시 (이후 형식 확장용)
+        }
+    }
+    return reader.atEnd() && !entry.method.empty() && !entry.url.empty();
+}
+
+uint64_t TrafficCapture::hashBody(std::string_view body) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : body) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool TrafficCapture::isValidUtf8(std::string_view text) {
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        size_t extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : 4;
+        if (extra == 4 || i + extra >= text.size()) {
+            return false;
+        }
+        for (size_t k = 1; k <= extra; ++k) {
+            if ((static_cast<unsigned char>(text[i + k]) >> 6) != 0x2) {
+                return false;
+            }
+        }
+        i += extra + 1;
+    }
+    return true;
+}
+
+std::string TrafficCapture::base64Encode(std::string_view data) {
+    std::string out;
+    out.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    while (i + 2 < data.size()) {
+        uint32_t n = (static_cast<unsigned char>(data[i]) << 16) | (static_cast<unsigned char>(data[i + 1]) << 8) |
+                     static_cast<unsigned char>(data[i + 2]);
+        out += kBase64Alphabet[(n >> 18) & 63];
+        out += kBase64Alphabet[(n >> 12) & 63];
+        out += kBase64Alphabet[(n >> 6) & 63];
+        out += kBase64Alphabet[n & 63];
+        i += 3;
+    }
+    if (i < data.size()) {
+        uint32_t n = static_cast<unsigned char>(data[i]) << 16;
+        if (i + 1 < data.size()) {
+            n |= static_cast<unsigned char>(data[i + 1]) << 8;
+        }
+        out += kBase64Alphabet[(n >> 18) & 63];
+        out += kBase64Alphabet[(n >> 12) & 63];
+        out += i + 1 < data.size() ? kBase64Alphabet[(n >> 6) & 63] : '=';
+        out += '=';
+    }
+    return out;
+}
+
+std::string TrafficCapture::base64Decode(std::string_view text) {
+    std::string out;
+    uint32_t buffer = 0;
+    int bits = 0;
+    for (char c : text) {
+        const char* position = std::char_traits<char>::find(kBase64Alphabet, 64, c);
+        if (position == nullptr) {
+            continue;   // '=' 및 공백
+        }
+        buffer = (buffer << 6) | static_cast<uint32_t>(position - kBase64Alphabet);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((buffer >> bits) & 0xFF));
+        }
+    }
+    return out;
+}
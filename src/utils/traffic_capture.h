@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 실제 요청 샘플을 JSONL 파일로 기록하는 트래픽 캡처 (AccessLogMiddleware 가 사용).
+// 한 줄이 요청 하나이며 tools/replay 의 traffic_replay 가 같은 형식을 읽는다.
+//   {"t":캡처 시작 후 µs,"m":"POST","u":"/members?x=1","h":{"Content-Type":"..."},"b":"본문",
+//    "s":201,"d":처리 µs,"rl":응답 바이트,"rh":"응답 본문 FNV-1a"}
+// UTF-8 이 아닌 본문은 "b" 대신 base64 로 "b64" 에 담는다.
+// 파일 쓰기는 백그라운드 스레드가 하며, 대기열이 차면 요청을 기다리게 하지 않고 버린다.
+class TrafficCapture {
+public:
+    struct Settings {
+        bool enabled = false;
+        std::string path = "capture.jsonl";
+        double sample_rate = 0.01;              // 기록할 요청 비율
+        size_t max_body_bytes = 64 * 1024;      // 이보다 큰 본문은 잘라서 기록 ("bt":true)
+        size_t max_file_bytes = 512ull * 1024 * 1024;   // 파일이 이 크기에 이르면 기록 중단
+        size_t queue_capacity = 4096;
+    };
+
+    struct Entry {
+        int64_t offset_us = 0;
+        std::string method;
+        std::string url;                        // 쿼리 문자열 포함
+        std::vector<std::pair<std::string, std::string>> headers;
+        std::string body;
+        bool body_truncated = false;
+        int status = 0;
+        int64_t duration_us = 0;
+        size_t response_bytes = 0;
+        uint64_t response_hash = 0;
+    };
+
+private:
+    std::mutex mutex;                           // settings, pending, stopping, writer 보호
+    std::condition_variable condition;
+    Settings settings;
+    std::deque<Entry> pending;
+    bool stopping = false;
+    std::thread writer;
+
+    // 파일 쓰기 중에도 submit() 이 막히지 않도록 파일은 따로 보호 (둘 다 잡을 때는 mutex 먼저)
+    std::mutex fileMutex;
+    std::ofstream file;
+    size_t file_bytes = 0;
+
+    std::atomic<int64_t> started_us{0};         // 캡처를 켠 시각 (steady_clock, µs)
+
+    std::atomic<bool> enabled{false};
+    std::atomic<double> sample_rate{0.0};
+    std::atomic<uint64_t> captured{0};
+    std::atomic<uint64_t> dropped{0};
+
+public:
+    TrafficCapture() = default;
+    ~TrafficCapture();
+
+    TrafficCapture(const TrafficCapture&) = delete;
+    TrafficCapture& operator=(const TrafficCapture&) = delete;
+
+    // 설정 적용. 경로가 바뀌거나 새로 켜지면 파일을 (추가 모드로) 연다
+    void configure(const Settings& s);
+
+    // 이번 요청을 기록할지 (꺼져 있으면 항상 false)
+    bool sample();
+
+    // 캡처 시작 후 경과 시간 (µs)
+    int64_t offsetMicros() const;
+
+    // 대기열에 추가 (가득 차면 버림)
+    void submit(Entry entry);
+
+    uint64_t capturedCount() const { return captured.load(); }
+    uint64_t droppedCount() const { return dropped.load(); }
+
+    // 기록에서 제외하는 헤더 (인증 정보)
+    static bool isSensitiveHeader(std::string_view name);
+
+    // JSONL 한 줄 (개행 제외)
+    static std::string encode(const Entry& entry);
+
+    // encode() 의 역. 형식이 맞지 않으면 false
+    static bool decode(std::string_view line, Entry& entry);
+
+    // 응답 본문 비교용 64비트 FNV-1a
+    static uint64_t hashBody(std::string_view body);
+
+    static bool isValidUtf8(std::string_view text);
+    static std::string base64Encode(std::string_view data);
+    static std::string base64Decode(std::string_view text);
+
+private:
+    void writeLoop();
+};
@@ -42,7 +42,7 @@ void testServiceOperations() {
     
     // 멤버 조회 테스트
     try {
-        auto members = memberService.getAllMembers();
+        auto members = memberService.getAllRows();
         BENCHMARK_CHECKPOINT("Get all members");
         std::cout << "Found " << members.size() << " members" << std::endl;
     } catch (const std::exception& e) {
@@ -51,7 +51,7 @@ void testServiceOperations() {
     
     // 제품 조회 테스트
     try {
-        auto products = productService.getAllProducts();
+        auto products = productService.getAllRows();
         BENCHMARK_CHECKPOINT("Get all products");
         std::cout << "Found " << products.size() << " products" << std::endl;
     } catch (const std::exception& e) {
@@ -78,7 +78,7 @@ void testConcurrentOperations() {
             
             for (int j = 0; j < operations_per_thread; ++j) {
                 try {
-                    auto members = memberService.getAllMembers();
+                    auto members = memberService.getAllRows();
                     if (j == 0) {
                         std::cout << "Thread " << i << " found " << members.size() << " members" << std::endl;
                     }
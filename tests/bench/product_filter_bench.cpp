@@ -0,0 +1,75 @@
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../src/utils/benchmark.h"
+#include "../../src/repository/product_snapshot.h"
+
+// 100만 개 상품 스냅샷에 대한 필터 커널별 스캔 시간 측정
+namespace {
+
+constexpr size_t kProductCount = 1000000;
+constexpr int kIterations = 20;
+
+std::vector<ProductRow> generateProducts() {
+    std::mt19937 rng(2024);
+    const std::vector<std::string> categories = {
+        "전자제품", "가구", "의류", "식품", "도서", "스포츠", "완구", "뷰티"
+    };
+    
+    std::vector<ProductRow> rows;
+    rows.reserve(kProductCount);
+    for (size_t i = 0; i < kProductCount; ++i) {
+        rows.push_back({"p" + std::to_string(i), "product-" + std::to_string(i),
+                        static_cast<int32_t>(rng() % 1000000), categories[rng() % categories.size()]});
+    }
+    return rows;
+}
+
+void runFilter(const ProductSnapshot& snapshot, const std::string& label, const ProductFilter& filter) {
+    for (auto kernel : {ProductSnapshot::Kernel::Scalar, ProductSnapshot::Kernel::SSE, ProductSnapshot::Kernel::AVX2}) {
+        if (!ProductSnapshot::kernelSupported(kernel)) {
+            std::cout << "[" << label << " / " << ProductSnapshot::kernelName(kernel) << "] skipped (unsupported)" << std::endl;
+            continue;
+        }
+        
+        size_t matched = 0;
+        std::string name = label + " / " + ProductSnapshot::kernelName(kernel) + " x" + std::to_string(kIterations);
+        {
+            BENCHMARK(name);
+            for (int i = 0; i < kIterations; ++i) {
+                matched += snapshot.filter(filter, kernel).size();
+            }
+        }
+        std::cout << "  matched " << matched / kIterations << " rows" << std::endl;
+    }
+}
+
+} // namespace
+
+int main() {
+    std::vector<ProductRow> rows = generateProducts();
+    
+    std::unique_ptr<ProductSnapshot> snapshot;
+    {
+        BENCHMARK("Build snapshot (1M rows)");
+        snapshot = std::make_unique<ProductSnapshot>(rows);
+    }
+    
+    ProductFilter priceRange;
+    priceRange.min_price = 100000;
+    priceRange.max_price = 200000;
+    runFilter(*snapshot, "price range (10%)", priceRange);
+    
+    ProductFilter category;
+    category.category = "가구";
+    runFilter(*snapshot, "category (12.5%)", category);
+    
+    ProductFilter combined;
+    combined.category = "도서";
+    combined.min_price = 500000;
+    combined.max_price = 510000;
+    runFilter(*snapshot, "category + narrow price", combined);
+    
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../src/utils/benchmark.h"
+#include "../../src/utils/rate_limiter.h"
+
+// 요청마다 하는 속도 제한 확인(클라이언트 키 해시 + 버킷 갱신)의 비용을 스레드 수별로 잰다.
+// 클라이언트 수가 버킷 표보다 많은 경우(교체 발생)도 함께 본다.
+namespace {
+
+constexpr int kChecksPerThread = 2000000;
+
+void run(int threads, size_t clients, size_t capacity) {
+    RateLimiter::Settings settings;
+    settings.rate_per_second = 1e9;     // 거절 없이 비용만 측정
+    settings.burst = 1e9;
+    settings.capacity = capacity;
+    RateLimiter limiter(settings);
+
+    std::vector<std::string> addresses;
+    for (size_t i = 0; i < clients; ++i) {
+        addresses.push_back("10." + std::to_string(i / 65536 % 256) + "." +
+                            std::to_string(i / 256 % 256) + "." + std::to_string(i % 256));
+    }
+
+    std::atomic<uint64_t> allowed{0};
+    auto started = std::chrono::steady_clock::now();
+    {
+        BENCHMARK(std::to_string(threads) + " threads, " + std::to_string(clients) + " clients");
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                uint64_t local = 0;
+                size_t next = static_cast<size_t>(t);
+                int64_t now_us = 0;
+                for (int i = 0; i < kChecksPerThread; ++i) {
+                    const std::string& address = addresses[next % clients];
+                    next += 7919;
+                    // 시계 읽기는 요청당 한 번이고 플랫폼마다 비용이 달라 (vDSO 여부) 측정에서 뺀다
+                    if ((i & 255) == 0) {
+                        now_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count();
+                    }
+                    local += limiter.acquire(RateLimiter::hash(address), now_us).allowed;
+                }
+                allowed += local;
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    double elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "  " << elapsed_ns / (static_cast<double>(kChecksPerThread) * threads) << " ns/check (wall time / all checks)"
+              << ", allowed " << allowed.load() << ", tracked " << limiter.trackedKeys()
+              << ", evictions " << limiter.evictions() << std::endl;
+}
+
+} // namespace
+
+int main() {
+    run(1, 1000, 65536);
+    run(4, 1000, 65536);
+    run(8, 1000, 65536);
+    run(8, 200000, 65536);
+    return 0;
+}
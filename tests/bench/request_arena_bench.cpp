@@ -0,0 +1,98 @@
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include "../../src/utils/benchmark.h"
+#include "../../src/utils/request_context.h"
+#include "../../src/repository/entity_sql.h"
+#include "../../src/repository/mysql_member_repository.h"
+
+// 요청 하나의 리포지토리 임시 문자열(INSERT, SELECT+UPDATE 파이프라인 패킷)을 만들 때
+// 힙 할당 횟수를 요청 아레나 없이/있이 비교한다.
+namespace {
+
+std::atomic<uint64_t> heap_allocations{0};
+
+constexpr int kRequests = 100000;
+
+size_t simulateRequest(MYSQL* conn, const MemberRow& member) {
+    size_t total = 0;
+    {
+        entity_sql::Statement insert = entity_sql::insertStatement<MemberEntity>(conn, member);
+        total += insert.size();
+    }
+    {
+        entity_sql::Statement packet(request_context::arena());
+        packet += entity_sql::selectById<MemberEntity>(conn, member.id);
+        packet += "; ";
+        packet += entity_sql::updateStatement<MemberEntity>(conn, member);
+        total += packet.size();
+    }
+    return total;
+}
+
+void run(const std::string& label, bool with_arena) {
+    MYSQL* conn = mysql_init(nullptr);
+    MemberRow member{"member-0001", "홍길동", "male"};
+    RequestContext context;
+    size_t bytes = 0;
+
+    uint64_t before = heap_allocations.load();
+    {
+        BENCHMARK(label + " x" + std::to_string(kRequests));
+        for (int i = 0; i < kRequests; ++i) {
+            context.reset();
+            request_context::Binding binding(with_arena ? &context : nullptr);
+            bytes += simulateRequest(conn, member);
+            context.releaseArena();
+        }
+    }
+    uint64_t allocations = heap_allocations.load() - before;
+    std::cout << "  heap allocations per request: "
+              << static_cast<double>(allocations) / kRequests
+              << " (" << bytes / kRequests << " bytes of SQL)" << std::endl;
+    mysql_close(conn);
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// pmr 기본 자원은 정렬 지정 operator new 를 사용한다
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t /*size*/) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+    std::free(p);
+}
+
+int main() {
+    run("without request arena", false);
+    run("with request arena", true);
+    return 0;
+}
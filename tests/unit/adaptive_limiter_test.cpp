@@ -0,0 +1,96 @@
+#include "test_helper.h"
+#include "../../src/utils/adaptive_limiter.h"
+
+// AdaptiveLimiter 테스트
+class AdaptiveLimiterTest {
+private:
+    TestHelper test_helper;
+    
+    static AdaptiveLimiter::Settings makeSettings(int initial, int min, int max) {
+        AdaptiveLimiter::Settings settings;
+        settings.initial_limit = initial;
+        settings.min_limit = min;
+        settings.max_limit = max;
+        return settings;
+    }
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Adaptive Limiter Tests ===" << std::endl;
+        
+        test_helper.runTest("Rejects Above Limit", [this]() {
+            return testRejectsAboveLimit();
+        });
+        
+        test_helper.runTest("Shrinks On Latency Spike", [this]() {
+            return testShrinksOnLatencySpike();
+        });
+        
+        test_helper.runTest("Shrinks On Overload Signal", [this]() {
+            return testShrinksOnOverload();
+        });
+        
+        test_helper.runTest("Respects Min Limit", [this]() {
+            return testRespectsMinLimit();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testRejectsAboveLimit() {
+        AdaptiveLimiter limiter(makeSettings(3, 1, 10));
+        bool first = limiter.tryAcquire() && limiter.tryAcquire() && limiter.tryAcquire();
+        bool rejected = !limiter.tryAcquire();
+        limiter.release(1000, false);
+        bool reacquired = limiter.tryAcquire();
+        return first && rejected && reacquired && limiter.inFlight() == 3;
+    }
+    
+    // 한도를 꽉 채운 상태로 요청 하나를 처리하고 반환
+    static void saturatedRound(AdaptiveLimiter& limiter, int64_t rtt_us, bool overloaded) {
+        while (limiter.tryAcquire()) {}
+        limiter.release(rtt_us, overloaded);
+        while (limiter.inFlight() > 0) {
+            limiter.release(rtt_us, overloaded);
+        }
+    }
+    
+    bool testShrinksOnLatencySpike() {
+        AdaptiveLimiter limiter(makeSettings(50, 1, 100));
+        for (int i = 0; i < 200; ++i) {
+            saturatedRound(limiter, 1000, false);
+        }
+        int steady = limiter.currentLimit();
+        // 장기 평균이 새 지연을 따라잡기 전까지 한도가 줄어야 함
+        for (int i = 0; i < 3; ++i) {
+            saturatedRound(limiter, 20000, false);
+        }
+        return limiter.currentLimit() < steady;
+    }
+    
+    bool testShrinksOnOverload() {
+        AdaptiveLimiter limiter(makeSettings(50, 1, 100));
+        for (int i = 0; i < 50; ++i) {
+            saturatedRound(limiter, 1000, true);
+        }
+        return limiter.currentLimit() < 50;
+    }
+    
+    bool testRespectsMinLimit() {
+        AdaptiveLimiter limiter(makeSettings(10, 4, 20));
+        for (int i = 0; i < 500; ++i) {
+            saturatedRound(limiter, 100000, true);
+        }
+        return limiter.currentLimit() == 4;
+    }
+};
+
+int main() {
+    AdaptiveLimiterTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
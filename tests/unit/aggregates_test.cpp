@@ -0,0 +1,108 @@
+#include "test_helper.h"
+#include "../../src/utils/aggregates.h"
+
+// 증분 집계 테스트
+class AggregatesTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Aggregates Tests ===" << std::endl;
+        
+        test_helper.runTest("Tracks Price Stats Incrementally", [this]() {
+            return testIncrementalPriceStats();
+        });
+        
+        test_helper.runTest("Flags Removed Extremes", [this]() {
+            return testRemovedExtremes();
+        });
+        
+        test_helper.runTest("Group Replace Skipped After Concurrent Write", [this]() {
+            return testReplaceGroupVersionCheck();
+        });
+        
+        test_helper.runTest("Reset Skipped After Concurrent Write", [this]() {
+            return testResetVersionCheck();
+        });
+        
+        test_helper.runTest("Counts Groups", [this]() {
+            return testGroupedCounts();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testIncrementalPriceStats() {
+        GroupedPriceStats stats;
+        stats.add("전자제품", 1500000);
+        stats.add("전자제품", 50000);
+        stats.add("전자제품", 100000);
+        stats.add("가구", 200000);
+        
+        auto groups = stats.snapshot();
+        const PriceStats& electronics = groups["전자제품"];
+        return groups.size() == 2 && electronics.count == 3 && electronics.sum == 1650000 &&
+               electronics.min == 50000 && electronics.max == 1500000 && electronics.average() == 550000.0;
+    }
+    
+    bool testRemovedExtremes() {
+        GroupedPriceStats stats;
+        stats.add("a", 10);
+        stats.add("a", 20);
+        stats.add("a", 30);
+        
+        bool middle = stats.remove("a", 20);   // 최소/최대가 아니면 재계산 불필요
+        bool extreme = stats.remove("a", 30);  // 최대값이 빠지면 재계산 필요
+        auto dirty = stats.dirtyGroups();
+        bool marked = dirty.size() == 1 && stats.snapshot()["a"].stale;
+        bool replaced = stats.replaceGroup("a", PriceStats{1, 10, 10, 10}, dirty["a"]);
+        bool cleared = stats.dirtyGroups().empty() && !stats.snapshot()["a"].stale;
+        bool last = stats.remove("a", 10);     // 마지막 항목이면 그룹 제거
+        
+        return !middle && extreme && marked && replaced && cleared && !last && stats.snapshot().empty();
+    }
+    
+    bool testReplaceGroupVersionCheck() {
+        GroupedPriceStats stats;
+        stats.add("a", 10);
+        stats.add("a", 20);
+        stats.remove("a", 20);
+        uint64_t version = stats.dirtyGroups()["a"];
+        stats.add("a", 5);                     // 재계산 중 같은 그룹에 쓰기
+        
+        bool applied = stats.replaceGroup("a", PriceStats{1, 10, 10, 10}, version);
+        return !applied && stats.dirtyGroups().count("a") == 1 && stats.snapshot()["a"].count == 2;
+    }
+    
+    bool testResetVersionCheck() {
+        GroupedPriceStats stats;
+        uint64_t version = stats.currentVersion();
+        stats.add("a", 10);
+        
+        std::map<std::string, PriceStats> seeded{{"b", PriceStats{1, 5, 5, 5}}};
+        bool stale = stats.reset(seeded, version);
+        bool fresh = stats.reset(seeded, stats.currentVersion());
+        return !stale && fresh && stats.snapshot().count("b") == 1;
+    }
+    
+    bool testGroupedCounts() {
+        GroupedCounts counts;
+        counts.add("male");
+        counts.add("female");
+        counts.add("female");
+        counts.remove("male");
+        auto snapshot = counts.snapshot();
+        return snapshot.size() == 1 && snapshot["female"] == 2;
+    }
+};
+
+int main() {
+    AggregatesTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
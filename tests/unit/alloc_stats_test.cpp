@@ -0,0 +1,94 @@
+#include "test_helper.h"
+#include "../../src/utils/alloc_stats.h"
+#include "../../src/utils/request_context.h"
+#include <string>
+#include <thread>
+
+// 할당 집계 테스트 (operator new 계측 없이 확인 가능한 부분)
+class AllocStatsTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Alloc Stats Tests ===" << std::endl;
+        
+        test_helper.runTest("Route Key Replaces Variable Segments", [this]() {
+            return testRouteKey();
+        });
+        
+        test_helper.runTest("Records Per-Route Histogram", [this]() {
+            return testRecordsHistogram();
+        });
+        
+        test_helper.runTest("Attributes Thread Counters On Bind", [this]() {
+            return testAttributesOnBind();
+        });
+        
+        test_helper.runTest("Reads Registered Gauges", [this]() {
+            return testGauges();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testRouteKey() {
+        return alloc_stats::routeKey("GET", "/members/abc-1") == "GET /members/{id}" &&
+               alloc_stats::routeKey("GET", "/members") == "GET /members" &&
+               alloc_stats::routeKey("GET", "/products/search") == "GET /products/search" &&
+               alloc_stats::routeKey("DELETE", "/debug/allocations") == "DELETE /debug/allocations" &&
+               alloc_stats::routeKey("GET", "/") == "GET /";
+    }
+    
+    bool testRecordsHistogram() {
+        alloc_stats::reset();
+        alloc_stats::recordRequest("POST /members", 10, 1000);
+        alloc_stats::recordRequest("POST /members", 30, 3000);
+        alloc_stats::recordRequest("GET /members", 1, 50);
+        auto routes = alloc_stats::routes();
+        bool ok = routes.size() == 2 && routes[0].route == "POST /members" &&
+                  routes[0].requests == 2 && routes[0].averageAllocations() == 20 &&
+                  routes[0].averageBytes() == 2000 && routes[0].max_allocations == 30 &&
+                  routes[0].buckets[4] == 1 && routes[0].buckets[5] == 1 &&
+                  routes[0].percentileAllocations(0.99) == 30;
+        alloc_stats::reset();
+        return ok && alloc_stats::routes().empty();
+    }
+    
+    bool testAttributesOnBind() {
+        // 계측 빌드의 operator new 대신 스레드 카운터를 직접 증가
+        RequestContext ctx;
+        request_context::bind(&ctx);
+        request_context::threadAllocations().count += 3;
+        request_context::threadAllocations().bytes += 300;
+        std::thread([&ctx] {
+            request_context::Binding binding(&ctx);
+            request_context::threadAllocations().count += 2;
+            request_context::threadAllocations().bytes += 20;
+        }).join();
+        request_context::bind(nullptr);
+        request_context::threadAllocations().count += 100;      // 바인딩 해제 후에는 귀속되지 않음
+        request_context::flushAllocations();
+        return ctx.allocations.count == 5 && ctx.allocations.bytes == 320;
+    }
+    
+    bool testGauges() {
+        alloc_stats::registerGauge("test.value", [] { return int64_t(42); });
+        for (const auto& gauge : alloc_stats::gauges()) {
+            if (gauge.first == "test.value") {
+                return gauge.second == 42;
+            }
+        }
+        return false;
+    }
+};
+
+int main() {
+    AllocStatsTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+#include "test_helper.h"
+#include "../../src/utils/batch_loader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// BatchLoader (동시 단건 조회 묶음) 테스트
+class BatchLoaderTest {
+private:
+    TestHelper test_helper;
+    
+    using Loader = BatchLoader<std::string, int>;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Batch Loader Tests ===" << std::endl;
+        
+        test_helper.runTest("Coalesces Concurrent Loads", [this]() {
+            return testCoalesces();
+        });
+        
+        test_helper.runTest("Deduplicates Keys In Batch", [this]() {
+            return testDeduplicates();
+        });
+        
+        test_helper.runTest("Splits At Max Batch", [this]() {
+            return testMaxBatch();
+        });
+        
+        test_helper.runTest("Propagates Fetch Errors", [this]() {
+            return testPropagatesErrors();
+        });
+        
+        test_helper.runTest("Fetches Singly When Disabled", [this]() {
+            return testDisabled();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static Loader::Settings settings(bool enabled, int window_us, size_t max_batch) {
+        Loader::Settings s;
+        s.enabled = enabled;
+        s.window_us = window_us;
+        s.max_batch = max_batch;
+        return s;
+    }
+    
+    // "k<n>" 키는 n 을, "missing" 은 없음으로 응답
+    static std::unordered_map<std::string, int> lookup(const std::vector<std::string>& keys) {
+        std::unordered_map<std::string, int> rows;
+        for (const auto& key : keys) {
+            if (key != "missing") {
+                rows.emplace(key, std::stoi(key.substr(1)));
+            }
+        }
+        return rows;
+    }
+    
+    bool testCoalesces() {
+        std::atomic<int> fetches{0};
+        Loader loader([&](const std::vector<std::string>& keys) {
+            fetches++;
+            return lookup(keys);
+        });
+        // 창을 넉넉히 잡아 모든 스레드가 같은 배치에 들어가게 한다
+        loader.configure(settings(true, 200000, 8));
+        
+        std::atomic<int> correct{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&, i] {
+                auto value = loader.load("k" + std::to_string(i));
+                if (value && *value == i) {
+                    correct++;
+                }
+            });
+        }
+        auto missing = loader.load("missing");
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return correct == 8 && !missing && loader.loadCount() == 9 &&
+               fetches.load() == static_cast<int>(loader.batchCount()) && fetches.load() <= 2;
+    }
+    
+    bool testDeduplicates() {
+        std::mutex mutex;
+        std::vector<size_t> sizes;
+        Loader loader([&](const std::vector<std::string>& keys) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sizes.push_back(keys.size());
+            return lookup(keys);
+        });
+        loader.configure(settings(true, 100000, 64));
+        
+        std::atomic<int> correct{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&] {
+                auto value = loader.load("k5");
+                if (value && *value == 5) {
+                    correct++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t size : sizes) {
+            if (size != 1) {
+                return false;
+            }
+        }
+        return correct == 4;
+    }
+    
+    bool testMaxBatch() {
+        std::mutex mutex;
+        size_t largest = 0;
+        Loader loader([&](const std::vector<std::string>& keys) {
+            std::lock_guard<std::mutex> lock(mutex);
+            largest = std::max(largest, keys.size());
+            return lookup(keys);
+        });
+        loader.configure(settings(true, 50000, 3));
+        
+        std::atomic<int> correct{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 9; ++i) {
+            threads.emplace_back([&, i] {
+                if (loader.load("k" + std::to_string(i)) == i) {
+                    correct++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return correct == 9 && largest <= 3 && loader.batchCount() >= 3;
+    }
+    
+    bool testPropagatesErrors() {
+        Loader loader([](const std::vector<std::string>&) -> std::unordered_map<std::string, int> {
+            throw std::runtime_error("db down");
+        });
+        loader.configure(settings(true, 50000, 4));
+        
+        std::atomic<int> errors{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([&, i] {
+                try {
+                    loader.load("k" + std::to_string(i));
+                } catch (const std::runtime_error&) {
+                    errors++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        return errors == 4;
+    }
+    
+    bool testDisabled() {
+        std::vector<size_t> sizes;
+        Loader loader([&](const std::vector<std::string>& keys) {
+            sizes.push_back(keys.size());
+            return lookup(keys);
+        });
+        loader.configure(settings(false, 200000, 64));
+        auto started = std::chrono::steady_clock::now();
+        bool ok = loader.load("k1") == 1 && loader.load("k2") == 2 && !loader.load("missing");
+        // 꺼져 있으면 창을 기다리지 않는다
+        return ok && sizes == std::vector<size_t>{1, 1, 1} &&
+               std::chrono::steady_clock::now() - started < std::chrono::milliseconds(100);
+    }
+};
+
+int main() {
+    BatchLoaderTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+#include "test_helper.h"
+#include "../../src/utils/binary_encoding.h"
+
+using namespace binary_encoding;
+
+// 바이너리 응답 인코딩 테스트
+class BinaryEncodingTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Binary Encoding Tests ===" << std::endl;
+        
+        test_helper.runTest("Negotiates Accept Header", [this]() {
+            return testNegotiate();
+        });
+        
+        test_helper.runTest("Encodes MessagePack", [this]() {
+            return testMsgPack();
+        });
+        
+        test_helper.runTest("Encodes MessagePack Integer Widths", [this]() {
+            return testMsgPackIntegers();
+        });
+        
+        test_helper.runTest("Encodes CBOR", [this]() {
+            return testCbor();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static std::string bytes(std::initializer_list<unsigned char> values) {
+        return std::string(values.begin(), values.end());
+    }
+    
+    bool testNegotiate() {
+        return negotiate("") == Encoding::Json &&
+               negotiate("*/*") == Encoding::Json &&
+               negotiate("application/msgpack") == Encoding::MsgPack &&
+               negotiate("application/cbor, application/json;q=0.5") == Encoding::Cbor &&
+               negotiate("application/json;q=0.5, application/cbor") == Encoding::Cbor &&
+               negotiate("application/msgpack;q=0, */*") == Encoding::Json &&
+               negotiate("text/html") == Encoding::Json;
+    }
+    
+    bool testMsgPack() {
+        std::string out;
+        MsgPackWriter writer(out);
+        writer.beginArray(1);
+        writer.beginMap(2);
+        writer.string("id");
+        writer.string("a");
+        writer.string("n");
+        writer.integer(-1);
+        return out == bytes({0x91, 0x82, 0xA2, 'i', 'd', 0xA1, 'a', 0xA1, 'n', 0xFF});
+    }
+    
+    bool testMsgPackIntegers() {
+        std::string out;
+        MsgPackWriter writer(out);
+        writer.integer(127);
+        writer.integer(200);
+        writer.integer(70000);
+        writer.integer(-33);
+        writer.integer(-40000);
+        return out == bytes({0x7F, 0xCC, 0xC8, 0xCE, 0x00, 0x01, 0x11, 0x70,
+                             0xD0, 0xDF, 0xD2, 0xFF, 0xFF, 0x63, 0xC0});
+    }
+    
+    bool testCbor() {
+        std::string out;
+        CborWriter writer(out);
+        writer.beginArray(2);
+        writer.integer(1000);
+        writer.integer(-500);
+        writer.beginMap(1);
+        writer.string("a");
+        writer.nil();
+        return out == bytes({0x82, 0x19, 0x03, 0xE8, 0x39, 0x01, 0xF3, 0xA1, 0x61, 'a', 0xF6});
+    }
+};
+
+int main() {
+    BinaryEncodingTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
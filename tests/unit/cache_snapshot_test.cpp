@@ -0,0 +1,154 @@
+#include "test_helper.h"
+#include "../../src/utils/cache_snapshot.h"
+#include "../../src/utils/entity_snapshot.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+struct SnapshotTestRow {
+    std::string id;
+    std::string name;
+    int32_t price = 0;
+};
+
+struct SnapshotTestEntity {
+    using Row = SnapshotTestRow;
+    static constexpr std::string_view table = "items";
+    static constexpr auto fields = std::make_tuple(
+        entity::keyField("id", "id", 50, &SnapshotTestRow::id),
+        entity::stringField("name", "name", 100, &SnapshotTestRow::name),
+        entity::intField("price", "price", 0, 1000000, &SnapshotTestRow::price));
+};
+
+// CacheSnapshot (캐시 스냅샷 파일) 테스트
+class CacheSnapshotTest {
+private:
+    TestHelper test_helper;
+    std::string path = "/tmp/cache_snapshot_test_" + std::to_string(getpid()) + ".snapshot";
+    
+public:
+    ~CacheSnapshotTest() {
+        std::remove(path.c_str());
+    }
+    
+    void runAllTests() {
+        std::cout << "=== Cache Snapshot Tests ===" << std::endl;
+        
+        test_helper.runTest("Round Trips Rows And Watermark", [this]() {
+            return testRoundTrip();
+        });
+        
+        test_helper.runTest("Reports Missing File", [this]() {
+            return testMissing();
+        });
+        
+        test_helper.runTest("Rejects Corrupted Payload", [this]() {
+            return testCorrupted();
+        });
+        
+        test_helper.runTest("Rejects Schema Mismatch", [this]() {
+            return testSchemaMismatch();
+        });
+        
+        test_helper.runTest("Encodes Entity Rows", [this]() {
+            return testEntityRows();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool saveSample(uint64_t schema) {
+        CacheSnapshot::Writer writer(2);
+        writer.add("a");
+        writer.add("");
+        writer.add("b");
+        writer.add(std::string("x\0y", 3));
+        CacheSnapshot::Watermark watermark;
+        watermark.rows = 2;
+        watermark.max_updated = 1700000000;
+        return writer.rowCount() == 2 && writer.save(path, schema, watermark);
+    }
+    
+    bool testRoundTrip() {
+        if (!saveSample(7)) {
+            return false;
+        }
+        CacheSnapshot snapshot;
+        if (snapshot.open(path, 7, 2) != CacheSnapshot::Status::Ok) {
+            return false;
+        }
+        std::vector<std::string> fields;
+        snapshot.forEachRow([&](const std::string_view* row) {
+            fields.emplace_back(row[0]);
+            fields.emplace_back(row[1]);
+        });
+        return snapshot.rowCount() == 2 && snapshot.watermark().rows == 2 &&
+               snapshot.watermark().max_updated == 1700000000 && snapshot.savedAt() > 0 &&
+               fields == std::vector<std::string>{"a", "", "b", std::string("x\0y", 3)};
+    }
+    
+    bool testMissing() {
+        CacheSnapshot snapshot;
+        return snapshot.open(path + ".none", 7, 2) == CacheSnapshot::Status::Missing;
+    }
+    
+    bool testCorrupted() {
+        if (!saveSample(7)) {
+            return false;
+        }
+        // 마지막 바이트(페이로드) 변경
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('z');
+        file.close();
+        CacheSnapshot snapshot;
+        return snapshot.open(path, 7, 2) == CacheSnapshot::Status::Invalid && snapshot.rowCount() == 0;
+    }
+    
+    bool testSchemaMismatch() {
+        if (!saveSample(7)) {
+            return false;
+        }
+        CacheSnapshot snapshot;
+        return snapshot.open(path, 8, 2) == CacheSnapshot::Status::Invalid &&
+               snapshot.open(path, 7, 3) == CacheSnapshot::Status::Invalid;
+    }
+    
+    bool testEntityRows() {
+        CacheSnapshot::Writer writer(static_cast<uint32_t>(entity::fieldCount<SnapshotTestEntity>()));
+        entity_snapshot::appendRow<SnapshotTestEntity>(writer, SnapshotTestRow{"p1", "사과", 1200});
+        entity_snapshot::appendRow<SnapshotTestEntity>(writer, SnapshotTestRow{"p2", "배", -5});
+        uint64_t schema = entity_snapshot::schema<SnapshotTestEntity>();
+        if (!writer.save(path, schema, CacheSnapshot::Watermark{})) {
+            return false;
+        }
+        CacheSnapshot snapshot;
+        if (snapshot.open(path, schema, 3) != CacheSnapshot::Status::Ok) {
+            return false;
+        }
+        std::vector<SnapshotTestRow> rows;
+        bool decoded = true;
+        snapshot.forEachRow([&](const std::string_view* fields) {
+            SnapshotTestRow row;
+            decoded = decoded && entity_snapshot::decodeRow<SnapshotTestEntity>(fields, row);
+            rows.push_back(row);
+        });
+        std::string_view bad[] = {"p3", "x", "12a"};
+        SnapshotTestRow row;
+        return decoded && rows.size() == 2 && rows[0].name == "사과" && rows[0].price == 1200 &&
+               rows[1].id == "p2" && rows[1].price == -5 &&
+               !entity_snapshot::decodeRow<SnapshotTestEntity>(bad, row);
+    }
+};
+
+int main() {
+    CacheSnapshotTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include "test_helper.h"
+#include "../../src/utils/change_feed.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// ChangeFeed (SSE 변경 이벤트 링 버퍼) 테스트
+class ChangeFeedTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Change Feed Tests ===" << std::endl;
+        
+        test_helper.runTest("Formats Multi-Line Data", [this]() {
+            return testFrame();
+        });
+        
+        test_helper.runTest("Reads Events After Cursor", [this]() {
+            return testReadAfterCursor();
+        });
+        
+        test_helper.runTest("Resets Consumers Behind Backlog", [this]() {
+            return testResetWhenBehind();
+        });
+        
+        test_helper.runTest("Completes Waiter On Publish", [this]() {
+            return testWaiterCompletes();
+        });
+        
+        test_helper.runTest("Times Out And Limits Subscribers", [this]() {
+            return testTimeoutAndLimit();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static ChangeFeed::Settings settings(size_t backlog, size_t max_batch = 256, int max_wait_ms = 1000) {
+        ChangeFeed::Settings s;
+        s.backlog = backlog;
+        s.max_batch = max_batch;
+        s.max_wait_ms = max_wait_ms;
+        s.linger_ms = 1;
+        s.retry_ms = 100;
+        s.max_subscribers = 2;
+        return s;
+    }
+    
+    bool testFrame() {
+        return ChangeFeed::frame(7, "updated", "{\"a\":1}\n{\"b\":2}") ==
+               "id: 7\nevent: updated\ndata: {\"a\":1}\ndata: {\"b\":2}\n\n";
+    }
+    
+    bool testReadAfterCursor() {
+        ChangeFeed feed;
+        feed.configure(settings(16, 2));
+        uint64_t start = feed.lastId();
+        uint64_t first = feed.publish("created", "{\"id\":\"1\"}");
+        feed.publish("updated", "{\"id\":\"1\"}");
+        feed.publish("deleted", "{\"id\":\"1\"}");
+        
+        // max_batch 2 개씩 나눠서 전달
+        ChangeFeed::Batch batch = feed.read(start);
+        ChangeFeed::Batch rest = feed.read(batch.last_id);
+        ChangeFeed::Batch idle = feed.read(rest.last_id);
+        return first == start + 1 && batch.status == ChangeFeed::Status::Events && batch.events == 2 &&
+               batch.body.find("retry: 100\n\n") == 0 && batch.body.find("event: created") != std::string::npos &&
+               batch.body.find("event: deleted") == std::string::npos &&
+               rest.events == 1 && rest.last_id == feed.lastId() &&
+               idle.status == ChangeFeed::Status::Timeout &&
+               idle.body.find("id: " + std::to_string(feed.lastId()) + "\n\n") != std::string::npos;
+    }
+    
+    bool testResetWhenBehind() {
+        ChangeFeed feed;
+        feed.configure(settings(4));
+        uint64_t start = feed.lastId();
+        for (int i = 0; i < 6; ++i) {
+            feed.publish("created", "{}");
+        }
+        ChangeFeed::Batch behind = feed.read(start);
+        ChangeFeed::Batch in_ring = feed.read(feed.lastId() - 4);
+        ChangeFeed::Batch unknown = feed.read(feed.lastId() + 100);    // 재시작 전 피드의 id
+        return behind.status == ChangeFeed::Status::Reset && behind.last_id == feed.lastId() &&
+               behind.body.find("event: reset") != std::string::npos &&
+               in_ring.status == ChangeFeed::Status::Events && in_ring.events == 4 &&
+               unknown.status == ChangeFeed::Status::Reset;
+    }
+    
+    bool testWaiterCompletes() {
+        ChangeFeed feed;
+        feed.configure(settings(16));
+        std::atomic<bool> done{false};
+        ChangeFeed::Batch received;
+        bool subscribed = feed.subscribe(feed.lastId(), [&](ChangeFeed::Batch&& batch) {
+            received = std::move(batch);
+            done = true;
+        });
+        bool waiting = subscribed && !done && feed.subscriberCount() == 1;
+        feed.publish("created", "{\"id\":\"p1\"}");
+        for (int i = 0; i < 1000 && !done; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return waiting && done && received.status == ChangeFeed::Status::Events && received.events == 1 &&
+               received.body.find("data: {\"id\":\"p1\"}") != std::string::npos && feed.subscriberCount() == 0;
+    }
+    
+    bool testTimeoutAndLimit() {
+        ChangeFeed feed;
+        feed.configure(settings(16, 256, 30));
+        std::atomic<int> timeouts{0};
+        auto callback = [&](ChangeFeed::Batch&& batch) {
+            if (batch.status == ChangeFeed::Status::Timeout) {
+                timeouts++;
+            }
+        };
+        bool first = feed.subscribe(feed.lastId(), callback);
+        bool second = feed.subscribe(feed.lastId(), callback);
+        bool third = feed.subscribe(feed.lastId(), callback);      // max_subscribers 2
+        for (int i = 0; i < 1000 && timeouts < 2; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return first && second && !third && timeouts == 2 && feed.subscriberCount() == 0;
+    }
+};
+
+int main() {
+    ChangeFeedTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include "test_helper.h"
+#include "../../src/utils/circuit_breaker.h"
+
+// CircuitBreaker 테스트
+class CircuitBreakerTest {
+private:
+    TestHelper test_helper;
+    
+    using Clock = CircuitBreaker::Clock;
+    
+    static CircuitBreaker::Settings makeSettings() {
+        CircuitBreaker::Settings settings;
+        settings.failure_ratio = 0.5;
+        settings.min_requests = 4;
+        settings.window = std::chrono::milliseconds(1000);
+        settings.open_duration = std::chrono::milliseconds(500);
+        return settings;
+    }
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Circuit Breaker Tests ===" << std::endl;
+        
+        test_helper.runTest("Stays Closed Below Min Requests", [this]() {
+            return testStaysClosedBelowMinRequests();
+        });
+        
+        test_helper.runTest("Opens On Failure Ratio", [this]() {
+            return testOpensOnFailureRatio();
+        });
+        
+        test_helper.runTest("Window Forgets Old Failures", [this]() {
+            return testWindowForgetsOldFailures();
+        });
+        
+        test_helper.runTest("Probe Closes Or Reopens", [this]() {
+            return testProbeClosesOrReopens();
+        });
+        
+        test_helper.runTest("Disabled Always Allows", [this]() {
+            return testDisabledAlwaysAllows();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testStaysClosedBelowMinRequests() {
+        CircuitBreaker breaker(makeSettings());
+        auto now = Clock::now();
+        bool tripped = breaker.recordFailure(now) || breaker.recordFailure(now) || breaker.recordFailure(now);
+        return !tripped && breaker.allow();
+    }
+    
+    bool testOpensOnFailureRatio() {
+        CircuitBreaker breaker(makeSettings());
+        auto now = Clock::now();
+        breaker.recordSuccess(now);
+        breaker.recordSuccess(now);
+        breaker.recordFailure(now);
+        bool tripped = breaker.recordFailure(now);
+        return tripped && !breaker.allow() && breaker.currentState() == CircuitBreaker::State::Open &&
+               breaker.tripCount() == 1;
+    }
+    
+    bool testWindowForgetsOldFailures() {
+        CircuitBreaker breaker(makeSettings());
+        auto start = Clock::now();
+        for (int i = 0; i < 3; ++i) {
+            breaker.recordFailure(start);
+        }
+        // 창이 지나면 이전 실패는 세지 않는다
+        auto later = start + std::chrono::milliseconds(1500);
+        breaker.recordSuccess(later);
+        breaker.recordSuccess(later);
+        breaker.recordSuccess(later);
+        bool tripped = breaker.recordFailure(later);
+        return !tripped && breaker.allow();
+    }
+    
+    bool testProbeClosesOrReopens() {
+        CircuitBreaker breaker(makeSettings());
+        auto now = Clock::now();
+        for (int i = 0; i < 4; ++i) {
+            breaker.recordFailure(now);
+        }
+        
+        // open_duration 전에는 probe 하지 않음
+        bool early = breaker.beginProbe(now + std::chrono::milliseconds(100));
+        
+        // probe 실패 시 다시 Open, 요청은 계속 거부
+        auto first = now + std::chrono::milliseconds(600);
+        bool started = breaker.beginProbe(first);
+        bool half_open = breaker.currentState() == CircuitBreaker::State::HalfOpen && !breaker.allow();
+        breaker.endProbe(false, first);
+        bool reopened = breaker.currentState() == CircuitBreaker::State::Open &&
+                        !breaker.beginProbe(first + std::chrono::milliseconds(100));
+        
+        // probe 성공 시 Closed
+        auto second = first + std::chrono::milliseconds(600);
+        bool restarted = breaker.beginProbe(second);
+        breaker.endProbe(true, second);
+        return !early && started && half_open && reopened && restarted && breaker.allow();
+    }
+    
+    bool testDisabledAlwaysAllows() {
+        auto settings = makeSettings();
+        settings.enabled = false;
+        CircuitBreaker breaker(settings);
+        auto now = Clock::now();
+        for (int i = 0; i < 10; ++i) {
+            breaker.recordFailure(now);
+        }
+        return breaker.allow() && breaker.tripCount() == 0;
+    }
+};
+
+int main() {
+    CircuitBreakerTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
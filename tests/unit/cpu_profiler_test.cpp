@@ -0,0 +1,107 @@
+#include "test_helper.h"
+#include "../../src/utils/cpu_profiler.h"
+#include <atomic>
+#include <cmath>
+#include <csignal>
+#include <string>
+#include <thread>
+
+// CpuProfiler / FoldedStacks 테스트
+class CpuProfilerTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== CPU Profiler Tests ===" << std::endl;
+        
+        test_helper.runTest("Folds Identical Stacks", [this]() {
+            return testFoldsIdenticalStacks();
+        });
+        
+        test_helper.runTest("Escapes Frame Separator", [this]() {
+            return testEscapesSeparator();
+        });
+        
+        test_helper.runTest("Disabled Profiler Does Not Sample", [this]() {
+            return testDisabled();
+        });
+        
+        test_helper.runTest("Samples Busy Threads", [this]() {
+            return testSamplesBusyThreads();
+        });
+        
+        test_helper.runTest("Ignores SIGPROF After Collection", [this]() {
+            return testLateSignal();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testFoldsIdenticalStacks() {
+        FoldedStacks folded;
+        folded.add({"main", "handle", "query"});
+        folded.add({"main", "handle", "serialize"});
+        folded.add({"main", "handle", "query"});
+        return folded.size() == 2 && folded.str() == "main;handle;query 2\nmain;handle;serialize 1\n";
+    }
+    
+    bool testEscapesSeparator() {
+        FoldedStacks folded;
+        folded.add({"main", "a;b"}, 3);
+        folded.add({});
+        return folded.str() == "main;a:b 3\n";
+    }
+    
+    bool testDisabled() {
+        CpuProfiler::Settings settings;
+        settings.enabled = false;
+        CpuProfiler::instance().configure(settings);
+        CpuProfiler::Profile profile;
+        bool disabled = CpuProfiler::instance().run(std::chrono::milliseconds(10), profile) == CpuProfiler::Status::Disabled;
+        CpuProfiler::instance().configure(CpuProfiler::Settings{});
+        return disabled && profile.samples == 0;
+    }
+    
+    bool testSamplesBusyThreads() {
+        CpuProfiler::Settings settings;
+        settings.enabled = true;
+        settings.frequency_hz = 500;
+        CpuProfiler::instance().configure(settings);
+        
+        std::atomic<bool> stop{false};
+        std::thread worker([&stop] {
+            volatile double sink = 0;
+            while (!stop) {
+                for (int i = 0; i < 10000; ++i) {
+                    sink = sink + std::sqrt(static_cast<double>(i));
+                }
+            }
+        });
+        
+        CpuProfiler::Profile profile;
+        CpuProfiler::Status status = CpuProfiler::instance().run(std::chrono::milliseconds(300), profile);
+        stop = true;
+        worker.join();
+        CpuProfiler::instance().configure(CpuProfiler::Settings{});
+        return status == CpuProfiler::Status::Ok && profile.samples > 0 && profile.frequency_hz == 500 &&
+               !profile.folded.empty();
+    }
+    
+    bool testLateSignal() {
+        // 수집이 끝난 뒤 늦게 도착한 SIGPROF 가 프로세스를 종료시키지 않아야 한다
+        std::raise(SIGPROF);
+        std::raise(SIGPROF);
+        return true;
+    }
+};
+
+int main() {
+    CpuProfilerTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
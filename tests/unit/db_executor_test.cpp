@@ -0,0 +1,94 @@
+#include "test_helper.h"
+#include "../../src/utils/db_executor.h"
+#include <atomic>
+#include <thread>
+
+// DbExecutor 테스트
+class DbExecutorTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== DB Executor Tests ===" << std::endl;
+        
+        test_helper.runTimedTest("Runs All Submitted Tasks", [this]() {
+            return testRunsAllTasks();
+        }, 5000);
+        
+        test_helper.runTest("Rejects When Queue Is Full", [this]() {
+            return testRejectsWhenFull();
+        });
+        
+        test_helper.runTest("Propagates Request Context", [this]() {
+            return testPropagatesRequestContext();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testRunsAllTasks() {
+        std::atomic<int> counter{0};
+        DbExecutor executor(4, 100000);
+        for (int i = 0; i < 10000; ++i) {
+            while (!executor.submit([&counter]() { counter++; })) {
+                std::this_thread::yield();
+            }
+        }
+        while (executor.stats().completed < 10000) {
+            std::this_thread::yield();
+        }
+        return counter == 10000 && executor.stats().queued == 0;
+    }
+    
+    bool testRejectsWhenFull() {
+        std::atomic<bool> release{false};
+        DbExecutor executor(1, 2);
+        
+        // 워커 하나를 점유한 뒤 대기열 2칸을 채운다
+        executor.submit([&release]() {
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        while (executor.stats().active == 0) {
+            std::this_thread::yield();
+        }
+        bool second = executor.submit([]() {});
+        bool third = executor.submit([]() {});
+        bool fourth = executor.submit([]() {});
+        release = true;
+        
+        return second && third && !fourth && executor.stats().rejected == 1;
+    }
+    
+    bool testPropagatesRequestContext() {
+        RequestContext request;
+        std::atomic<bool> done{false};
+        std::atomic<bool> matched{false};
+        DbExecutor executor(2, 16);
+        {
+            request_context::Binding binding(&request);
+            executor.submit([&]() {
+                StageTimer timer(Stage::Query);
+                matched = request_context::current() == &request;
+                timer.stop();
+                done = true;
+            });
+        }
+        while (!done) {
+            std::this_thread::yield();
+        }
+        return matched;
+    }
+};
+
+int main() {
+    DbExecutorTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
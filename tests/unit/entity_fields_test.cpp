@@ -0,0 +1,141 @@
+#include "test_helper.h"
+#include "../../src/utils/entity_fields.h"
+#include "../../src/utils/binary_encoding.h"
+#include <vector>
+
+namespace {
+
+struct ItemRow {
+    std::string id;
+    std::string name;
+    int32_t qty = 0;
+    std::string color;
+};
+
+struct ItemEntity {
+    using Row = ItemRow;
+    static constexpr std::string_view singular = "Item";
+    static constexpr std::string_view table = "items";
+    static constexpr std::string_view colors[] = {"red", "blue"};
+    static constexpr auto fields = std::make_tuple(
+        entity::keyField("id", "id", 8, &ItemRow::id),
+        entity::stringField("name", "item_name", 10, &ItemRow::name),
+        entity::intField("qty", "qty", 0, 100, &ItemRow::qty),
+        entity::enumField("color", "color", 10, &ItemRow::color, colors));
+};
+
+} // namespace
+
+// 엔티티 필드 기술자 테스트
+class EntityFieldsTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Entity Fields Tests ===" << std::endl;
+        
+        test_helper.runTest("Accepts Valid Row", [this]() {
+            return testValidRow();
+        });
+        
+        test_helper.runTest("Reports First Violation", [this]() {
+            return testViolations();
+        });
+        
+        test_helper.runTest("Pre-serialized Error Bodies", [this]() {
+            return testErrorBodies();
+        });
+        
+        test_helper.runTest("Writes JSON Array", [this]() {
+            return testJsonArray();
+        });
+        
+        test_helper.runTest("Encodes Rows As MessagePack", [this]() {
+            return testMsgPackRows();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static ItemRow validRow() {
+        return ItemRow{"a-1", "cup", 3, "red"};
+    }
+    
+    bool testValidRow() {
+        return static_cast<bool>(entity::checkRow<ItemEntity>(validRow())) &&
+               static_cast<bool>(entity::checkKey<ItemEntity>("abc_9"));
+    }
+    
+    bool testViolations() {
+        ItemRow badKey = validRow();
+        badKey.id = "a b";
+        ItemRow longName = validRow();
+        longName.name = "12345678901";
+        ItemRow badQty = validRow();
+        badQty.qty = 101;
+        ItemRow badColor = validRow();
+        badColor.color = "green";
+        
+        auto key = entity::checkRow<ItemEntity>(badKey);
+        auto name = entity::checkRow<ItemEntity>(longName);
+        auto qty = entity::checkRow<ItemEntity>(badQty);
+        auto color = entity::checkRow<ItemEntity>(badColor);
+        return key.violation == entity::Violation::InvalidKey && key.field == 0 &&
+               name.violation == entity::Violation::TooLong && name.field == 1 &&
+               qty.violation == entity::Violation::OutOfRange && qty.field == 2 &&
+               color.violation == entity::Violation::NotAllowed && color.field == 3 &&
+               entity::checkKey<ItemEntity>("").violation == entity::Violation::Empty;
+    }
+    
+    bool testErrorBodies() {
+        const std::string& missing = entity::errorBody<ItemEntity>({entity::Violation::Missing, 1});
+        const std::string& range = entity::errorBody<ItemEntity>({entity::Violation::OutOfRange, 2});
+        const std::string& color = entity::errorBody<ItemEntity>({entity::Violation::NotAllowed, 3});
+        // 같은 위반은 같은 본문 객체를 재사용
+        bool reused = &missing == &entity::errorBody<ItemEntity>({entity::Violation::Missing, 1});
+        return missing == "{\"error\":\"Missing required field: name\"}" &&
+               range == "{\"error\":\"Field qty must be between 0 and 100\"}" &&
+               color == "{\"error\":\"Field color must be one of: red, blue\"}" &&
+               reused;
+    }
+    
+    bool testJsonArray() {
+        std::vector<ItemRow> rows{validRow(), ItemRow{"b", "say \"hi\"", 0, "blue"}};
+        std::string out;
+        entity::appendJsonArray<ItemEntity>(out, rows);
+        return out == "[{\"id\":\"a-1\",\"name\":\"cup\",\"qty\":3,\"color\":\"red\"},"
+                      "{\"id\":\"b\",\"name\":\"say \\\"hi\\\"\",\"qty\":0,\"color\":\"blue\"}]";
+    }
+    
+    bool testMsgPackRows() {
+        std::vector<ItemRow> rows{validRow()};
+        std::string out;
+        binary_encoding::MsgPackWriter writer(out);
+        entity::encodeRows<ItemEntity>(writer, rows);
+        
+        std::string expected;
+        binary_encoding::MsgPackWriter manual(expected);
+        manual.beginArray(1);
+        manual.beginMap(4);
+        manual.string("id");
+        manual.string("a-1");
+        manual.string("name");
+        manual.string("cup");
+        manual.string("qty");
+        manual.integer(3);
+        manual.string("color");
+        manual.string("red");
+        return out == expected;
+    }
+};
+
+int main() {
+    EntityFieldsTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <thread>
+#include <vector>
 #include <chrono>
 #include <curl/curl.h>
 #include <string>
@@ -130,15 +133,38 @@ int main() {
     std::cout << "\n4. Testing response time" << std::endl;
     bool test4 = test.testResponseTime("/members", 500);
     
+    // 대소문자만 다른 ID 들을 동시에 조회해 한 묶음(WHERE id IN)으로 처리되게 한다.
+    // 단건 조회처럼 DB collation 으로 일치해야 하므로 모두 200 이어야 함
+    std::cout << "\n5. Testing batched GET /products/{id} with case variants" << std::endl;
+    std::string product_data = R"({"id":"BatchCase1","name":"묶음테스트","price":1000,"category":"테스트"})";
+    test.testPost("/products", product_data, 201);  // 이전 실행에서 남은 행이면 409
+    const std::vector<std::string> variants = {"BatchCase1", "batchcase1", "BATCHCASE1", "bATCHcASE1"};
+    std::vector<std::unique_ptr<IntegrationTest>> clients;
+    for (size_t i = 0; i < variants.size() * 4; ++i) {
+        clients.push_back(std::make_unique<IntegrationTest>("http://localhost:3000"));
+    }
+    std::vector<char> found(clients.size(), 0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < clients.size(); ++i) {
+        threads.emplace_back([&, i] {
+            found[i] = clients[i]->testGet("/products/" + variants[i % variants.size()]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    bool test5 = std::all_of(found.begin(), found.end(), [](char ok) { return ok != 0; });
+    
     // 결과 요약
     std::cout << "\n=== Test Results ===" << std::endl;
     std::cout << "GET /members: " << (test1 ? "PASS" : "FAIL") << std::endl;
     std::cout << "GET /products: " << (test2 ? "PASS" : "FAIL") << std::endl;
     std::cout << "POST /members: " << (test3 ? "PASS" : "FAIL") << std::endl;
     std::cout << "Response time: " << (test4 ? "PASS" : "FAIL") << std::endl;
+    std::cout << "Batched case variants: " << (test5 ? "PASS" : "FAIL") << std::endl;
     
-    int passed = (test1 ? 1 : 0) + (test2 ? 1 : 0) + (test3 ? 1 : 0) + (test4 ? 1 : 0);
-    std::cout << "\nTotal: " << passed << "/4 tests passed" << std::endl;
+    int passed = (test1 ? 1 : 0) + (test2 ? 1 : 0) + (test3 ? 1 : 0) + (test4 ? 1 : 0) + (test5 ? 1 : 0);
+    std::cout << "\nTotal: " << passed << "/5 tests passed" << std::endl;
     
-    return (passed == 4) ? 0 : 1;
+    return (passed == 5) ? 0 : 1;
 }
@@ -0,0 +1,96 @@
+#include "test_helper.h"
+#include "../../src/utils/last_known_good.h"
+#include <string>
+
+// LastKnownGood 테스트
+class LastKnownGoodTest {
+private:
+    TestHelper test_helper;
+    
+    using Store = LastKnownGood<std::string, int>;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Last Known Good Tests ===" << std::endl;
+        
+        test_helper.runTest("Returns Value With Age", [this]() {
+            return testReturnsValueWithAge();
+        });
+        
+        test_helper.runTest("Rejects Values Older Than Max Age", [this]() {
+            return testRejectsOldValues();
+        });
+        
+        test_helper.runTest("Evicts Oldest Key At Capacity", [this]() {
+            return testEvictsOldestKey();
+        });
+        
+        test_helper.runTest("Erase Removes Value", [this]() {
+            return testEraseRemovesValue();
+        });
+        
+        test_helper.runTest("Skips Refresh Within Interval", [this]() {
+            return testSkipsRefreshWithinInterval();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testReturnsValueWithAge() {
+        Store store(4);
+        auto now = Store::Clock::now();
+        store.store("a", 1, now);
+        auto hit = store.lookup("a", std::chrono::seconds(60), now + std::chrono::seconds(5));
+        return hit && hit->value == 1 && hit->age == std::chrono::seconds(5) && !store.lookup("b", std::chrono::seconds(60));
+    }
+    
+    bool testRejectsOldValues() {
+        Store store(4);
+        auto now = Store::Clock::now();
+        store.store("a", 1, now);
+        return !store.lookup("a", std::chrono::seconds(10), now + std::chrono::seconds(11));
+    }
+    
+    bool testEvictsOldestKey() {
+        Store store(2);
+        auto now = Store::Clock::now();
+        store.store("a", 1, now);
+        store.store("b", 2, now);
+        store.store("c", 3, now);
+        auto max_age = std::chrono::seconds(60);
+        return !store.lookup("a", max_age, now) && store.lookup("b", max_age, now) &&
+               store.lookup("c", max_age, now) && store.size() == 2;
+    }
+    
+    bool testEraseRemovesValue() {
+        Store store(2);
+        auto now = Store::Clock::now();
+        store.store("a", 1, now);
+        store.erase("a");
+        store.store("b", 2, now);
+        store.store("c", 3, now);
+        auto max_age = std::chrono::seconds(60);
+        return !store.lookup("a", max_age, now) && store.lookup("b", max_age, now) && store.size() == 2;
+    }
+    
+    bool testSkipsRefreshWithinInterval() {
+        Store store(1, std::chrono::seconds(1));
+        auto now = Store::Clock::now();
+        store.store("a", 1, now);
+        store.store("a", 2, now + std::chrono::milliseconds(500));
+        auto skipped = store.lookup("a", std::chrono::seconds(60), now + std::chrono::milliseconds(500));
+        store.store("a", 3, now + std::chrono::milliseconds(1500));
+        auto refreshed = store.lookup("a", std::chrono::seconds(60), now + std::chrono::milliseconds(1500));
+        return skipped && skipped->value == 1 && refreshed && refreshed->value == 3;
+    }
+};
+
+int main() {
+    LastKnownGoodTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
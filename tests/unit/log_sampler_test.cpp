@@ -0,0 +1,106 @@
+#include "test_helper.h"
+#include "../../src/utils/log_sampler.h"
+#include <string>
+
+// LogSampler (access log 표본 추출) 테스트
+class LogSamplerTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Log Sampler Tests ===" << std::endl;
+        
+        test_helper.runTest("Logs Everything When Disabled", [this]() {
+            return testDisabled();
+        });
+        
+        test_helper.runTest("Always Logs Server Errors And Slow Requests", [this]() {
+            return testAlwaysLogged();
+        });
+        
+        test_helper.runTest("Uses Per-Route Slow Thresholds", [this]() {
+            return testRouteThresholds();
+        });
+        
+        test_helper.runTest("Limits Client Errors Per Second", [this]() {
+            return testClientErrorLimit();
+        });
+        
+        test_helper.runTest("Samples Fast Successes With Rate", [this]() {
+            return testSampling();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static LogSampler::Settings settings(uint32_t one_in) {
+        LogSampler::Settings s;
+        s.enabled = true;
+        s.sample_one_in = one_in;
+        s.client_errors_per_second = 2;
+        s.slow_us = 100000;
+        return s;
+    }
+    
+    bool testDisabled() {
+        LogSampler sampler;
+        auto decision = sampler.decide("", 200, 10, 0);
+        return decision.log && decision.sample == 1 && decision.reason == LogSampler::Reason::All;
+    }
+    
+    bool testAlwaysLogged() {
+        LogSampler sampler;
+        sampler.configure(settings(1000000));
+        auto error = sampler.decide("", 503, 10, 0);
+        auto slow = sampler.decide("", 200, 150000, 0);
+        return error.log && error.sample == 1 && error.reason == LogSampler::Reason::Error &&
+               slow.log && slow.sample == 1 && slow.reason == LogSampler::Reason::Slow;
+    }
+    
+    bool testRouteThresholds() {
+        LogSampler::Settings s = settings(1000000);
+        s.route_slow_us["GET /members/{id}"] = 5000;
+        LogSampler sampler;
+        sampler.configure(s);
+        return sampler.hasRouteThresholds() &&
+               sampler.decide("GET /members/{id}", 200, 6000, 0).reason == LogSampler::Reason::Slow &&
+               sampler.decide("GET /members", 200, 6000, 0).reason == LogSampler::Reason::Sampled;
+    }
+    
+    bool testClientErrorLimit() {
+        LogSampler sampler;
+        sampler.configure(settings(1000000));
+        bool first = sampler.decide("", 404, 10, 7).reason == LogSampler::Reason::ClientError;
+        bool second = sampler.decide("", 429, 10, 7).reason == LogSampler::Reason::ClientError;
+        auto third = sampler.decide("", 404, 10, 7);
+        // 다음 초에는 다시 기록
+        bool next = sampler.decide("", 404, 10, 8).reason == LogSampler::Reason::ClientError;
+        return first && second && third.reason == LogSampler::Reason::Sampled && third.sample == 1000000 && next;
+    }
+    
+    bool testSampling() {
+        LogSampler sampler;
+        sampler.configure(settings(10));
+        int logged = 0;
+        for (int i = 0; i < 10000; ++i) {
+            auto decision = sampler.decide("", 200, 10, 0);
+            if (decision.sample != 10 || decision.reason != LogSampler::Reason::Sampled) {
+                return false;
+            }
+            logged += decision.log ? 1 : 0;
+        }
+        // 기대값 1000, 표준편차 약 30
+        return logged > 850 && logged < 1150;
+    }
+};
+
+int main() {
+    LogSamplerTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
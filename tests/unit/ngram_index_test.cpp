@@ -0,0 +1,146 @@
+#include "test_helper.h"
+#include "../../src/utils/ngram_index.h"
+#include <chrono>
+
+// NgramIndex 테스트
+class NgramIndexTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== NgramIndex Tests ===" << std::endl;
+        
+        test_helper.runTest("Finds Syllable Substrings", [this]() {
+            return testFindsSubstrings();
+        });
+        
+        test_helper.runTest("Matches Partially Typed Syllables", [this]() {
+            return testPartialSyllables();
+        });
+        
+        test_helper.runTest("Searches By Initial Consonants", [this]() {
+            return testInitials();
+        });
+        
+        test_helper.runTest("Tracks Updates And Removals", [this]() {
+            return testUpdatesAndRemovals();
+        });
+        
+        test_helper.runTest("Compacts Tombstoned Documents", [this]() {
+            return testCompaction();
+        });
+        
+        test_helper.runTest("Ignores Case For Latin Text", [this]() {
+            return testCaseFolding();
+        });
+        
+        test_helper.runTimedTest("Searches 100k Names Quickly", [this]() {
+            return testLargeIndex();
+        }, 5000);
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    void fillSample(NgramIndex& index) {
+        index.rebuild({
+            {"m1", "정지범"},
+            {"m2", "김철수"},
+            {"m3", "정수진"},
+            {"p1", "노트북"},
+            {"p2", "게이밍 노트북"},
+        });
+    }
+    
+    bool testFindsSubstrings() {
+        NgramIndex index;
+        fillSample(index);
+        auto notebooks = index.search("노트북", 10);
+        auto jung = index.search("정", 10);
+        // 앞에서 일치하는 항목이 먼저 온다
+        return notebooks == std::vector<std::string>{"p1", "p2"} &&
+               jung == std::vector<std::string>{"m1", "m3"} &&
+               index.search("없는이름", 10).empty();
+    }
+    
+    bool testPartialSyllables() {
+        NgramIndex index;
+        fillSample(index);
+        // "노트ㅂ", "노틉"(입력 중 종성으로 붙은 상태) 모두 "노트북" 과 일치해야 함
+        return index.search("노트ㅂ", 10) == std::vector<std::string>{"p1", "p2"} &&
+               index.search("노틉", 10) == std::vector<std::string>{"p1", "p2"};
+    }
+    
+    bool testInitials() {
+        NgramIndex index;
+        fillSample(index);
+        return index.search("ㅈㅈㅂ", 10) == std::vector<std::string>{"m1"} &&
+               index.search("ㄴㅌㅂ", 10) == std::vector<std::string>{"p1", "p2"};
+    }
+    
+    bool testUpdatesAndRemovals() {
+        NgramIndex index;
+        fillSample(index);
+        index.upsert("m2", "김영희");
+        index.remove("m3");
+        index.upsert("m4", "정지훈");
+        return index.search("철수", 10).empty() &&
+               index.search("영희", 10) == std::vector<std::string>{"m2"} &&
+               index.search("정지", 10) == std::vector<std::string>{"m1", "m4"} &&
+               index.size() == 5;
+    }
+    
+    bool testCompaction() {
+        // 같은 키를 계속 교체하면 죽은 문서가 쌓였다가 재구성되어야 함
+        NgramIndex index;
+        fillSample(index);
+        size_t initial_bytes = index.postingBytes();
+        for (int i = 0; i < 100; ++i) {
+            index.upsert("p1", i % 2 == 0 ? "노트북 케이스" : "노트북");
+        }
+        index.remove("p2");
+        return index.search("노트북", 10) == std::vector<std::string>{"p1"} &&
+               index.search("케이스", 10).empty() &&
+               index.size() == 4 && index.postingBytes() <= initial_bytes * 2;
+    }
+    
+    bool testCaseFolding() {
+        NgramIndex index;
+        index.upsert("p1", "MacBook Pro");
+        return index.search("macbook", 10) == std::vector<std::string>{"p1"} &&
+               index.search("BOOK PRO", 10) == std::vector<std::string>{"p1"};
+    }
+    
+    bool testLargeIndex() {
+        const char* family[] = {"김", "이", "박", "최", "정", "강", "조", "윤"};
+        const char* given[] = {"민준", "서연", "지훈", "하은", "도윤", "수진", "지범", "철수", "영희", "예준"};
+        
+        std::vector<std::pair<std::string, std::string>> entries;
+        for (int i = 0; i < 100000; ++i) {
+            std::string name = std::string(family[i % 8]) + given[(i / 8) % 10] + std::to_string(i);
+            entries.emplace_back("k" + std::to_string(i), name);
+        }
+        NgramIndex index;
+        index.rebuild(entries);
+        
+        auto start = std::chrono::steady_clock::now();
+        auto found = index.search("ㅈㅈㅂ", 10);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "(" << elapsed << "us, " << index.postingBytes() << " posting bytes) ";
+        
+        std::string expected = std::string(family[4242 % 8]) + given[(4242 / 8) % 10] + "4242";
+        auto exact = index.search(expected, 10);
+        return found.size() == 10 && !exact.empty() && exact.front() == "k4242";
+    }
+};
+
+int main() {
+    NgramIndexTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
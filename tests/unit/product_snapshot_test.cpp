@@ -0,0 +1,142 @@
+#include "test_helper.h"
+#include "../../src/repository/product_snapshot.h"
+#include <random>
+
+// ProductSnapshot 테스트
+class ProductSnapshotTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== ProductSnapshot Tests ===" << std::endl;
+        
+        test_helper.runTest("Filters By Category And Price", [this]() {
+            return testFiltersByCategoryAndPrice();
+        });
+        
+        test_helper.runTest("Unknown Category Matches Nothing", [this]() {
+            return testUnknownCategory();
+        });
+        
+        test_helper.runTest("Stores Names In Arena", [this]() {
+            return testStoresNames();
+        });
+        
+        test_helper.runTest("Row Match Agrees With Filter", [this]() {
+            return testRowMatchAgreesWithFilter();
+        });
+        
+        test_helper.runTest("SIMD Kernels Match Scalar", [this]() {
+            return testKernelsMatchScalar();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    std::vector<ProductRow> sampleRows() {
+        return {
+            {"p1", "노트북", 1500000, "전자제품"},
+            {"p2", "마우스", 30000, "전자제품"},
+            {"p3", "책상", 200000, "가구"},
+            {"p4", "키보드", 80000, "전자제품"},
+            {"p5", "의자", 150000, "가구"},
+        };
+    }
+    
+    bool testFiltersByCategoryAndPrice() {
+        ProductSnapshot snapshot(sampleRows());
+        
+        ProductFilter electronics;
+        electronics.category = "전자제품";
+        electronics.max_price = 100000;
+        std::vector<uint32_t> rows = snapshot.filter(electronics);
+        
+        ProductFilter priceOnly;
+        priceOnly.min_price = 150000;
+        priceOnly.max_price = 200000;
+        std::vector<uint32_t> priced = snapshot.filter(priceOnly);
+        
+        return rows == std::vector<uint32_t>{1, 3} && priced == std::vector<uint32_t>{2, 4};
+    }
+    
+    bool testUnknownCategory() {
+        ProductSnapshot snapshot(sampleRows());
+        ProductFilter filter;
+        filter.category = "식품";
+        return snapshot.filter(filter).empty();
+    }
+    
+    bool testStoresNames() {
+        ProductSnapshot snapshot(sampleRows());
+        return snapshot.size() == 5 && snapshot.id(2) == "p3" && snapshot.name(2) == "책상" &&
+               snapshot.price(2) == 200000 && snapshot.category(2) == "가구";
+    }
+    
+    bool testRowMatchAgreesWithFilter() {
+        // overlay 행은 filter 대신 matches 로 거르므로 두 결과가 같아야 함
+        std::vector<ProductRow> rows = sampleRows();
+        ProductSnapshot snapshot(rows);
+        std::vector<ProductFilter> filters(4);
+        filters[0].category = "가구";
+        filters[1].min_price = 30000;
+        filters[1].max_price = 150000;
+        filters[2].category = "식품";
+        filters[3].min_price = 200000;
+        filters[3].max_price = 100000;
+        
+        for (const auto& filter : filters) {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < rows.size(); ++i) {
+                if (filter.matches(rows[i])) {
+                    expected.push_back(i);
+                }
+            }
+            if (snapshot.filter(filter) != expected) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    bool testKernelsMatchScalar() {
+        // 벡터 폭으로 나누어 떨어지지 않는 길이로 꼬리 처리까지 확인
+        std::mt19937 rng(42);
+        std::vector<ProductRow> rows;
+        const char* categories[] = {"a", "b", "c"};
+        for (int i = 0; i < 1003; ++i) {
+            rows.push_back({"id" + std::to_string(i), "name", static_cast<int32_t>(rng() % 1000), categories[rng() % 3]});
+        }
+        ProductSnapshot snapshot(rows);
+        
+        ProductFilter filters[3];
+        filters[0].min_price = 100;
+        filters[0].max_price = 400;
+        filters[1].category = "b";
+        filters[2].category = "c";
+        filters[2].min_price = 500;
+        
+        for (const auto& filter : filters) {
+            std::vector<uint32_t> expected = snapshot.filter(filter, ProductSnapshot::Kernel::Scalar);
+            if (expected.empty()) {
+                return false;
+            }
+            for (auto kernel : {ProductSnapshot::Kernel::SSE, ProductSnapshot::Kernel::AVX2}) {
+                if (snapshot.filter(filter, kernel) != expected) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+int main() {
+    ProductSnapshotTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
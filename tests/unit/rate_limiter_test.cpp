@@ -0,0 +1,113 @@
+#include "test_helper.h"
+#include "../../src/utils/rate_limiter.h"
+#include <string>
+
+// RateLimiter (token bucket) 테스트
+class RateLimiterTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Rate Limiter Tests ===" << std::endl;
+        
+        test_helper.runTest("Allows Burst Then Rejects", [this]() {
+            return testBurstThenReject();
+        });
+        
+        test_helper.runTest("Refills Over Time", [this]() {
+            return testRefill();
+        });
+        
+        test_helper.runTest("Keys Are Independent", [this]() {
+            return testIndependentKeys();
+        });
+        
+        test_helper.runTest("Evicts Least Recently Used In Set", [this]() {
+            return testEviction();
+        });
+        
+        test_helper.runTest("Applies New Rate", [this]() {
+            return testSetRate();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static RateLimiter::Settings settings(double rate, double burst, size_t capacity = 1024, size_t shards = 4) {
+        RateLimiter::Settings s;
+        s.rate_per_second = rate;
+        s.burst = burst;
+        s.capacity = capacity;
+        s.shards = shards;
+        return s;
+    }
+    
+    bool testBurstThenReject() {
+        RateLimiter limiter(settings(10.0, 3.0));
+        uint64_t key = RateLimiter::hash("10.0.0.1");
+        bool burst = limiter.acquire(key, 0).allowed && limiter.acquire(key, 0).allowed &&
+                     limiter.acquire(key, 0).allowed;
+        RateLimiter::Decision rejected = limiter.acquire(key, 0);
+        // 초당 10개 → 토큰 하나에 100ms
+        return burst && !rejected.allowed && rejected.retry_after_ms == 100;
+    }
+    
+    bool testRefill() {
+        RateLimiter limiter(settings(10.0, 2.0));
+        uint64_t key = RateLimiter::hash("10.0.0.2");
+        limiter.acquire(key, 0);
+        limiter.acquire(key, 0);
+        bool empty = !limiter.acquire(key, 50000).allowed;         // 50ms: 토큰 0.5개
+        bool refilled = limiter.acquire(key, 150000).allowed;      // 150ms: 토큰 1.5개
+        bool capped = true;
+        // 오래 쉬어도 burst 까지만 찬다
+        for (int i = 0; i < 2; ++i) {
+            capped = capped && limiter.acquire(key, 100000000).allowed;
+        }
+        return empty && refilled && capped && !limiter.acquire(key, 100000000).allowed;
+    }
+    
+    bool testIndependentKeys() {
+        RateLimiter limiter(settings(1.0, 1.0));
+        uint64_t a = RateLimiter::hash("10.0.0.3");
+        uint64_t b = RateLimiter::hash("10.0.0.4");
+        return limiter.acquire(a, 0).allowed && !limiter.acquire(a, 0).allowed &&
+               limiter.acquire(b, 0).allowed && limiter.trackedKeys() == 2 &&
+               RateLimiter::hash("GET", a) != RateLimiter::hash("GET", b);
+    }
+    
+    bool testEviction() {
+        // 샤드 1개, set 1개 (8 슬롯)
+        RateLimiter limiter(settings(1.0, 1.0, RateLimiter::kWays, 1));
+        for (int i = 0; i < 8; ++i) {
+            limiter.acquire(RateLimiter::hash(std::to_string(i)), 1000 + i);
+        }
+        // 0 번을 다시 써서 가장 오래된 것은 1 번이 된다
+        limiter.acquire(RateLimiter::hash("0"), 2000);
+        limiter.acquire(RateLimiter::hash("new"), 3000);
+        bool zero_kept = !limiter.acquire(RateLimiter::hash("0"), 3000).allowed;
+        bool one_evicted = limiter.acquire(RateLimiter::hash("1"), 3000).allowed;    // 새 버킷
+        return limiter.capacity() == RateLimiter::kWays && zero_kept && one_evicted &&
+               limiter.trackedKeys() == 8 && limiter.evictions() == 2;
+    }
+    
+    bool testSetRate() {
+        RateLimiter limiter(settings(1.0, 1.0));
+        uint64_t key = RateLimiter::hash("10.0.0.5");
+        limiter.acquire(key, 0);
+        limiter.setRate(1000.0, 5.0);
+        // 1ms 에 토큰 하나
+        return limiter.acquire(key, 1000).allowed && !limiter.acquire(key, 1000).allowed;
+    }
+};
+
+int main() {
+    RateLimiterTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include "test_helper.h"
+#include "../../src/utils/singleflight.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+// SingleFlight 테스트
+class SingleFlightTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== SingleFlight Tests ===" << std::endl;
+        
+        test_helper.runTest("Coalesces Concurrent Calls", [this]() {
+            return testCoalescesConcurrentCalls();
+        });
+        
+        test_helper.runTest("Separate Keys Run Separately", [this]() {
+            return testSeparateKeys();
+        });
+        
+        test_helper.runTest("Propagates Exceptions", [this]() {
+            return testPropagatesExceptions();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    bool testCoalescesConcurrentCalls() {
+        SingleFlight<std::string, int> flight;
+        std::atomic<int> executions{0};
+        std::atomic<int> sum{0};
+        
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&]() {
+                sum += flight.run("p1", [&]() {
+                    executions++;
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    return 7;
+                });
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        
+        // 모든 호출자가 같은 결과를 받고, 실제 조회는 소수만 실행되어야 함
+        return sum == 56 && executions < 8 && flight.inFlight() == 0;
+    }
+    
+    bool testSeparateKeys() {
+        SingleFlight<std::string, std::string> flight;
+        std::string a = flight.run("a", []() { return std::string("A"); });
+        std::string b = flight.run("b", []() { return std::string("B"); });
+        return a == "A" && b == "B";
+    }
+    
+    bool testPropagatesExceptions() {
+        SingleFlight<std::string, int> flight;
+        try {
+            flight.run("x", []() -> int { throw std::runtime_error("db down"); });
+        } catch (const std::runtime_error&) {
+            // 실패 후에는 키가 제거되어 다시 조회할 수 있어야 함
+            return flight.run("x", []() { return 1; }) == 1;
+        }
+        return false;
+    }
+};
+
+int main() {
+    SingleFlightTest test;
+    test.runAllTests();
+    
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include "test_helper.h"
+#include "../../src/utils/traffic_capture.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+
+// TrafficCapture 기록 형식 테스트
+class TrafficCaptureTest {
+private:
+    TestHelper test_helper;
+    
+public:
+    void runAllTests() {
+        std::cout << "=== Traffic Capture Tests ===" << std::endl;
+        
+        test_helper.runTest("Encode Decode Round Trip", [this]() {
+            return testRoundTrip();
+        });
+        
+        test_helper.runTest("Binary Body Uses Base64", [this]() {
+            return testBinaryBody();
+        });
+        
+        test_helper.runTest("Detects Sensitive Headers", [this]() {
+            return testSensitiveHeaders();
+        });
+        
+        test_helper.runTest("Rejects Malformed Lines", [this]() {
+            return testRejectsMalformed();
+        });
+        
+        test_helper.runTest("Writes Sampled Entries", [this]() {
+            return testWritesEntries();
+        });
+        
+        test_helper.printResults();
+    }
+    
+    bool allPassed() const { return test_helper.allPassed(); }
+    
+private:
+    static TrafficCapture::Entry sampleEntry() {
+        TrafficCapture::Entry entry;
+        entry.offset_us = 1500;
+        entry.method = "POST";
+        entry.url = "/members?source=\"test\"";
+        entry.headers = {{"Content-Type", "application/json"}, {"X-Trace", "a\tb"}};
+        entry.body = "{\"name\":\"홍길동\",\"memo\":\"line1\\nline2\"}";
+        entry.status = 201;
+        entry.duration_us = 830;
+        entry.response_bytes = 57;
+        entry.response_hash = TrafficCapture::hashBody("{\"id\":\"1\"}");
+        return entry;
+    }
+    
+    bool testRoundTrip() {
+        TrafficCapture::Entry entry = sampleEntry();
+        TrafficCapture::Entry decoded;
+        std::string line = TrafficCapture::encode(entry);
+        return line.find('\n') == std::string::npos &&
+               TrafficCapture::decode(line, decoded) &&
+               decoded.offset_us == entry.offset_us && decoded.method == entry.method &&
+               decoded.url == entry.url && decoded.headers == entry.headers &&
+               decoded.body == entry.body && !decoded.body_truncated &&
+               decoded.status == entry.status && decoded.duration_us == entry.duration_us &&
+               decoded.response_bytes == entry.response_bytes && decoded.response_hash == entry.response_hash;
+    }
+    
+    bool testBinaryBody() {
+        TrafficCapture::Entry entry = sampleEntry();
+        entry.body = std::string("\xff\x00\x01gz", 5);
+        entry.body_truncated = true;
+        TrafficCapture::Entry decoded;
+        std::string line = TrafficCapture::encode(entry);
+        return line.find("\"b64\":") != std::string::npos &&
+               TrafficCapture::decode(line, decoded) &&
+               decoded.body == entry.body && decoded.body_truncated &&
+               TrafficCapture::base64Decode(TrafficCapture::base64Encode("ab")) == "ab" &&
+               !TrafficCapture::isValidUtf8("\xed\x95") && TrafficCapture::isValidUtf8("한글");
+    }
+    
+    bool testSensitiveHeaders() {
+        return TrafficCapture::isSensitiveHeader("Authorization") &&
+               TrafficCapture::isSensitiveHeader("cookie") &&
+               TrafficCapture::isSensitiveHeader("X-API-KEY") &&
+               !TrafficCapture::isSensitiveHeader("Content-Type") &&
+               !TrafficCapture::isSensitiveHeader("Cookies");
+    }
+    
+    bool testRejectsMalformed() {
+        TrafficCapture::Entry decoded;
+        return !TrafficCapture::decode("", decoded) &&
+               !TrafficCapture::decode("{\"m\":\"GET\"}", decoded) &&
+               !TrafficCapture::decode("{\"m\":\"GET\",\"u\":\"/\",\"s\":}", decoded) &&
+               !TrafficCapture::decode("{\"m\":\"GET\",\"u\":\"/\"} trailing", decoded) &&
+               TrafficCapture::decode("{\"m\":\"GET\",\"u\":\"/\",\"x\":7}", decoded);
+    }
+    
+    bool testWritesEntries() {
+        const std::string path = "traffic_capture_test.jsonl";
+        std::remove(path.c_str());
+        {
+            TrafficCapture capture;
+            TrafficCapture::Settings settings;
+            settings.enabled = true;
+            settings.path = path;
+            settings.sample_rate = 1.0;
+            settings.max_body_bytes = 4;
+            capture.configure(settings);
+            if (!capture.sample()) {
+                return false;
+            }
+            for (int i = 0; i < 3; ++i) {
+                TrafficCapture::Entry entry = sampleEntry();
+                entry.url = "/members/" + std::to_string(i);
+                capture.submit(entry);
+            }
+        }   // 소멸 시 대기열을 모두 기록
+        
+        std::ifstream input(path);
+        std::string line;
+        int lines = 0;
+        bool truncated = true;
+        while (std::getline(input, line)) {
+            TrafficCapture::Entry decoded;
+            truncated = truncated && TrafficCapture::decode(line, decoded) &&
+                        decoded.body_truncated && decoded.body.size() == 4;
+            lines++;
+        }
+        std::remove(path.c_str());
+        return lines == 3 && truncated;
+    }
+};
+
+int main() {
+    TrafficCaptureTest test;
+    test.runAllTests();
+
+    return test.allPassed() ? 0 : 1;
+}
@@ -0,0 +1,397 @@
+// 트래픽 캡처(capture.enabled) 로 기록한 JSONL 을 서버에 다시 보내는 재생 도구.
+//   traffic_replay --file capture.jsonl [--host 127.0.0.1] [--port 8080] [--speed 1] [--concurrency 8]
+// --speed 1 은 기록된 간격 그대로, 2 는 두 배 빠르게, 0 은 간격 없이 최대한 빠르게 보낸다.
+// 끝나면 지연 시간 백분위와 기록 당시와 다른 응답(상태 코드, 본문 해시)을 출력한다.
+#include "../../src/utils/traffic_capture.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <strings.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::string file;
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    double speed = 1.0;
+    int concurrency = 8;
+    size_t max_samples = 5;         // 출력할 불일치 예시 수
+};
+
+struct Response {
+    int status = 0;
+    std::string body;
+};
+
+struct Result {
+    bool ok = false;
+    int64_t latency_us = 0;
+    int status = 0;
+    uint64_t body_hash = 0;
+    size_t body_bytes = 0;
+};
+
+// keep-alive 로 연결을 재사용하는 최소 HTTP/1.1 클라이언트
+class HttpConnection {
+private:
+    const Options& options;
+    int fd = -1;
+    std::string buffer;             // 아직 처리하지 않은 수신 데이터
+
+public:
+    explicit HttpConnection(const Options& options) : options(options) {}
+    ~HttpConnection() { close(); }
+
+    HttpConnection(const HttpConnection&) = delete;
+    HttpConnection& operator=(const HttpConnection&) = delete;
+
+    // 연결이 끊겨 있었으면 한 번 다시 연결해 보낸다
+    bool send(const TrafficCapture::Entry& entry, Response& response) {
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (fd < 0 && !connect()) {
+                return false;
+            }
+            if (writeRequest(entry) && readResponse(response)) {
+                return true;
+            }
+            close();
+        }
+        return false;
+    }
+
+private:
+    bool connect() {
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* addresses = nullptr;
+        if (getaddrinfo(options.host.c_str(), std::to_string(options.port).c_str(), &hints, &addresses) != 0) {
+            return false;
+        }
+        for (addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+            fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+                int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                break;
+            }
+            ::close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(addresses);
+        buffer.clear();
+        return fd >= 0;
+    }
+
+    void close() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        buffer.clear();
+    }
+
+    static bool isHopByHopHeader(const std::string& name) {
+        for (const char* skipped : {"host", "content-length", "connection", "transfer-encoding", "keep-alive"}) {
+            if (strcasecmp(name.c_str(), skipped) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool writeRequest(const TrafficCapture::Entry& entry) {
+        std::string request = entry.method + " " + entry.url + " HTTP/1.1\r\n";
+        request += "Host: " + options.host + ":" + std::to_string(options.port) + "\r\n";
+        for (const auto& header : entry.headers) {
+            if (!isHopByHopHeader(header.first)) {
+                request += header.first + ": " + header.second + "\r\n";
+            }
+        }
+        request += "Content-Length: " + std::to_string(entry.body.size()) + "\r\n";
+        request += "Connection: keep-alive\r\n\r\n";
+        request += entry.body;
+
+        size_t sent = 0;
+        while (sent < request.size()) {
+            ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool fill() {
+        char chunk[16 * 1024];
+        while (true) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+            return true;
+        }
+    }
+
+    bool readLine(std::string& line) {
+        size_t end;
+        while ((end = buffer.find("\r\n")) == std::string::npos) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        line = buffer.substr(0, end);
+        buffer.erase(0, end + 2);
+        return true;
+    }
+
+    bool readExactly(size_t length, std::string& out) {
+        while (buffer.size() < length) {
+            if (!fill()) {
+                return false;
+            }
+        }
+        out.append(buffer, 0, length);
+        buffer.erase(0, length);
+        return true;
+    }
+
+    bool readResponse(Response& response) {
+        std::string line;
+        if (!readLine(line) || line.compare(0, 5, "HTTP/") != 0 || line.size() < 12) {
+            return false;
+        }
+        response.status = std::atoi(line.c_str() + 9);
+        response.body.clear();
+
+        long long content_length = -1;
+        bool chunked = false;
+        bool close_after = false;
+        while (readLine(line) && !line.empty()) {
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            std::string name = line.substr(0, colon);
+            size_t value_start = line.find_first_not_of(' ', colon + 1);
+            std::string value = value_start == std::string::npos ? "" : line.substr(value_start);
+            if (strcasecmp(name.c_str(), "content-length") == 0) {
+                content_length = std::atoll(value.c_str());
+            } else if (strcasecmp(name.c_str(), "transfer-encoding") == 0) {
+                chunked = strcasecmp(value.c_str(), "chunked") == 0;
+            } else if (strcasecmp(name.c_str(), "connection") == 0) {
+                close_after = strcasecmp(value.c_str(), "close") == 0;
+            }
+        }
+        if (!line.empty()) {
+            return false;
+        }
+
+        if (chunked) {
+            while (true) {
+                if (!readLine(line)) {
+                    return false;
+                }
+                size_t size = std::strtoul(line.c_str(), nullptr, 16);
+                if (size == 0) {
+                    readLine(line);     // 마지막 빈 줄
+                    break;
+                }
+                if (!readExactly(size, response.body) || !readLine(line)) {
+                    return false;
+                }
+            }
+        } else if (content_length >= 0) {
+            if (!readExactly(static_cast<size_t>(content_length), response.body)) {
+                return false;
+            }
+        } else {
+            // 길이 정보가 없으면 연결이 닫힐 때까지 읽는다
+            while (fill()) {
+            }
+            response.body = std::move(buffer);
+            close_after = true;
+        }
+        if (close_after) {
+            close();
+        }
+        return true;
+    }
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--file") options.file = value;
+        else if (arg == "--host") options.host = value;
+        else if (arg == "--port") options.port = std::atoi(value.c_str());
+        else if (arg == "--speed") options.speed = std::atof(value.c_str());
+        else if (arg == "--concurrency") options.concurrency = std::atoi(value.c_str());
+        else if (arg == "--samples") options.max_samples = static_cast<size_t>(std::atoi(value.c_str()));
+        else return false;
+    }
+    return !options.file.empty() && options.port > 0 && options.speed >= 0.0 && options.concurrency > 0;
+}
+
+int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void printLatency(const char* label, std::vector<int64_t> values) {
+    std::sort(values.begin(), values.end());
+    std::printf("%-10s p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms\n", label,
+                percentile(values, 0.50) / 1000.0, percentile(values, 0.90) / 1000.0,
+                percentile(values, 0.99) / 1000.0, (values.empty() ? 0 : values.back()) / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "usage: " << argv[0]
+                  << " --file capture.jsonl [--host 127.0.0.1] [--port 8080] [--speed 1] [--concurrency 8] [--samples 5]"
+                  << std::endl;
+        return 2;
+    }
+
+    std::ifstream input(options.file);
+    if (!input.is_open()) {
+        std::cerr << "Failed to open capture file: " << options.file << std::endl;
+        return 1;
+    }
+    std::vector<TrafficCapture::Entry> entries;
+    size_t malformed = 0;
+    std::string line;
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        TrafficCapture::Entry entry;
+        if (TrafficCapture::decode(line, entry)) {
+            entries.push_back(std::move(entry));
+        } else {
+            malformed++;
+        }
+    }
+    if (entries.empty()) {
+        std::cerr << "No requests in " << options.file << std::endl;
+        return 1;
+    }
+    // 기록 순서는 응답 완료 순이므로 요청 시작 시각으로 정렬
+    std::stable_sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.offset_us < b.offset_us;
+    });
+    int64_t base_us = entries.front().offset_us;
+
+    std::vector<Result> results(entries.size());
+    std::atomic<size_t> next{0};
+    auto started = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < options.concurrency; ++w) {
+        workers.emplace_back([&] {
+            HttpConnection connection(options);
+            Response response;
+            size_t index;
+            while ((index = next.fetch_add(1)) < entries.size()) {
+                const auto& entry = entries[index];
+                if (options.speed > 0.0) {
+                    auto due = started + std::chrono::microseconds(
+                        static_cast<int64_t>(static_cast<double>(entry.offset_us - base_us) / options.speed));
+                    std::this_thread::sleep_until(due);
+                }
+                auto sent = std::chrono::steady_clock::now();
+                Result& result = results[index];
+                result.ok = connection.send(entry, response);
+                result.latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - sent).count();
+                if (result.ok) {
+                    result.status = response.status;
+                    result.body_hash = TrafficCapture::hashBody(response.body);
+                    result.body_bytes = response.body.size();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::vector<int64_t> replayed;
+    std::vector<int64_t> recorded;
+    size_t errors = 0;
+    size_t status_mismatches = 0;
+    size_t body_mismatches = 0;
+    std::vector<std::string> samples;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        const auto& result = results[i];
+        recorded.push_back(entry.duration_us);
+        if (!result.ok) {
+            errors++;
+            continue;
+        }
+        replayed.push_back(result.latency_us);
+        std::string difference;
+        if (result.status != entry.status) {
+            status_mismatches++;
+            difference = "status " + std::to_string(entry.status) + " -> " + std::to_string(result.status);
+        } else if (result.body_hash != entry.response_hash && !entry.body_truncated) {
+            // 요청 본문이 잘린 경우에는 같은 응답을 기대할 수 없으므로 본문 비교에서 제외
+            body_mismatches++;
+            difference = "body " + std::to_string(entry.response_bytes) + "B -> " +
+                         std::to_string(result.body_bytes) + "B";
+        }
+        if (!difference.empty() && samples.size() < options.max_samples) {
+            samples.push_back(entry.method + " " + entry.url + ": " + difference);
+        }
+    }
+
+    std::printf("requests   %zu (malformed lines %zu, errors %zu) in %.2fs, %.1f req/s\n",
+                entries.size(), malformed, errors, elapsed, static_cast<double>(entries.size()) / elapsed);
+    printLatency("replayed", replayed);
+    printLatency("recorded", recorded);
+    std::printf("mismatch   status=%zu body=%zu\n", status_mismatches, body_mismatches);
+    for (const auto& sample : samples) {
+        std::printf("  %s\n", sample.c_str());
+    }
+    return errors == 0 ? 0 : 1;
+}